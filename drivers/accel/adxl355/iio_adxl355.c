@@ -997,12 +997,17 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 *******************************************************************************/
 static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 {
-	int32_t data_buff[3];
-	uint32_t x,y,z;
-	uint8_t i = 0;
-
+	/* 20 bit samples, left aligned in big endian 24 bit words */
+	static const struct no_os_sample_fmt accel_fmt = {
+		.realbits = 20,
+		.storagebits = 24,
+		.shift = 4,
+		.is_signed = true,
+		.is_big_endian = true,
+	};
+	uint8_t raw_xyz[3 * GET_ADXL355_TRANSF_LEN(ADXL355_XDATA)];
 	struct adxl355_iio_dev *iio_adxl355;
-	struct adxl355_dev *adxl355;
+	int ret;
 
 	if (!dev_data)
 		return -EINVAL;
@@ -1012,24 +1017,15 @@ static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 	if (!iio_adxl355->adxl355_dev)
 		return -EINVAL;
 
-	adxl355 = iio_adxl355->adxl355_dev;
-
-	adxl355_get_raw_xyz(adxl355, &x, &y, &z);
-
-	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
-		data_buff[0] = no_os_sign_extend32(x, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
-		data_buff[i] = no_os_sign_extend32(y, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
-		data_buff[i] = no_os_sign_extend32(z, 19);
-		i++;
-	}
+	/* XDATA, YDATA and ZDATA are contiguous, read them in a single burst */
+	ret = adxl355_read_device_data(iio_adxl355->adxl355_dev,
+				       ADXL355_ADDR(ADXL355_XDATA),
+				       sizeof(raw_xyz), raw_xyz);
+	if (ret)
+		return ret;
 
-	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+	return iio_buffer_push_raw_scan(dev_data->buffer, &accel_fmt, raw_xyz,
+					3);
 }
 
 /***************************************************************************//**
@@ -51,14 +51,11 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 #define AD74413R_FRAME_SIZE 		4
-#define AD74413R_CRC_POLYNOMIAL 	0x7
 #define AD74413R_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 
 /******************************************************************************/
 /************************ Variable Declarations ******************************/
 /******************************************************************************/
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
-
 static const unsigned int ad74413r_debounce_map[AD74413R_DIN_DEBOUNCE_LEN] = {
 	0,     13,    18,    24,    32,    42,    56,    75,
 	100,   130,   180,   240,   320,   420,   560,   750,
@@ -212,7 +209,7 @@ static void ad74413r_format_reg_write(uint8_t reg, uint16_t val, uint8_t *buff)
 {
 	buff[0] = reg;
 	no_os_put_unaligned_be16(val, &buff[1]);
-	buff[3] = no_os_crc8(_crc_table, buff, 3, 0);
+	buff[3] = no_os_crc8(no_os_crc8_msb_07_table, buff, 3, 0);
 }
 
 /**
@@ -275,7 +272,8 @@ int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
 	if (ret)
 		return ret;
 
-	expected_crc = no_os_crc8(_crc_table, desc->comm_buff, 3, 0);
+	expected_crc = no_os_crc8(no_os_crc8_msb_07_table, desc->comm_buff,
+				  3, 0);
 	if (expected_crc != desc->comm_buff[3])
 		return -EINVAL;
 
@@ -1190,8 +1188,6 @@ int ad74413r_init(struct ad74413r_desc **desc,
 	if (ret)
 		goto err;
 
-	no_os_crc8_populate_msb(_crc_table, AD74413R_CRC_POLYNOMIAL);
-
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
 	if (ret)
@@ -41,6 +41,7 @@
 #include "ad4858.h"
 #include "no_os_delay.h"
 #include "no_os_print_log.h"
+#include "no_os_sample.h"
 
 /**
  * @brief Write device register.
@@ -658,83 +659,68 @@ int ad4858_perform_conv(struct ad4858_dev *dev)
  */
 int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 {
+	/* The 20-bit results are msb first, densely packed or padded to a word */
+	static const struct no_os_sample_fmt fmt_20bit = {
+		.realbits = 20, .storagebits = 20,
+	};
+	/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID */
+	static const struct no_os_sample_fmt fmt_24bit = {
+		.realbits = 20, .storagebits = 24, .shift = 4,
+		.is_big_endian = true,
+	};
+	/* Same as above + 4-bit softspan ID + 4 0's */
+	static const struct no_os_sample_fmt fmt_32bit = {
+		.realbits = 20, .storagebits = 32, .shift = 12,
+		.is_big_endian = true,
+	};
+	const struct no_os_sample_fmt *fmt;
 	int ret;
 	uint16_t nb_bytes;
 	uint8_t indx;
 	uint8_t chn;
 	uint8_t buff[32] = {0};
-	// Buffer index offset for each channel while reading 20-bit conversion result
-	uint8_t buff_chn_offset[] = { 0, 2, 5, 7, 10, 12, 15, 17 };
 
 	if (!dev || !data)
 		return -EINVAL;
 
 	switch (dev->packet_format) {
 	case AD4858_PACKET_20_BIT:
-		nb_bytes = (20 * AD4858_NUM_CHANNELS) >> 3;
+		fmt = &fmt_20bit;
 		break;
 
 	case AD4858_PACKET_24_BIT:
-		nb_bytes = (24 * AD4858_NUM_CHANNELS) >> 3;
+		fmt = &fmt_24bit;
 		break;
 
 	case AD4858_PACKET_32_BIT:
-		nb_bytes = (32 * AD4858_NUM_CHANNELS) >> 3;
+		fmt = &fmt_32bit;
 		break;
 
 	default:
 		return -EINVAL;
 	}
 
+	nb_bytes = no_os_sample_raw_size(fmt, AD4858_NUM_CHANNELS);
+
 	/* Read SPI data */
 	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
 	if (ret)
 		return ret;
 
-	switch (dev->packet_format) {
-	case AD4858_PACKET_20_BIT:
-		/* 20-bit conversion result */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = buff_chn_offset[chn];
-			if (!(chn % 2))
-				data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-						  ((uint32_t)buff[indx + 1] << 8) |
-						  (buff[indx + 2])) >> 4;
-			else
-				data->raw[chn] = ((uint32_t)(buff[indx] & 0x0f) << 16) |
-						 ((uint32_t)buff[indx + 1] << 8) |
-						 (buff[indx + 2]);
-		}
-		break;
+	ret = no_os_sample_unpack32(fmt, buff, (int32_t *)data->raw,
+				    AD4858_NUM_CHANNELS);
+	if (ret)
+		return ret;
 
-	case AD4858_PACKET_24_BIT:
-		/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = chn * 3;
-			data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-					  ((uint32_t)buff[indx + 1] << 8) |
-					  (buff[indx + 2])) >> 4;
-			data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
-			data->chn_id[chn] = buff[indx + 2] & 0x7;
-		}
-		chn = 0;
-		break;
+	if (dev->packet_format == AD4858_PACKET_20_BIT)
+		return 0;
 
-	case AD4858_PACKET_32_BIT:
-		/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID + 4-bit softspan ID + 4 0's */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = chn * 4;
-			data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-					  ((uint32_t)buff[indx + 1] << 8) |
-					  (buff[indx + 2])) >> 4;
-			data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
-			data->chn_id[chn] = buff[indx + 2] & 0x7;
+	for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
+		indx = chn * (fmt->storagebits / 8);
+		data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
+		data->chn_id[chn] = buff[indx + 2] & 0x7;
+		if (dev->packet_format == AD4858_PACKET_32_BIT)
 			data->softspan_id[chn] = (buff[indx + 3] >> 4) & 0xf;
-		}
-		break;
-
-	default:
-		return -EINVAL;
 	}
 
 	return 0;
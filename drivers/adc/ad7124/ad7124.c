@@ -46,6 +46,7 @@
 #include "ad7124.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
 #include "no_os_error.h"
 
 /*
@@ -448,26 +449,7 @@ int32_t ad7124_get_read_chan_id(struct ad7124_dev *dev, uint32_t *status)
 *******************************************************************************/
 uint8_t ad7124_compute_crc8(uint8_t * p_buf, uint8_t buf_size)
 {
-	uint8_t i = 0;
-	uint8_t crc = 0;
-
-	while (buf_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			bool cmp1 = (crc & 0x80) != 0;
-			bool cmp2 = (*p_buf & i) != 0;
-			if (cmp1 != cmp2) {
-				/* MSB of CRC register XOR input Bit from Data */
-				crc <<= 1;
-				crc ^= AD7124_CRC8_POLYNOMIAL_REPRESENTATION;
-			} else {
-				crc <<= 1;
-			}
-		}
-		p_buf++;
-		buf_size--;
-	}
-
-	return crc;
+	return no_os_crc8(no_os_crc8_msb_07_table, p_buf, buf_size, 0);
 }
 
 /***************************************************************************//**
@@ -48,6 +48,7 @@
 #include "ad717x.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
 
 /* Error codes */
 #define INVALID_VAL -1 /* Invalid argument */
@@ -670,23 +671,7 @@ int32_t AD717X_ComputeDataregSize(ad717x_dev *device)
 uint8_t AD717X_ComputeCRC8(uint8_t * pBuf,
 			   uint8_t bufSize)
 {
-	uint8_t i   = 0;
-	uint8_t crc = 0;
-
-	while(bufSize) {
-		for(i = 0x80; i != 0; i >>= 1) {
-			if(((crc & 0x80) != 0) != ((*pBuf & i) !=
-						   0)) { /* MSB of CRC register XOR input Bit from Data */
-				crc <<= 1;
-				crc ^= AD717X_CRC8_POLYNOMIAL_REPRESENTATION;
-			} else {
-				crc <<= 1;
-			}
-		}
-		pBuf++;
-		bufSize--;
-	}
-	return crc;
+	return no_os_crc8(no_os_crc8_msb_07_table, pBuf, bufSize, 0);
 }
 
 /***************************************************************************//**
@@ -43,7 +43,6 @@
 #include "no_os_mutex.h"
 #include "no_os_irq.h"
 #include "no_os_alloc.h"
-#include "no_os_list.h"
 
 /**
  * @brief Default handler for cycling though the channel's list of transfers
@@ -53,38 +52,47 @@
 static void default_sg_callback(void *context)
 {
 	struct no_os_dma_default_handler_data *data = context;
-	struct no_os_dma_xfer_desc *next_xfer;
+	struct no_os_dma_ch *ch = data->channel;
+	struct no_os_dma_xfer_desc *next_xfer = NULL;
 	struct no_os_dma_xfer_desc *old_xfer;
-	uint32_t list_size;
-	int ret;
+	uint32_t tail;
 
-	/* Handle the next transfer from the SG list */
-	ret = no_os_list_get_first(data->channel->sg_list, (void **)&old_xfer);
-	if (ret) {
+	if (!ch->sg_count) {
 		/*
-		 * This should only happen if the list descriptor is NULL.
-		 * The case in which there is no transfer left in the list should
+		 * The case in which there is no transfer left in the ring should
 		 * have been handled in the previous interrupt.
 		 */
-		no_os_dma_xfer_abort(data->desc, data->channel);
+		no_os_dma_xfer_abort(data->desc, ch);
 		return;
 	}
 
-	no_os_list_read_first(data->channel->sg_list, (void **)&next_xfer);
-	no_os_list_get_size(data->channel->sg_list, &list_size);
+	/* Handle the next transfer from the SG ring */
+	old_xfer = ch->sg_ring[ch->sg_head];
+	if (ch->cyclic) {
+		/* The completed transfer goes after the last one */
+		tail = (ch->sg_head + ch->sg_count) % ch->sg_ring_size;
+		ch->sg_ring[tail] = old_xfer;
+	} else {
+		ch->sg_count--;
+	}
+	ch->sg_head = (ch->sg_head + 1) % ch->sg_ring_size;
+
+	if (ch->sg_count)
+		next_xfer = ch->sg_ring[ch->sg_head];
+
 	if (old_xfer->xfer_complete_cb)
 		old_xfer->xfer_complete_cb(old_xfer, next_xfer,
 					   old_xfer->xfer_complete_ctx);
 
-	if (!list_size) {
-		no_os_irq_disable(data->desc->irq_ctrl, data->channel->irq_num);
-		data->channel->free = true;
+	if (!ch->sg_count) {
+		no_os_irq_disable(data->desc->irq_ctrl, ch->irq_num);
+		ch->free = true;
 		return;
 	}
 
-	data->desc->platform_ops->dma_config_xfer(data->channel, next_xfer);
+	data->desc->platform_ops->dma_config_xfer(ch, next_xfer);
 
-	no_os_dma_xfer_start(data->desc, data->channel);
+	no_os_dma_xfer_start(data->desc, ch);
 }
 
 /**
@@ -98,7 +106,8 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 {
 	int ret;
 	uint32_t i, j;
-	void *mutex;
+	uint32_t ring_size;
+	static void *mutex;
 
 	if (!param || !param->platform_ops)
 		return -EINVAL;
@@ -113,14 +122,32 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 	if (ret)
 		goto unlock;
 
+	/* A shared controller was already set up by its first user */
+	if ((*desc)->ref) {
+		(*desc)->ref++;
+		goto unlock;
+	}
+
 	no_os_mutex_init(&(*desc)->mutex);
 
 	(*desc)->platform_ops = param->platform_ops;
 
+	ring_size = param->sg_ring_size ? param->sg_ring_size :
+		    NO_OS_DMA_SG_RING_SIZE;
+
+	/* The rings are allocated once, so that no memory is allocated when
+	 * the transfers are queued or completed. */
 	for (i = 0; i < param->num_ch; i++) {
-		ret = no_os_list_init(&(*desc)->channels[i].sg_list, NO_OS_LIST_QUEUE, NULL);
-		if (ret)
-			goto list_err;
+		(*desc)->channels[i].sg_ring = no_os_calloc(ring_size,
+						sizeof(*(*desc)->channels[i].sg_ring));
+		if (!(*desc)->channels[i].sg_ring) {
+			ret = -ENOMEM;
+			goto ring_err;
+		}
+		(*desc)->channels[i].sg_ring_size = ring_size;
+		(*desc)->channels[i].sg_head = 0;
+		(*desc)->channels[i].sg_count = 0;
+		(*desc)->channels[i].cyclic = false;
 
 		no_os_mutex_init(&(*desc)->channels[i].mutex);
 	}
@@ -130,11 +157,17 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 
 	return 0;
 
-list_err:
-	for (j = 0; j < i; j++)
-		no_os_list_remove((*desc)->channels[i].sg_list);
+ring_err:
+	for (j = 0; j < i; j++) {
+		no_os_free((*desc)->channels[j].sg_ring);
+		(*desc)->channels[j].sg_ring = NULL;
+		no_os_mutex_remove((*desc)->channels[j].mutex);
+	}
 
-	no_os_dma_remove(*desc);
+	/* ref is still 0, which no_os_dma_remove() treats as already removed */
+	no_os_mutex_remove((*desc)->mutex);
+	(*desc)->platform_ops->dma_remove(*desc);
+	*desc = NULL;
 unlock:
 	no_os_mutex_unlock(mutex);
 
@@ -149,31 +182,24 @@ unlock:
 int no_os_dma_remove(struct no_os_dma_desc *desc)
 {
 	uint32_t i;
-	int ret;
 
 	if (!desc)
 		return -EINVAL;
 
-	if (!desc->ref)
+	if (!desc->ref || --desc->ref)
 		return 0;
 
 	for (i = 0; i < desc->num_ch; i++) {
-		ret = no_os_list_remove(desc->channels->sg_list);
-		if (ret)
-			return ret;
+		no_os_free(desc->channels[i].sg_ring);
+		desc->channels[i].sg_ring = NULL;
 
 		no_os_mutex_remove(desc->channels[i].mutex);
 	}
 
 	no_os_mutex_remove(desc->mutex);
 
-	ret = desc->platform_ops->dma_remove(desc);
-	if (ret)
-		return ret;
-
-	desc->ref--;
-
-	return 0;
+	/* The platform code frees the descriptor */
+	return desc->platform_ops->dma_remove(desc);
 }
 
 /**
@@ -233,18 +259,21 @@ int no_os_dma_release_channel(struct no_os_dma_desc *desc,
 }
 
 /**
- * @brief Acquire a channel and configure the list of transfers.
+ * @brief Queue transfers on a channel and register the SG interrupt handler.
  * @param desc - Structure containing the state of the DMA controller
  * @param xfer - Array of DMA transfers.
  * @param len - The number of transfers in the xfer list.
  * @param ch - Previously acquired channel, for which the transfer will be configured.
+ * @param cyclic - Whether the transfers are repeated until the channel is aborted.
  * @return 0 in case of success, negative error code otherwise.
  */
-int no_os_dma_config_xfer(struct no_os_dma_desc *desc,
-			  struct no_os_dma_xfer_desc *xfer,
-			  uint32_t len, struct no_os_dma_ch *ch)
+static int no_os_dma_queue_xfer(struct no_os_dma_desc *desc,
+				struct no_os_dma_xfer_desc *xfer,
+				uint32_t len, struct no_os_dma_ch *ch,
+				bool cyclic)
 {
 	uint32_t i;
+	uint32_t tail;
 	int ret;
 
 	struct no_os_callback_desc sg_callback = {
@@ -271,12 +300,21 @@ int no_os_dma_config_xfer(struct no_os_dma_desc *desc,
 		goto unlock;
 	}
 
+	if (len > ch->sg_ring_size - ch->sg_count) {
+		ret = -ENOSPC;
+		goto unlock;
+	}
+
 	/*
-	 * Add the transfers to the channel's SG list. It's safe to do so, since
+	 * Add the transfers to the channel's SG ring. It's safe to do so, since
 	 * there are no ongoing transfers on this channel.
 	 */
-	for (i = 0; i < len; i++)
-		no_os_list_add_last(ch->sg_list, &xfer[i]);
+	for (i = 0; i < len; i++) {
+		tail = (ch->sg_head + ch->sg_count) % ch->sg_ring_size;
+		ch->sg_ring[tail] = &xfer[i];
+		ch->sg_count++;
+	}
+	ch->cyclic = cyclic;
 
 	if (desc->irq_ctrl) {
 		ch->irq_ctx.desc = desc;
@@ -302,16 +340,53 @@ int no_os_dma_config_xfer(struct no_os_dma_desc *desc,
 		no_os_irq_set_priority(desc->irq_ctrl, ch->irq_num, xfer[0].irq_priority);
 	}
 
+	no_os_mutex_unlock(ch->mutex);
+
 	return 0;
 
 abort_xfer:
+	no_os_mutex_unlock(ch->mutex);
 	no_os_dma_xfer_abort(desc, ch);
+
+	return ret;
 unlock:
 	no_os_mutex_unlock(ch->mutex);
 
 	return ret;
 }
 
+/**
+ * @brief Acquire a channel and configure the list of transfers.
+ * @param desc - Structure containing the state of the DMA controller
+ * @param xfer - Array of DMA transfers.
+ * @param len - The number of transfers in the xfer list.
+ * @param ch - Previously acquired channel, for which the transfer will be configured.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_config_xfer(struct no_os_dma_desc *desc,
+			  struct no_os_dma_xfer_desc *xfer,
+			  uint32_t len, struct no_os_dma_ch *ch)
+{
+	return no_os_dma_queue_xfer(desc, xfer, len, ch, false);
+}
+
+/**
+ * @brief Configure a list of transfers which is repeated until the channel is
+ * aborted. Each completed transfer is queued again after the last one, so
+ * that a list of buffers is continuously filled or sent.
+ * @param desc - Structure containing the state of the DMA controller
+ * @param xfer - Array of DMA transfers.
+ * @param len - The number of transfers in the xfer list.
+ * @param ch - Previously acquired channel, for which the transfer will be configured.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_config_xfer_cyclic(struct no_os_dma_desc *desc,
+				 struct no_os_dma_xfer_desc *xfer,
+				 uint32_t len, struct no_os_dma_ch *ch)
+{
+	return no_os_dma_queue_xfer(desc, xfer, len, ch, true);
+}
+
 /**
  * @brief Lock a DMA channel, so it won't be acquired even if it's free.
  * @param ch - Reference to the DMA channel
@@ -386,7 +461,6 @@ int no_os_dma_xfer_start(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
  */
 int no_os_dma_xfer_abort(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 {
-	void *discard;
 	int ret;
 
 	if (!desc || !desc->platform_ops || !ch)
@@ -400,9 +474,9 @@ int no_os_dma_xfer_abort(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 	if (desc->irq_ctrl)
 		no_os_irq_disable(desc->irq_ctrl, ch->irq_num);
 
-	do {
-		ret = no_os_list_get_first(ch->sg_list, &discard);
-	} while (!ret);
+	ch->sg_head = 0;
+	ch->sg_count = 0;
+	ch->cyclic = false;
 
 	ret = desc->platform_ops->dma_xfer_abort(desc, ch);
 
@@ -42,7 +42,10 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_mutex.h"
+#include "no_os_semaphore.h"
+#include "no_os_critical.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 
 /**
  * @brief spi_table contains the pointers towards the SPI buses
@@ -100,6 +103,7 @@ int32_t no_os_spibus_init(const struct no_os_spi_init_param *param)
 		return -ENOMEM;
 
 	no_os_mutex_init(&(bus->mutex));
+	no_os_semaphore_init(&bus->xfer_sem);
 
 	bus->slave_number = 0;
 	bus->device_id = param->device_id;
@@ -146,6 +150,7 @@ void no_os_spibus_remove(uint32_t bus_number)
 
 	if (bus->slave_number == 0) {
 		no_os_mutex_remove(bus->mutex);
+		no_os_semaphore_remove(bus->xfer_sem);
 
 		if (bus) {
 			no_os_free(bus);
@@ -156,7 +161,108 @@ void no_os_spibus_remove(uint32_t bus_number)
 }
 
 /**
- * @brief Write and read data to/from SPI.
+ * @brief Wait until the transfers queued on a bus are done. The caller sleeps
+ * on the bus semaphore until the queue drains. Without semaphore support (bare
+ * metal), the transfers complete from interrupts and the flag is polled
+ * instead.
+ * @param bus - The SPI bus descriptor.
+ */
+static void no_os_spi_xfer_wait_idle(struct no_os_spibus_desc *bus)
+{
+	if (!bus->xfer_sem) {
+		while (bus->xfer_busy)
+			no_os_udelay(1);
+
+		return;
+	}
+
+	while (true) {
+		no_os_critical_enter();
+		if (!bus->xfer_busy) {
+			no_os_critical_exit();
+			return;
+		}
+		bus->xfer_waiters++;
+		no_os_critical_exit();
+
+		no_os_semaphore_take(bus->xfer_sem);
+	}
+}
+
+/**
+ * @brief Lock the bus mutex once the transfer queue is idle. The queue owns
+ * the bus while it is busy, and a new queue run waits for the mutex holder
+ * before it starts, so the holder has the bus for itself.
+ * @param bus - The SPI bus descriptor.
+ */
+static void no_os_spi_bus_acquire(struct no_os_spibus_desc *bus)
+{
+	no_os_mutex_lock(bus->mutex);
+	while (bus->xfer_busy) {
+		no_os_mutex_unlock(bus->mutex);
+		no_os_spi_xfer_wait_idle(bus);
+		no_os_mutex_lock(bus->mutex);
+	}
+}
+
+/**
+ * @brief Lock the SPI bus of a device, so that a sequence of transfers, like a
+ * register read-modify-write, isn't interleaved with the transfers of the
+ * other devices on the bus. Waits for the transfers queued on the bus first.
+ * While the bus is locked, only the unlocked (__no_os_spi_*) variants of the
+ * transfer functions may be used.
+ * Must not be called from a transfer callback.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_spi_bus_lock(struct no_os_spi_desc *desc)
+{
+	if (!desc || !desc->bus)
+		return -EINVAL;
+
+	no_os_spi_bus_acquire(desc->bus);
+
+	return 0;
+}
+
+/**
+ * @brief Unlock the SPI bus of a device, locked by no_os_spi_bus_lock().
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_spi_bus_unlock(struct no_os_spi_desc *desc)
+{
+	if (!desc || !desc->bus)
+		return -EINVAL;
+
+	no_os_mutex_unlock(desc->bus->mutex);
+
+	return 0;
+}
+
+/**
+ * @brief Write and read data to/from SPI. The caller must hold the bus lock.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t __no_os_spi_write_and_read(struct no_os_spi_desc *desc,
+				   uint8_t *data,
+				   uint16_t bytes_number)
+{
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (!desc->platform_ops->write_and_read)
+		return -ENOSYS;
+
+	return desc->platform_ops->write_and_read(desc, data, bytes_number);
+}
+
+/**
+ * @brief Write and read data to/from SPI. Waits for the transfers queued on
+ * the bus first, so it must not be called from a transfer callback.
  * @param desc - The SPI descriptor.
  * @param data - The buffer with the transmitted/received data.
  * @param bytes_number - Number of bytes to write/read.
@@ -171,26 +277,24 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->write_and_read)
-		return -ENOSYS;
-
-	no_os_mutex_lock(desc->bus->mutex);
-	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
+	no_os_spi_bus_acquire(desc->bus);
+	ret = __no_os_spi_write_and_read(desc, data, bytes_number);
 	no_os_mutex_unlock(desc->bus->mutex);
 
 	return ret;
 }
 
 /**
- * @brief  Iterate over head list and send all spi messages
+ * @brief  Iterate over head list and send all spi messages. The caller must
+ * hold the bus lock.
  * @param desc - The SPI descriptor.
  * @param msgs - Array of messages.
  * @param len - Number of messages in the array.
  * @return 0 in case of success, negativ error code otherwise.
  */
-int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
-			   struct no_os_spi_msg *msgs,
-			   uint32_t len)
+int32_t __no_os_spi_transfer(struct no_os_spi_desc *desc,
+			     struct no_os_spi_msg *msgs,
+			     uint32_t len)
 {
 	int32_t  ret = 0;
 	uint32_t i;
@@ -201,27 +305,69 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	if (desc->platform_ops->transfer)
 		return desc->platform_ops->transfer(desc, msgs, len);
 
-	no_os_mutex_lock(desc->bus->mutex);
-
 	for (i = 0; i < len; i++) {
-		if (msgs[i].rx_buff != msgs[i].tx_buff || !msgs[i].tx_buff) {
-			ret = -EINVAL;
-			goto out;
-		}
-		ret = no_os_spi_write_and_read(desc, msgs[i].rx_buff,
-					       msgs[i].bytes_number);
-		if (NO_OS_IS_ERR_VALUE(ret)) {
-			goto out;
-		}
+		if (msgs[i].rx_buff != msgs[i].tx_buff || !msgs[i].tx_buff)
+			return -EINVAL;
+
+		ret = __no_os_spi_write_and_read(desc, msgs[i].rx_buff,
+						 msgs[i].bytes_number);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 	}
 
-out:
+	return ret;
+}
+
+/**
+ * @brief  Iterate over head list and send all spi messages. Waits for the
+ * transfers queued on the bus first, so it must not be called from a transfer
+ * callback.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negativ error code otherwise.
+ */
+int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs,
+			   uint32_t len)
+{
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	no_os_spi_bus_acquire(desc->bus);
+	ret = __no_os_spi_transfer(desc, msgs, len);
 	no_os_mutex_unlock(desc->bus->mutex);
+
 	return ret;
 }
 
 /**
- * @brief Transfer a list of messages using DMA and busy wait for the completion
+ * @brief Transfer a list of messages using DMA and busy wait for the
+ * completion. The caller must hold the bus lock.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negativ error code otherwise.
+ */
+int32_t __no_os_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
+				      struct no_os_spi_msg *msgs,
+				      uint32_t len)
+{
+	if (!desc || !desc->platform_ops || !msgs || !len)
+		return -EINVAL;
+
+	if (!desc->platform_ops->dma_transfer_sync)
+		return -ENOSYS;
+
+	return desc->platform_ops->dma_transfer_sync(desc, msgs, len);
+}
+
+/**
+ * @brief Transfer a list of messages using DMA and busy wait for the
+ * completion. Waits for the transfers queued on the bus first, so it must not
+ * be called from a transfer callback.
  * @param desc - The SPI descriptor.
  * @param msgs - Array of messages.
  * @param len - Number of messages in the array.
@@ -230,20 +376,72 @@ out:
 int32_t no_os_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
 				    struct no_os_spi_msg *msgs,
 				    uint32_t len)
+{
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops || !msgs || !len)
+		return -EINVAL;
+
+	no_os_spi_bus_acquire(desc->bus);
+	ret = __no_os_spi_transfer_dma_sync(desc, msgs, len);
+	no_os_mutex_unlock(desc->bus->mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Transfer a list of messages using DMA. The function will return after the
+ * 	  first transfer is started. Once all the transfers are complete, a callback
+ * 	  will be called. The caller must hold the bus lock until the callback
+ * 	  is invoked.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @param callback - A function which will be called after all the transfers are done.
+ * @param ctx - User specific data which should be passed to the callback function.
+ * @return 0 in case of success, negativ error code otherwise.
+ */
+int32_t __no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+				       struct no_os_spi_msg *msgs,
+				       uint32_t len,
+				       void (*callback)(void *),
+				       void *ctx)
 {
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->dma_transfer_sync)
-		return desc->platform_ops->dma_transfer_sync(desc, msgs, len);
+	if (desc->platform_ops->dma_transfer_async)
+		return desc->platform_ops->dma_transfer_async(desc, msgs, len,
+				callback, ctx);
 
 	return -ENOSYS;
 }
 
+static void no_os_spi_xfer_run(struct no_os_spibus_desc *bus);
+
+/**
+ * @brief Completion callback of no_os_spi_transfer_dma_async(). Gives the bus
+ * back to the transfer queue and invokes the callback of the caller.
+ * @param ctx - The SPI bus descriptor.
+ */
+static void no_os_spi_dma_async_done(void *ctx)
+{
+	struct no_os_spibus_desc *bus = ctx;
+	void (*callback)(void *) = bus->dma_callback;
+	void *cb_ctx = bus->dma_ctx;
+
+	no_os_spi_xfer_run(bus);
+
+	if (callback)
+		callback(cb_ctx);
+}
+
 /**
  * @brief Transfer a list of messages using DMA. The function will return after the
  * 	  first transfer is started. Once all the transfers are complete, a callback
- * 	  will be called.
+ * 	  will be called. The bus is owned by the transfer until then, like
+ * 	  for a queued transfer, so this waits for the transfers queued on the
+ * 	  bus first and must not be called from a transfer callback.
  * @param desc - The SPI descriptor.
  * @param msgs - Array of messages.
  * @param len - Number of messages in the array.
@@ -257,12 +455,202 @@ int32_t no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
 				     void (*callback)(void *),
 				     void *ctx)
 {
+	struct no_os_spibus_desc *bus;
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->dma_transfer_async)
-		return desc->platform_ops->dma_transfer_async(desc, msgs, len,
-				callback, ctx);
+	if (!desc->platform_ops->dma_transfer_async)
+		return -ENOSYS;
 
-	return -ENOSYS;
+	bus = desc->bus;
+
+	no_os_spi_bus_acquire(bus);
+	bus->dma_callback = callback;
+	bus->dma_ctx = ctx;
+	no_os_critical_enter();
+	bus->xfer_busy = true;
+	no_os_critical_exit();
+	no_os_mutex_unlock(bus->mutex);
+
+	ret = __no_os_spi_transfer_dma_async(desc, msgs, len,
+					     no_os_spi_dma_async_done, bus);
+	if (ret)
+		/* Release the bus and start what was queued meanwhile */
+		no_os_spi_xfer_run(bus);
+
+	return ret;
+}
+
+/**
+ * @brief Remove the first transfer from the bus queue and invoke its callback.
+ * @param bus - The SPI bus descriptor.
+ * @param status - Result of the transfer.
+ */
+static void no_os_spi_xfer_complete(struct no_os_spibus_desc *bus,
+				    int32_t status)
+{
+	struct no_os_spi_xfer *xfer;
+
+	no_os_critical_enter();
+	xfer = bus->xfer_head;
+	bus->xfer_head = xfer->next;
+	if (!bus->xfer_head)
+		bus->xfer_tail = NULL;
+	no_os_critical_exit();
+
+	xfer->status = status;
+	xfer->next = NULL;
+	if (xfer->callback)
+		xfer->callback(xfer, xfer->ctx);
+}
+
+/**
+ * @brief Called by the platform code once a background transfer is done.
+ * Starts the next queued transfer.
+ * @param ctx - The SPI bus descriptor.
+ * @param status - Result of the transfer.
+ */
+static void no_os_spi_xfer_async_done(void *ctx, int32_t status)
+{
+	struct no_os_spibus_desc *bus = ctx;
+
+	no_os_spi_xfer_complete(bus, status);
+	no_os_spi_xfer_run(bus);
+}
+
+/**
+ * @brief Completion callback of the DMA transfers, which don't report a
+ * result.
+ * @param ctx - The SPI bus descriptor.
+ */
+static void no_os_spi_xfer_dma_done(void *ctx)
+{
+	no_os_spi_xfer_async_done(ctx, 0);
+}
+
+/**
+ * @brief Process the transfers queued on a bus. A transfer is started in
+ * the background if the platform supports it, and the queue is resumed from
+ * its completion callback. Otherwise, the transfers are sent one after the
+ * other. The queue owns the bus until it drains, so the bus mutex isn't taken
+ * here, which lets this run from the completion interrupts.
+ * @param bus - The SPI bus descriptor.
+ */
+static void no_os_spi_xfer_run(struct no_os_spibus_desc *bus)
+{
+	const struct no_os_spi_platform_ops *ops;
+	struct no_os_spi_xfer *xfer;
+	uint32_t waiters = 0;
+	int32_t ret;
+
+	while (true) {
+		no_os_critical_enter();
+		xfer = bus->xfer_head;
+		if (!xfer) {
+			bus->xfer_busy = false;
+			waiters = bus->xfer_waiters;
+			bus->xfer_waiters = 0;
+		}
+		no_os_critical_exit();
+
+		if (!xfer) {
+			while (waiters--)
+				no_os_semaphore_give(bus->xfer_sem);
+			return;
+		}
+
+		ops = xfer->desc->platform_ops;
+		if (ops->transfer_async || ops->dma_transfer_async) {
+			if (ops->transfer_async)
+				ret = ops->transfer_async(xfer->desc, xfer->msgs,
+							  xfer->len,
+							  no_os_spi_xfer_async_done,
+							  bus);
+			else
+				ret = ops->dma_transfer_async(xfer->desc,
+							      xfer->msgs,
+							      xfer->len,
+							      no_os_spi_xfer_dma_done,
+							      bus);
+			if (!ret)
+				return;
+		} else {
+			ret = __no_os_spi_transfer(xfer->desc, xfer->msgs,
+						   xfer->len);
+		}
+
+		no_os_spi_xfer_complete(bus, ret);
+	}
+}
+
+/**
+ * @brief Queue a list of messages on the SPI bus. The transfers queued on a
+ * bus are sent in order and the callback of each one is invoked once its
+ * messages were sent. On platforms which can transfer in the background, the
+ * function returns right away, so that the next samples are read while the
+ * previous ones are processed. Otherwise, the queue is processed before
+ * returning. The queue owns the bus from the first transfer until it drains:
+ * the other transfer functions wait for it, and a queue which was idle waits
+ * for the transfer in progress before it starts. New transfers may be
+ * submitted from the callbacks, but not while holding the bus lock.
+ * @param desc - The SPI descriptor.
+ * @param xfer - The transfer. Must be valid until its callback is invoked.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_xfer_submit(struct no_os_spi_desc *desc,
+			      struct no_os_spi_xfer *xfer)
+{
+	struct no_os_spibus_desc *bus;
+	bool start;
+
+	if (!desc || !desc->platform_ops || !desc->bus || !xfer ||
+	    !xfer->msgs || !xfer->len)
+		return -EINVAL;
+
+	bus = desc->bus;
+
+	xfer->desc = desc;
+	xfer->status = 0;
+	xfer->next = NULL;
+
+	no_os_critical_enter();
+	if (bus->xfer_tail)
+		bus->xfer_tail->next = xfer;
+	else
+		bus->xfer_head = xfer;
+	bus->xfer_tail = xfer;
+
+	start = !bus->xfer_busy;
+	bus->xfer_busy = true;
+	no_os_critical_exit();
+
+	if (start) {
+		/*
+		 * Callbacks only run while the queue is busy, so this is task
+		 * context. Let a transfer started with the bus mutex held end.
+		 */
+		no_os_mutex_lock(bus->mutex);
+		no_os_mutex_unlock(bus->mutex);
+		no_os_spi_xfer_run(bus);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wait until all the transfers queued on the SPI bus are done.
+ * Must not be called from a transfer callback.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_spi_xfer_wait(struct no_os_spi_desc *desc)
+{
+	if (!desc || !desc->bus)
+		return -EINVAL;
+
+	no_os_spi_xfer_wait_idle(desc->bus);
+
+	return 0;
 }
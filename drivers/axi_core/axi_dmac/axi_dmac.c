@@ -51,173 +51,191 @@
 #include "axi_dmac.h"
 
 /*******************************************************************************
- * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Mark the current transfer as done and notify its owner.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
  *
  * @return None.
 *******************************************************************************/
-void axi_dmac_dev_to_mem_isr(void *instance)
+static void axi_dmac_transfer_done(struct axi_dmac *dmac)
+{
+	dmac->transfer.transfer_done = true;
+	if (dmac->transfer.complete)
+		dmac->transfer.complete(dmac->transfer.complete_ctx);
+}
+
+/*******************************************************************************
+ * @brief Program and submit the next chunks of the current transfer while the
+ *        DMAC queue has room. The ID of the last chunk is kept to detect the
+ *        end of the transfer.
+ *
+ * @param dmac - DMAC istance.
+ * @param max_chunks - Maximum number of chunks to submit.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_submit_chunks(struct axi_dmac *dmac, uint32_t max_chunks)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
 	uint32_t reg_val;
+	uint32_t burst_size;
 
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+	while (dmac->remaining_size && max_chunks--) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+		if (reg_val & AXI_DMAC_QUEUE_FULL)
+			return;
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/* See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
+		/* See if remaining size is bigger than max transfer size and
+		 * set burst size. */
+		if (dmac->remaining_size > dmac->max_length)
+			burst_size = dmac->max_length;
+		else
+			burst_size = dmac->remaining_size - 1;
 
-			/* The current transfer was started; set up the new one. */
+		/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
+		if (dmac->direction != DMA_MEM_TO_DEV) {
 			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute size of the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
+			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE,
+				       dmac->transfer.dest_stride);
 			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-
-			/* Trigger the next transfer. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
 		}
-	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
+		if (dmac->direction != DMA_DEV_TO_MEM) {
+			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
+			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE,
+				       dmac->transfer.src_stride);
+			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
+		}
+		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
+		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH,
+			       dmac->transfer.rows ? dmac->transfer.rows - 1 : 0);
+
+		dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
 		if (!dmac->remaining_size) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_dest_addr = 0;
+			if (dmac->sw_cyclic) {
+				/* Start again from the beginning of the buffer */
+				dmac->remaining_size = dmac->transfer.size;
+				dmac->next_src_addr = dmac->init_addr;
+			} else {
+				/* The ID is assigned by the next submission */
+				axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID,
+					      &dmac->last_id);
+			}
 		}
+
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
 	}
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to dev transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Check if the last chunk of the current transfer was completed.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
  *
- * @return None.
+ * @return true if all the chunks were completed, false otherwise.
 *******************************************************************************/
-void axi_dmac_mem_to_dev_isr(void *instance)
+static bool axi_dmac_last_chunk_done(struct axi_dmac *dmac)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
 	uint32_t reg_val;
 
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
-
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if ((dmac->transfer.cyclic == CYCLIC) &&
-		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
-			dmac->remaining_size = dmac->transfer.size;
-			dmac->next_src_addr = dmac->init_addr;
-		}
+	if (dmac->remaining_size || dmac->transfer.cyclic == CYCLIC)
+		return false;
 
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &reg_val);
 
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
+	return reg_val & NO_OS_BIT(dmac->last_id);
+}
 
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
-	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if ((!dmac->remaining_size) && (dmac->transfer.cyclic != CYCLIC)) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_src_addr = 0;
-		}
-	}
+/*******************************************************************************
+ * @brief Check if the current transfer is repeated by the DMAC itself. Such a
+ *        transfer never completes, it is reported done at the end of its
+ *        first pass.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return true for a hardware cyclic transfer, false otherwise.
+*******************************************************************************/
+static bool axi_dmac_hw_cyclic_active(struct axi_dmac *dmac)
+{
+	return dmac->transfer.cyclic == CYCLIC && !dmac->sw_cyclic;
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to mem DMA transfer. It computes the next transfer
- *			params, if any, and sets the transfer structure fields accordingly.
+ * @brief Handle the DMAC interrupt. At the start of a chunk the queue is
+ *        filled again, at the end of the last chunk the transfer is done.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
  *
  * @return None.
 *******************************************************************************/
-void axi_dmac_mem_to_mem_isr(void *instance)
+static void axi_dmac_irq_handler(struct axi_dmac *dmac)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
 	uint32_t reg_val;
 
 	/* Get interrupt sources and clear interrupts. */
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
+	/* The descriptors flagged with AXI_DMAC_HW_FLAG_IRQ raise the EOT
+	 * interrupt, the last one ends the pass */
+	if (dmac->sg_active) {
+		if (!(reg_val & AXI_DMAC_IRQ_EOT))
+			return;
 
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+		if (!--dmac->sg_irqs_left) {
+			if (dmac->transfer.cyclic != CYCLIC)
+				dmac->sg_active = false;
+			dmac->sg_irqs_left = dmac->sg_nb_irqs;
+			dmac->transfer.transfer_done = true;
+		}
+		if (dmac->transfer.complete)
+			dmac->transfer.complete(dmac->transfer.complete_ctx);
+		return;
+	}
 
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
+	if (reg_val & AXI_DMAC_IRQ_SOT)
+		axi_dmac_submit_chunks(dmac, UINT32_MAX);
 
-			/* If transfer finished advance src address so that transfer_done can be set*/
-			if (!dmac->remaining_size) {
-				dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			}
+	if ((reg_val & AXI_DMAC_IRQ_EOT) && !dmac->transfer.transfer_done &&
+	    (axi_dmac_hw_cyclic_active(dmac) || axi_dmac_last_chunk_done(dmac)))
+		axi_dmac_transfer_done(dmac);
+}
 
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
-	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			if(dmac->next_src_addr > (dmac->init_addr + dmac->transfer.size)) {
-				dmac->transfer.transfer_done = true;
-				dmac->next_src_addr = 0;
-				dmac->next_dest_addr = 0;
-			}
-		}
-	}
+/*******************************************************************************
+ * @brief ISR for dev to mem DMA transfer. It submits the next chunks, if any,
+ *			and signals the end of the transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_dev_to_mem_isr(void *instance)
+{
+	axi_dmac_irq_handler((struct axi_dmac *)instance);
+}
+
+/*******************************************************************************
+ * @brief ISR for mem DMA to dev transfer. It submits the next chunks, if any,
+ *			and signals the end of the transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_mem_to_dev_isr(void *instance)
+{
+	axi_dmac_irq_handler((struct axi_dmac *)instance);
+}
+
+/*******************************************************************************
+ * @brief ISR for mem DMA to mem DMA transfer. It submits the next chunks, if
+ *			any, and signals the end of the transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_mem_to_mem_isr(void *instance)
+{
+	axi_dmac_irq_handler((struct axi_dmac *)instance);
 }
 
 /*******************************************************************************
@@ -298,6 +316,18 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	/* Restore initial value for AXI_DMAC_REG_FLAGS register */
 	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, initial_reg_val);
 
+	/* Check if 2D transfers are possible */
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 1);
+	axi_dmac_read(dmac, AXI_DMAC_REG_Y_LENGTH, &reg_val);
+	dmac->hw_2d = (reg_val == 1);
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0);
+
+	/* Check if hardware scatter-gather is possible */
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0xffffffff);
+	axi_dmac_read(dmac, AXI_DMAC_REG_SG_ADDRESS, &reg_val);
+	dmac->hw_sg = (reg_val != 0);
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0);
+
 	/* Get maximum burst size and set value. */
 	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, dmac->max_length);
 	axi_dmac_read(dmac, AXI_DMAC_REG_X_LENGTH, &dmac->max_length);
@@ -341,6 +371,8 @@ int32_t axi_dmac_init(struct axi_dmac **dmac_core,
 	dmac->name = init->name;
 	dmac->base = init->base;
 	dmac->irq_option = init->irq_option;
+	dmac->poll_period_us = init->poll_period_us ? init->poll_period_us :
+			       AXI_DMAC_POLL_PERIOD_US;
 
 	*dmac_core = dmac;
 
@@ -369,7 +401,37 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 }
 
 /*******************************************************************************
- * @brief Start a DMA transfer.
+ * @brief Enable the DMAC in register or in scatter-gather mode.
+ *
+ * @param dmac - DMAC istance.
+ * @param sg - true for the scatter-gather mode.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_enable(struct axi_dmac *dmac, bool sg)
+{
+	uint32_t reg_val;
+	uint32_t ctrl = AXI_DMAC_CTRL_ENABLE;
+
+	if (sg)
+		ctrl |= AXI_DMAC_CTRL_ENABLE_SG;
+
+	/* Enable DMA if not already enabled in the same mode. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
+	if (reg_val != ctrl) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, ctrl);
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+	}
+}
+
+/*******************************************************************************
+ * @brief Start a DMA transfer. Returns without waiting for the transfer, which
+ *        can be waited with axi_dmac_transfer_wait_completion() or, when the
+ *        DMA IRQ is used, signaled by dma_transfer->complete.
+ *        Transfers larger than the maximum burst size are split in chunks,
+ *        queued in the DMAC as long as it has room. A 2D transfer (rows > 1)
+ *        is submitted at once and needs a row fitting in a burst.
  *
  * @param dmac - DMAC istance.
  * @param dma_transfer - Structure containing transfer details.
@@ -379,20 +441,43 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer)
 {
-	uint32_t reg_val, burst_size;
+	uint32_t reg_val;
 
 	if (dma_transfer->size == 0)
 		return 0; /* Nothing to do. */
 
+	/* The completion callback is called from the ISR */
+	if (dma_transfer->complete && dmac->irq_option != IRQ_ENABLED)
+		return -EINVAL;
+
+	if (dma_transfer->rows > 1 &&
+	    (!dmac->hw_2d || dma_transfer->size - 1 > dmac->max_length))
+		return -EINVAL;
+
+	if (dmac->direction == INVALID_DIR)
+		return -1; /* Other directions are not supported yet. */
+
 	/* Set current transfer parameters. */
+	dmac->transfer.transfer_done = false;
+	dmac->transfer.complete = dma_transfer->complete;
+	dmac->transfer.complete_ctx = dma_transfer->complete_ctx;
 	dmac->transfer.size = dma_transfer->size;
 	dmac->transfer.cyclic = dma_transfer->cyclic;
 	dmac->transfer.dest_addr = dma_transfer->dest_addr;
 	dmac->transfer.src_addr = dma_transfer->src_addr;
+	dmac->transfer.rows = dma_transfer->rows;
+	dmac->transfer.src_stride = dma_transfer->src_stride;
+	dmac->transfer.dest_stride = dma_transfer->dest_stride;
 
+	dmac->sg_active = false;
+	dmac->sw_cyclic = false;
 	dmac->remaining_size = dma_transfer->size;
 	dmac->next_dest_addr = dma_transfer->dest_addr;
 	dmac->next_src_addr = dma_transfer->src_addr;
+	if (dmac->direction == DMA_DEV_TO_MEM)
+		dmac->init_addr = dma_transfer->dest_addr;
+	else
+		dmac->init_addr = dma_transfer->src_addr;
 
 	/* If HW cyclic transfer selected and not available, show error */
 	/* HW cyclic transfer available only for MEM to DEV transfers. */
@@ -415,88 +500,209 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 	reg_val = reg_val & ~DMA_CYCLIC;
 	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 
-	/* Cyclic transfers set to HW for MEM to DEV if smaller than maximum transfer size
-	 * and DMA has this feature. */
-	if ((dmac->direction == DMA_MEM_TO_DEV) && (dmac->transfer.cyclic == CYCLIC)
-	    && ((dmac->remaining_size - 1) <= dmac->max_length) && (dmac->hw_cyclic)) {
-		axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
-		reg_val = reg_val | DMA_CYCLIC;
-		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
+	/* Cyclic transfers set to HW for MEM to DEV if submitted at once
+	 * and DMA has this feature. Otherwise the chunks are submitted again
+	 * when the buffer ends. */
+	if (dmac->transfer.cyclic == CYCLIC) {
+		if ((dmac->remaining_size - 1) <= dmac->max_length ||
+		    dma_transfer->rows > 1) {
+			axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+			reg_val = reg_val | DMA_CYCLIC;
+			axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
+		} else {
+			dmac->sw_cyclic = true;
+		}
 	}
 
-	/* Enable DMA if not already enabled. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
-	if (!(reg_val & AXI_DMAC_CTRL_ENABLE)) {
-		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
-		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
-	}
+	axi_dmac_enable(dmac, false);
+
+	/* Hardware cyclic completion is polled from the interrupt status */
+	if (dmac->irq_option == IRQ_DISABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING,
+			       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
 
 	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
-	/* If we don't have a start of transfer then start compute
-	 * values and trigger next transfer. */
-	if (!(reg_val & AXI_DMAC_QUEUE_FULL)) {
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->init_addr = dmac->next_dest_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			break;
-		default:
-			return -1; /* Other directions are not supported yet. */
-		}
+	if (reg_val & AXI_DMAC_QUEUE_FULL)
+		return -1;
 
-		/* Compute the burst size. */
-		if (dmac->remaining_size > dmac->max_length) {
-			burst_size = dmac->max_length;
-		} else {
-			burst_size = dmac->remaining_size - 1;
-		}
+	/* With the IRQ enabled, the ISR queues the next chunks at the start of
+	 * the first one */
+	if (dmac->irq_option == IRQ_ENABLED)
+		axi_dmac_submit_chunks(dmac, 1);
+	else
+		axi_dmac_submit_chunks(dmac, UINT32_MAX);
 
-		/* Compute next address (src or dest, or both, depending on type of transfer). */
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		default:
-			return -1;
-		}
+	return 0;
+}
 
-		/* Compute remaining size. */
-		dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
+/*******************************************************************************
+ * @brief Build the hardware descriptors of a scatter-gather transfer. The
+ *        descriptors can be submitted any number of times, without being
+ *        built again, with axi_dmac_transfer_start_sg(). They are read by the
+ *        DMAC, so they have to be flushed from the data cache, if any, before
+ *        the transfer is started.
+ *
+ * @param dmac - DMAC istance.
+ * @param sg_transfer - Scatter-gather transfer. Its descs and nb_descs fields
+ *                      have to be set.
+ * @param sg - Array of sg_transfer->nb_descs segments.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_sg_prepare(struct axi_dmac *dmac,
+			    struct axi_dma_sg_transfer *sg_transfer,
+			    const struct axi_dma_sg *sg)
+{
+	struct axi_dmac_hw_desc *desc;
+	uint32_t i;
+
+	if (!dmac || !sg_transfer || !sg_transfer->descs ||
+	    !sg_transfer->nb_descs || !sg)
+		return -EINVAL;
+
+	if (!dmac->hw_sg)
+		return -ENOTSUP;
+
+	for (i = 0; i < sg_transfer->nb_descs; i++) {
+		if (!sg[i].size || sg[i].size - 1 > dmac->max_length)
+			return -EINVAL;
+		if (sg[i].rows > 1 && !dmac->hw_2d)
+			return -EINVAL;
+
+		desc = &sg_transfer->descs[i];
+		desc->flags = sg[i].irq ? AXI_DMAC_HW_FLAG_IRQ : 0;
+		desc->id = 0;
+		desc->dest_addr = sg[i].dest_addr;
+		desc->src_addr = sg[i].src_addr;
+		desc->next_sg_addr = (uintptr_t)&sg_transfer->descs[i + 1];
+		desc->y_len = sg[i].rows ? sg[i].rows - 1 : 0;
+		desc->x_len = sg[i].size - 1;
+		desc->src_stride = sg[i].src_stride;
+		desc->dest_stride = sg[i].dest_stride;
+	}
 
-		/* Specify the length of the transfer and trigger transfer. */
-		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+	/* The last descriptor raises the interrupt, a cyclic chain loops back */
+	desc = &sg_transfer->descs[sg_transfer->nb_descs - 1];
+	sg_transfer->nb_irqs = 1;
+	for (i = 0; i < sg_transfer->nb_descs - 1; i++)
+		if (sg[i].irq)
+			sg_transfer->nb_irqs++;
+	if (sg_transfer->cyclic == CYCLIC) {
+		desc->flags = AXI_DMAC_HW_FLAG_IRQ;
+		desc->next_sg_addr = (uintptr_t)sg_transfer->descs;
 	} else {
-		return -1;
+		desc->flags = AXI_DMAC_HW_FLAG_LAST | AXI_DMAC_HW_FLAG_IRQ;
 	}
 
 	return 0;
 }
 
 /*******************************************************************************
- * @brief Wait for DMA transfer to be completed.
+ * @brief Start a scatter-gather transfer prepared with axi_dmac_sg_prepare().
+ *        The DMAC walks the descriptors by itself. The transfer is done at
+ *        the end of the last descriptor, at every pass for a cyclic one.
+ *        With the IRQ enabled, complete is called at the end of each segment
+ *        raising the interrupt, so a cyclic chain of buffers is reported
+ *        buffer by buffer while the DMAC keeps writing the next ones. Two
+ *        segments ending before the interrupt is serviced are reported once.
+ *
+ * @param dmac - DMAC istance.
+ * @param sg_transfer - Scatter-gather transfer.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_transfer_start_sg(struct axi_dmac *dmac,
+				   struct axi_dma_sg_transfer *sg_transfer)
+{
+	uint32_t reg_val;
+
+	if (!dmac || !sg_transfer || !sg_transfer->descs ||
+	    !sg_transfer->nb_descs)
+		return -EINVAL;
+
+	if (!dmac->hw_sg)
+		return -ENOTSUP;
+
+	/* The completion callback is called from the ISR, which also counts
+	 * the segments raising the interrupt */
+	if ((sg_transfer->complete || sg_transfer->nb_irqs > 1) &&
+	    dmac->irq_option != IRQ_ENABLED)
+		return -EINVAL;
+
+	dmac->transfer.transfer_done = false;
+	dmac->transfer.complete = sg_transfer->complete;
+	dmac->transfer.complete_ctx = sg_transfer->complete_ctx;
+	dmac->transfer.cyclic = sg_transfer->cyclic;
+	dmac->remaining_size = 0;
+	dmac->sw_cyclic = false;
+	dmac->sg_nb_irqs = sg_transfer->nb_irqs ? sg_transfer->nb_irqs : 1;
+	dmac->sg_irqs_left = dmac->sg_nb_irqs;
+	dmac->sg_active = true;
+
+	axi_dmac_enable(dmac, true);
+
+	/* Completion is polled from the interrupt status of this transfer */
+	if (dmac->irq_option == IRQ_DISABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING,
+			       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+	if (reg_val & AXI_DMAC_QUEUE_FULL) {
+		dmac->sg_active = false;
+		return -EBUSY;
+	}
+
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS,
+		       (uintptr_t)sg_transfer->descs);
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS_HIGH, 0);
+
+	/* Keep the other flags, like the partial reporting. A cyclic chain
+	 * loops through its descriptors, so the cyclic flag of a previous
+	 * register mode transfer is cleared. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	reg_val = (reg_val & ~DMA_CYCLIC) | DMA_LAST;
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Check if the current DMA transfer is completed. Without the IRQ, the
+ *        next chunks are queued from here.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return true if the transfer is completed, false otherwise.
+*******************************************************************************/
+static bool axi_dmac_transfer_completed(struct axi_dmac *dmac)
+{
+	uint32_t reg_val = 0;
+
+	if (dmac->irq_option == IRQ_ENABLED)
+		return dmac->transfer.transfer_done;
+
+	if (dmac->sg_active) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+
+		return reg_val & AXI_DMAC_IRQ_EOT;
+	}
+
+	if (axi_dmac_hw_cyclic_active(dmac)) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+
+		return (reg_val & (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT)) ==
+		       (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+	}
+
+	axi_dmac_submit_chunks(dmac, UINT32_MAX);
+
+	return axi_dmac_last_chunk_done(dmac);
+}
+
+/*******************************************************************************
+ * @brief Wait for DMA transfer to be completed. The completion is checked
+ *        every dmac->poll_period_us.
  *
  * @param dmac - DMAC istance.
  * @param timeout_ms - Number of ms to wait for completion of transfer.
@@ -506,29 +712,16 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms)
 {
-	uint32_t timeout = 0;
-	uint32_t reg_val = 0;
+	uint64_t timeout_us = (uint64_t)timeout_ms * 1000;
+	uint64_t elapsed_us = 0;
 
-	if (dmac->irq_option == IRQ_ENABLED) {
-		while (!dmac->transfer.transfer_done) {
-			timeout++;
-			no_os_mdelay(1);
-			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
-				return -1;
-			}
-		}
-	} else if (dmac->irq_option == IRQ_DISABLED) {
-		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-		while (reg_val != (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT)) {
-			timeout++;
-			no_os_mdelay(1);
-			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
-				return -1;
-			}
-			axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+	while (!axi_dmac_transfer_completed(dmac)) {
+		if (elapsed_us >= timeout_us) {
+			printf("Error transferring data using DMA.\n");
+			return -1;
 		}
+		no_os_udelay(dmac->poll_period_us);
+		elapsed_us += dmac->poll_period_us;
 	}
 
 	return 0;
@@ -543,5 +736,6 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 *******************************************************************************/
 void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
+	dmac->sg_active = false;
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
 }
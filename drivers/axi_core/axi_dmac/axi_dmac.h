@@ -62,6 +62,7 @@
 #define AXI_DMAC_CTRL_ENABLE		NO_OS_BIT(0)
 #define AXI_DMAC_CTRL_DISABLE		0u
 #define AXI_DMAC_CTRL_PAUSE			NO_OS_BIT(1)
+#define AXI_DMAC_CTRL_ENABLE_SG		NO_OS_BIT(2)
 
 #define AXI_DMAC_REG_TRANSFER_ID		0x404
 #define AXI_DMAC_REG_TRANSFER_SUBMIT	0x408
@@ -75,6 +76,15 @@
 #define AXI_DMAC_REG_DEST_STRIDE		0x420
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
+#define AXI_DMAC_REG_SG_ADDRESS			0x47c
+#define AXI_DMAC_REG_SG_ADDRESS_HIGH	0x4bc
+
+/* Flags of a scatter-gather hardware descriptor */
+#define AXI_DMAC_HW_FLAG_LAST			NO_OS_BIT(0)
+#define AXI_DMAC_HW_FLAG_IRQ			NO_OS_BIT(1)
+
+/* Default period of the transfer completion polling */
+#define AXI_DMAC_POLL_PERIOD_US			10
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -109,6 +119,61 @@ struct axi_dma_transfer {
 	enum cyclic_transfer cyclic;
 	uint32_t src_addr;
 	uint32_t dest_addr;
+	/* Called from the DMA interrupt when the transfer is done. Optional */
+	void (*complete)(void *ctx);
+	/* Parameter of complete */
+	void *complete_ctx;
+	/* Number of rows of size bytes of a 2D transfer. 0 or 1 for 1D */
+	uint32_t rows;
+	/* Distance in bytes between the rows in the source */
+	uint32_t src_stride;
+	/* Distance in bytes between the rows in the destination */
+	uint32_t dest_stride;
+};
+
+/* Segment of a scatter-gather transfer */
+struct axi_dma_sg {
+	/* Number of bytes, of each row for a 2D segment */
+	uint32_t size;
+	/* Number of rows of a 2D segment. 0 or 1 for 1D */
+	uint32_t rows;
+	uint32_t src_addr;
+	uint32_t dest_addr;
+	/* Distance in bytes between the rows in the source */
+	uint32_t src_stride;
+	/* Distance in bytes between the rows in the destination */
+	uint32_t dest_stride;
+	/* Raise the interrupt at the end of this segment. Always set for the
+	 * last one */
+	bool irq;
+};
+
+/* Scatter-gather descriptor, as read by the DMAC */
+struct axi_dmac_hw_desc {
+	uint32_t flags;
+	uint32_t id;
+	uint64_t dest_addr;
+	uint64_t src_addr;
+	uint64_t next_sg_addr;
+	uint32_t y_len;
+	uint32_t x_len;
+	uint32_t src_stride;
+	uint32_t dest_stride;
+	uint64_t pad[2];
+};
+
+struct axi_dma_sg_transfer {
+	/* One descriptor for each segment, in memory read by the DMAC */
+	struct axi_dmac_hw_desc *descs;
+	uint32_t nb_descs;
+	/* A cyclic transfer starts again from the first segment */
+	enum cyclic_transfer cyclic;
+	/* Number of segments raising the interrupt. Set by axi_dmac_sg_prepare */
+	uint32_t nb_irqs;
+	/* Called from the DMA interrupt after each segment raising it. Optional */
+	void (*complete)(void *ctx);
+	/* Parameter of complete */
+	void *complete_ctx;
 };
 
 struct axi_dmac {
@@ -117,6 +182,8 @@ struct axi_dmac {
 	enum use_irq irq_option;
 	enum dma_direction direction;
 	bool hw_cyclic;
+	bool hw_2d;
+	bool hw_sg;
 	uint32_t max_length;
 	volatile struct axi_dma_transfer transfer;
 	//Current sub-transfer properties
@@ -124,12 +191,25 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	/* ID of the last chunk of the current transfer */
+	uint32_t last_id;
+	/* Cyclic transfer submitted again by the driver */
+	bool sw_cyclic;
+	/* A scatter-gather transfer is running */
+	volatile bool sg_active;
+	/* Segments raising the interrupt in each pass of the chain */
+	uint32_t sg_nb_irqs;
+	/* Interrupts left until the end of the current pass */
+	uint32_t sg_irqs_left;
+	uint32_t poll_period_us;
 };
 
 struct axi_dmac_init {
 	const char *name;
 	uint32_t base;
 	enum use_irq irq_option;
+	/* Completion polling period. 0 for AXI_DMAC_POLL_PERIOD_US */
+	uint32_t poll_period_us;
 };
 
 /******************************************************************************/
@@ -149,6 +229,11 @@ int32_t axi_dmac_init(struct axi_dmac **adc_core,
 int32_t axi_dmac_remove(struct axi_dmac *dmac);
 int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer);
+int32_t axi_dmac_sg_prepare(struct axi_dmac *dmac,
+			    struct axi_dma_sg_transfer *sg_transfer,
+			    const struct axi_dma_sg *sg);
+int32_t axi_dmac_transfer_start_sg(struct axi_dmac *dmac,
+				   struct axi_dma_sg_transfer *sg_transfer);
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
@@ -49,6 +49,7 @@ significant delays */
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sleep.h>
 #include <inttypes.h>
 
@@ -64,6 +65,7 @@ significant delays */
 const struct no_os_spi_platform_ops spi_eng_platform_ops = {
 	.init = &spi_engine_init,
 	.write_and_read = &spi_engine_write_and_read,
+	.transfer = &spi_engine_transfer,
 	.remove = &spi_engine_remove
 };
 
@@ -166,11 +168,11 @@ void spi_engine_set_speed(struct no_os_spi_desc *desc,
  * @param bytes_number The number of bytes to be converted
  * @return uint8_t A number of words in which bytes_number can be grouped
  */
-static uint8_t spi_get_words_number(struct spi_engine_desc *desc,
-				    uint8_t bytes_number)
+static uint32_t spi_get_words_number(struct spi_engine_desc *desc,
+				     uint32_t bytes_number)
 {
 	uint8_t xfer_word_len;
-	uint8_t words_number;
+	uint32_t words_number;
 
 	xfer_word_len = desc->data_width / 8;
 	words_number = bytes_number / xfer_word_len;
@@ -227,114 +229,19 @@ static int32_t spi_get_sleep_div(struct no_os_spi_desc *desc,
 }
 
 /**
- * @brief Create a new commands queue used in a spi transfer
+ * @brief Append an instruction to a compiled message
  *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command with wich the buffer will be initiated
- * @return int32_t Failure if the memory allocation failed
+ * @param msg Message being compiled
+ * @param cmd Engine instruction
+ * @return int32_t - 0 if the instruction was added
+ *		   - -ENOSPC if the message is full
  */
-static int32_t spi_engine_queue_new_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t cmd)
+static int32_t spi_engine_msg_add(struct spi_engine_msg *msg, uint32_t cmd)
 {
-	struct spi_engine_cmd_queue *local_fifo;
-
-	local_fifo = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*local_fifo));
-
-	if(!local_fifo)
-		return -1;
+	if (msg->nb_cmds >= SPI_ENGINE_MSG_MAX_CMDS)
+		return -ENOSPC;
 
-	local_fifo->cmd = cmd;
-	local_fifo->next = NULL;
-	*fifo = local_fifo;
-
-	return 0;
-}
-
-/**
- * @brief Add a command at the end of an existing queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command to be added
- */
-static void spi_engine_queue_add_cmd(struct spi_engine_cmd_queue **fifo,
-				     uint32_t cmd)
-{
-	struct spi_engine_cmd_queue *to_add = NULL;
-	struct spi_engine_cmd_queue *local_fifo;
-
-	local_fifo = *fifo;
-	while (local_fifo->next != NULL) {
-		// Get the last element
-		local_fifo = local_fifo->next;
-	}
-
-	// Create a new element
-	spi_engine_queue_new_cmd(&to_add, cmd);
-	// Add as the next element
-	local_fifo->next = to_add;
-}
-
-/**
- * @brief Add a command at the beginning of an existing queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command to be added
- */
-static void spi_engine_queue_append_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t cmd)
-{
-	struct spi_engine_cmd_queue *to_add = NULL;
-
-	// Create a new element
-	spi_engine_queue_new_cmd(&to_add, cmd);
-	// Interchange the addresses
-	to_add->next = *fifo;
-	*fifo = to_add;
-}
-
-
-/**
- * @brief Get the command from the beginning of the queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Value of the command that was extracted
- * @return int32_t Return -1 if the queue is empty
- */
-static int32_t spi_engine_queue_get_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t *cmd)
-{
-	struct spi_engine_cmd_queue *local_fifo;
-
-	if (!*fifo)
-		return -1;
-
-	local_fifo = *fifo;
-	*cmd = local_fifo->cmd;
-	if ((*fifo)->next) {
-		*fifo = local_fifo->next;
-		no_os_free(local_fifo);
-	} else {
-		no_os_free(*fifo);
-		*fifo = NULL;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Free the memory allocated by a queue
- *
- * @param fifo The queue that needs it's memory freed
- * @return int32_t This function allways returns 0
- */
-static int32_t spi_engine_queue_no_os_free(struct spi_engine_cmd_queue **fifo)
-{
-	if(*fifo && (*fifo)->next)
-		spi_engine_queue_no_os_free(&(*fifo)->next);
-	if((*fifo) != NULL) {
-		no_os_free(*fifo);
-		*fifo = NULL;
-	}
+	msg->cmds[msg->nb_cmds++] = cmd;
 
 	return 0;
 }
@@ -367,22 +274,31 @@ static int32_t spi_engine_write_cmd_reg(struct spi_engine_desc *desc,
 }
 
 /**
- * @brief Write a transfer command to the SPI engine's command fifo
+ * @brief Add a transfer instruction to a compiled message
  *
  * @param desc Decriptor containing SPI Engine's parameters
+ * @param msg Message being compiled
  * @param read_write Read/Write operation flag
  * @param bytes_number Number of bytes to transfer
- * @return int32_t This function allways returns 0
+ * @return int32_t - 0 if the instruction was added
+ *		   - -ENOSPC if the message is full
  */
-static int32_t spi_engine_transfer(struct spi_engine_desc *desc,
-				   uint8_t read_write,
-				   uint8_t bytes_number)
+static int32_t spi_engine_add_transfer(struct spi_engine_desc *desc,
+				       struct spi_engine_msg *msg,
+				       uint8_t read_write,
+				       uint32_t bytes_number)
 {
-	uint8_t words_number;
+	uint32_t words_number;
 
 	words_number = spi_get_words_number(desc, bytes_number);
+	if (!words_number || words_number > SPI_ENGINE_MAX_XFER_WORDS)
+		return -EINVAL;
 
-	desc->offload_tx_len += words_number;
+	msg->length += words_number;
+	if (read_write & SPI_ENGINE_INSTRUCTION_TRANSFER_W)
+		msg->nb_tx_words += words_number;
+	if (read_write & SPI_ENGINE_INSTRUCTION_TRANSFER_R)
+		msg->nb_rx_words += words_number;
 
 	/*
 	 * Engine Wiki:
@@ -392,24 +308,25 @@ static int32_t spi_engine_transfer(struct spi_engine_desc *desc,
 	 * The words number is zero based
 	 */
 
-	spi_engine_write_cmd_reg(desc,
-				 SPI_ENGINE_CMD_TRANSFER(read_write,
-						 words_number  - 1));
-
-	return 0;
+	return spi_engine_msg_add(msg, SPI_ENGINE_CMD_TRANSFER(read_write,
+				  words_number - 1));
 }
 
 /**
- * @brief Change the state of the chip select port
+ * @brief Add a chip select change to a compiled message
  *
  * @param desc Decriptor containing SPI interface parameters
+ * @param msg Message being compiled
  * @param assert Chip select state.
  * 		 The supported values are :
  * 			-true (HIGH)
  * 			-false (LOW)
+ * @return int32_t - 0 if the instruction was added
+ *		   - -ENOSPC if the message is full
  */
-static void spi_engine_set_cs(struct no_os_spi_desc *desc,
-			      bool assert)
+static int32_t spi_engine_set_cs(struct no_os_spi_desc *desc,
+				 struct spi_engine_msg *msg,
+				 bool assert)
 {
 	uint8_t			mask;
 	struct spi_engine_desc	*eng_desc;
@@ -421,40 +338,56 @@ static void spi_engine_set_cs(struct no_os_spi_desc *desc,
 	if (!assert)
 		mask ^= NO_OS_BIT(desc->chip_select);
 
-	spi_engine_write_cmd_reg(eng_desc,
-				 SPI_ENGINE_CMD_ASSERT(eng_desc->cs_delay,
-						 mask));
+	return spi_engine_msg_add(msg, SPI_ENGINE_CMD_ASSERT(eng_desc->cs_delay,
+				  mask));
 }
 
 /**
  * @brief Add a delay bewtheen the engine commands
  *
  * @param desc Decriptor containing SPI interface parameters
+ * @param msg Message being compiled
  * @param sleep_time_ns Number of nanoseconds to sleep between commands
+ * @return int32_t - 0 if the instruction was added
+ *		   - -ENOSPC if the message is full
  */
-static void spi_gen_sleep_ns(struct no_os_spi_desc *desc,
-			     uint32_t sleep_time_ns)
+static int32_t spi_gen_sleep_ns(struct no_os_spi_desc *desc,
+				struct spi_engine_msg *msg,
+				uint32_t sleep_time_ns)
 {
 	uint32_t 		sleep_div;
-	struct spi_engine_desc	*eng_desc;
-
-	eng_desc = desc->extra;
+	int32_t			ret;
 
 	spi_get_sleep_div(desc, sleep_time_ns, &sleep_div);
 
-	spi_engine_write_cmd_reg(eng_desc, SPI_ENGINE_CMD_SLEEP(sleep_div));
+	/* Delays shorter than one sleep period underflow the prescaler */
+	if ((int32_t)sleep_div < 0)
+		sleep_div = 0;
+
+	/* The sleep field is 8 bits wide, long delays take more instructions */
+	while (sleep_div > 0xFF) {
+		ret = spi_engine_msg_add(msg, SPI_ENGINE_CMD_SLEEP(0xFF));
+		if (ret)
+			return ret;
+		sleep_div -= 0x100;
+	}
+
+	return spi_engine_msg_add(msg, SPI_ENGINE_CMD_SLEEP(sleep_div));
 }
 
 /**
  * @brief Spi engine command interpreter
  *
  * @param desc Decriptor containing SPI interface parameters
- * @param cmd Command to send to the engine
- * @return int32_t - 0 if the command is transfered
- *		   - -1 if the command format is invalid
+ * @param msg Message where the engine instructions are added
+ * @param cmd Command to translate
+ * @return int32_t - 0 if the command is added
+ *		   - negative error code if the command format is invalid or
+ *		     the message is full
  */
-static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
-				    uint32_t cmd)
+static int32_t spi_engine_compile_cmd(struct no_os_spi_desc *desc,
+				      struct spi_engine_msg *msg,
+				      uint32_t cmd)
 {
 	uint8_t				engine_command;
 	uint8_t				parameter;
@@ -469,16 +402,16 @@ static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
 
 	switch(engine_command) {
 	case SPI_ENGINE_INST_TRANSFER:
-		spi_engine_transfer(desc_extra, modifier, parameter);
-		break;
+		return spi_engine_add_transfer(desc_extra, msg, modifier,
+					       parameter);
 
 	case SPI_ENGINE_INST_ASSERT:
 		if(parameter == 0xFF) {
 			/* Set the CS HIGH */
-			spi_engine_set_cs(desc, true);
+			return spi_engine_set_cs(desc, msg, true);
 		} else if(parameter == 0x00) {
 			/* Set the CS LOW */
-			spi_engine_set_cs(desc, false);
+			return spi_engine_set_cs(desc, msg, false);
 		}
 		break;
 
@@ -487,15 +420,13 @@ static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
 	case SPI_ENGINE_INST_SYNC_SLEEP:
 		/* SYNC instruction */
 		if(modifier == 0x00) {
-			spi_engine_write_cmd_reg(desc_extra, cmd);
+			return spi_engine_msg_add(msg, cmd);
 		} else if(modifier == 0x01) {
-			spi_gen_sleep_ns(desc, parameter);
+			return spi_gen_sleep_ns(desc, msg, parameter);
 		}
 		break;
 	case SPI_ENGINE_INST_CONFIG:
-		spi_engine_write_cmd_reg(desc_extra, cmd);
-
-		break;
+		return spi_engine_msg_add(msg, cmd);
 
 	default:
 
@@ -506,57 +437,94 @@ static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
 }
 
 /**
- * @brief Prepare the command queue before sending it to the engine
+ * @brief Start a compiled message with the current SPI configuration
  *
  * @param desc Decriptor containing SPI interface parameters
- * @param msg Structure used to store the transfer messages
+ * @param msg Message to be initialized
  * @return int32_t This function allways returns 0
  */
-static int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
-		struct spi_engine_msg *msg)
+static int32_t spi_engine_msg_init(struct no_os_spi_desc *desc,
+				   struct spi_engine_msg *msg)
 {
 	struct spi_engine_desc	*desc_extra;
 
 	desc_extra = desc->extra;
 
-	/* Configure the prescaler */
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_REG_CLK_DIV,
-					    desc_extra->clk_div));
+	msg->nb_cmds = 0;
+	msg->length = 0;
+	msg->nb_tx_words = 0;
+	msg->nb_rx_words = 0;
 
-	/* Set the data transfer length */
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
-					    desc_extra->data_width));
 	/*
 	 * Configure the spi mode :
 	 *	- 3 wire
 	 *	- CPOL
 	 *	- CPHA
 	 */
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_REG_CONFIG,
-					    desc->mode));
+	spi_engine_msg_add(msg, SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG,
+			   desc->mode));
 
-	/* Add a sync command to signal that the transfer has finished */
-	spi_engine_queue_add_cmd(&msg->cmds, SPI_ENGINE_CMD_SYNC(_sync_id));
+	/* Set the data transfer length */
+	spi_engine_msg_add(msg, SPI_ENGINE_CMD_CONFIG(
+				   SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
+				   desc_extra->data_width));
+
+	/* Configure the prescaler */
+	spi_engine_msg_add(msg, SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+			   desc_extra->clk_div));
 
 	return 0;
 }
 
 /**
- * @brief Initiate a spi transfer
+ * @brief Translate SPI engine commands into a message that can be sent any
+ * number of times with spi_engine_transfer_message(). The message uses the
+ * SPI configuration (speed, data width, mode, chip select) at the time of the
+ * call, so it has to be compiled again after this configuration is changed.
  *
  * @param desc Decriptor containing SPI interface parameters
- * @param msg Structure used to store the transfer messages
- * @return int32_t - 0 if the transfer finished
- *		   - -1 if the memory allocation failed
+ * @param commands SPI engine commands (WRITE, READ, CS_LOW, ...)
+ * @param no_commands Number of commands
+ * @param msg Compiled message
+ * @return int32_t - 0 if the message was compiled
+ *		   - negative error code if a command is invalid or the message
+ *		     does not fit in SPI_ENGINE_MSG_MAX_CMDS instructions
+ */
+int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
+				   const uint32_t *commands,
+				   uint32_t no_commands,
+				   struct spi_engine_msg *msg)
+{
+	uint32_t	i;
+	int32_t		ret;
+
+	if (!desc || !commands || !msg)
+		return -EINVAL;
+
+	spi_engine_msg_init(desc, msg);
+
+	for (i = 0; i < no_commands; i++) {
+		ret = spi_engine_compile_cmd(desc, msg, commands[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Send a compiled message
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Compiled message
+ * @param tx_buf Words written on the SDO line
+ * @param rx_buf Words read from the SDI line. Not used in offload mode
+ * @return int32_t This function allways returns 0
  */
-static int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
-		struct spi_engine_msg *msg)
+int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
+				    const struct spi_engine_msg *msg,
+				    const uint32_t *tx_buf,
+				    uint32_t *rx_buf)
 {
 	uint32_t		i;
 	uint32_t		data;
@@ -566,30 +534,29 @@ static int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
 
 	desc_extra = desc->extra;
 
-	spi_engine_compile_message(desc, msg);
-
 	offload_en = (desc_extra->offload_config & OFFLOAD_TX_EN) |
 		     (desc_extra->offload_config & OFFLOAD_RX_EN);
 
 	/* Write the command fifo buffer */
-	while(msg->cmds != NULL) {
-		spi_engine_queue_get_cmd(&msg->cmds, &data);
-		spi_engine_write_cmd(desc, data);
-	}
+	for (i = 0; i < msg->nb_cmds; i++)
+		spi_engine_write_cmd_reg(desc_extra, msg->cmds[i]);
+
+	/* Add a sync command to signal that the transfer has finished */
+	spi_engine_write_cmd_reg(desc_extra, SPI_ENGINE_CMD_SYNC(_sync_id));
 
 	/* Write a number of tx_length WORDS on the SDO line */
 
 	if(offload_en) {
-		for(i = 0; i < desc_extra->offload_tx_len; i++)
+		for(i = 0; i < msg->nb_tx_words; i++)
 			spi_engine_write(desc_extra,
 					 SPI_ENGINE_REG_OFFLOAD_SDO_MEM(0),
-					 msg->tx_buf[i]);
+					 tx_buf[i]);
 
 	} else {
-		for(i = 0; i < msg->length; i++)
+		for(i = 0; i < msg->nb_tx_words; i++)
 			spi_engine_write(desc_extra,
 					 SPI_ENGINE_REG_SDO_DATA_FIFO,
-					 msg->tx_buf[i]);
+					 tx_buf[i]);
 		do {
 			spi_engine_read(desc_extra,
 					SPI_ENGINE_REG_SYNC_ID,
@@ -601,11 +568,11 @@ static int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
 
 		/* Read a number of rx_length WORDS from the SDI line and store
 		them */
-		for(i = 0; i < msg->length; i++) {
+		for(i = 0; i < msg->nb_rx_words; i++) {
 			spi_engine_read(desc_extra,
 					SPI_ENGINE_REG_SDI_DATA_FIFO,
 					&data);
-			msg->rx_buf[i] = data;
+			rx_buf[i] = data;
 		}
 	}
 
@@ -638,7 +605,7 @@ int32_t spi_engine_init(struct no_os_spi_desc **desc,
 		return -1;
 	}
 
-	eng_desc = (struct spi_engine_desc*)no_os_malloc(sizeof(*eng_desc));
+	eng_desc = (struct spi_engine_desc*)no_os_calloc(1, sizeof(*eng_desc));
 
 	if (!eng_desc)
 		return -1;
@@ -688,20 +655,26 @@ int32_t spi_engine_init(struct no_os_spi_desc **desc,
  * @param bytes_number Number of bytes to transfer
  * @return int32_t - 0 if the transfer finished
  *		   - -1 if the memory allocation or transfer failed
+ *		   - -EBUSY if the offload module is streaming
  */
 int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 				  uint8_t *data,
 				  uint16_t bytes_number)
 {
-	uint8_t 		i;
+	uint32_t 		i;
 	uint8_t 		word_len;
-	uint8_t 		words_number;
+	uint32_t 		words_number;
 	int32_t 		ret;
-	struct spi_engine_msg	msg;
+	uint32_t		*words;
+	struct spi_engine_msg	*msg;
 	struct spi_engine_desc	*desc_extra;
 
 	desc_extra = desc->extra;
 
+	/* Disabling the offload would silently stop the stream */
+	if (desc_extra->stream.active)
+		return -EBUSY;
+
 	/* If we want to access SPI interface and SPI engine offload module was
 	 * activated, we need to disable it
 	 * This is set in spi_engine_offload_init() */
@@ -710,59 +683,284 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	spi_engine_write(desc_extra, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
 
 	words_number = spi_get_words_number(desc_extra, bytes_number);
+	if (!words_number || words_number > SPI_ENGINE_MAX_XFER_WORDS)
+		return -EINVAL;
 
-	msg.cmds = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*msg.cmds));
-	if (!msg.cmds)
-		return -1;
+	/* The message and the words are stored in the descriptor */
+	msg = &desc_extra->msg;
+	words = desc_extra->words;
 
-	msg.tx_buf =(uint32_t*)no_os_calloc(words_number, sizeof(msg.tx_buf[0]));
-	msg.rx_buf =(uint32_t*)no_os_calloc(words_number, sizeof(msg.rx_buf[0]));
-	msg.length = words_number;
+	/* Make sure the CS is HIGH before starting a transaction */
+	spi_engine_msg_init(desc, msg);
+	spi_engine_set_cs(desc, msg, true);
+	spi_engine_set_cs(desc, msg, false);
+	spi_engine_add_transfer(desc_extra, msg,
+				SPI_ENGINE_INSTRUCTION_TRANSFER_RW, bytes_number);
+	spi_engine_set_cs(desc, msg, true);
 
 	/* Get the length of transfered word */
 	word_len = spi_get_word_lenght(desc_extra);
 
-	/* Make sure the CS is HIGH before starting a transaction */
-	msg.cmds->next = NULL;
-	msg.cmds->cmd = CS_HIGH;
-	spi_engine_queue_add_cmd(&msg.cmds, CS_LOW);
-	spi_engine_queue_add_cmd(&msg.cmds, WRITE_READ(bytes_number));
-	spi_engine_queue_add_cmd(&msg.cmds, CS_HIGH);
-
 	/* Pack the bytes into engine WORDS */
+	memset(words, 0, words_number * sizeof(*words));
 	for (i = 0; i < bytes_number; i++)
-		msg.tx_buf[i / word_len] |= data[i] << (desc_extra->data_width-
-							(i % word_len + 1) * 8);
+		words[i / word_len] |= (uint32_t)data[i] <<
+				       (desc_extra->data_width -
+					(i % word_len + 1) * 8);
 
-	ret = spi_engine_transfer_message(desc, &msg);
+	/* The words are all written before the received ones are stored */
+	ret = spi_engine_transfer_message(desc, msg, words, words);
 
 	for (i = 0; i < bytes_number; i++)
-		data[i] = msg.rx_buf[(i) / word_len] >>
+		data[i] = words[(i) / word_len] >>
 			  (desc_extra->data_width -
 			   ((i) % word_len + 1) * 8);
 
-	spi_engine_queue_no_os_free(&msg.cmds);
-	no_os_free(msg.tx_buf);
-	no_os_free(msg.rx_buf);
-
 	return ret;
 }
 
+/**
+ * @brief Add a SPI message to a compiled message
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Message being compiled
+ * @param xfer SPI message to add
+ * @param cs_asserted Chip select state, updated by the added instructions
+ * @return int32_t - 0 if the SPI message was added
+ *		   - -ENOSPC if the compiled message is full
+ *		   - -EINVAL if the SPI message is too long
+ */
+static int32_t spi_engine_add_spi_msg(struct no_os_spi_desc *desc,
+				      struct spi_engine_msg *msg,
+				      const struct no_os_spi_msg *xfer,
+				      bool *cs_asserted)
+{
+	uint32_t		words_number;
+	int32_t			ret;
+	struct spi_engine_desc	*desc_extra;
+
+	desc_extra = desc->extra;
+
+	words_number = spi_get_words_number(desc_extra, xfer->bytes_number);
+	if (words_number > SPI_ENGINE_MAX_XFER_WORDS)
+		return -EINVAL;
+	/* All the words of the batch are packed in the descriptor */
+	if (msg->nb_tx_words + words_number > SPI_ENGINE_MAX_XFER_WORDS)
+		return -ENOSPC;
+
+	if (!*cs_asserted) {
+		ret = spi_engine_set_cs(desc, msg, false);
+		if (ret)
+			return ret;
+		*cs_asserted = true;
+	}
+
+	if (xfer->cs_delay_first) {
+		ret = spi_gen_sleep_ns(desc, msg, xfer->cs_delay_first * 1000);
+		if (ret)
+			return ret;
+	}
+
+	/* Zeros are written when there is no tx buffer */
+	if (words_number) {
+		ret = spi_engine_add_transfer(desc_extra, msg,
+					      xfer->rx_buff ?
+					      SPI_ENGINE_INSTRUCTION_TRANSFER_RW :
+					      SPI_ENGINE_INSTRUCTION_TRANSFER_W,
+					      xfer->bytes_number);
+		if (ret)
+			return ret;
+	}
+
+	if (xfer->cs_delay_last) {
+		ret = spi_gen_sleep_ns(desc, msg, xfer->cs_delay_last * 1000);
+		if (ret)
+			return ret;
+	}
+
+	if (xfer->cs_change) {
+		ret = spi_engine_set_cs(desc, msg, true);
+		if (ret)
+			return ret;
+		*cs_asserted = false;
+	}
+
+	if (xfer->cs_change_delay)
+		return spi_gen_sleep_ns(desc, msg,
+					xfer->cs_change_delay * 1000);
+
+	return 0;
+}
+
+/**
+ * @brief Send the message compiled in the descriptor for a batch of SPI
+ * messages and store the received data.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msgs SPI messages compiled in the descriptor's message
+ * @param len Number of SPI messages
+ * @return int32_t This function allways returns 0
+ */
+static int32_t spi_engine_transfer_batch(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs,
+		uint32_t len)
+{
+	uint32_t		i;
+	uint32_t		j;
+	uint32_t		offset;
+	uint8_t			word_len;
+	uint8_t			data_width;
+	uint32_t		*words;
+	struct spi_engine_desc	*desc_extra;
+	int32_t			ret;
+
+	desc_extra = desc->extra;
+	words = desc_extra->words;
+	word_len = spi_get_word_lenght(desc_extra);
+	data_width = desc_extra->data_width;
+
+	/* Each SPI message starts on a new engine WORD */
+	memset(words, 0, desc_extra->msg.nb_tx_words * sizeof(*words));
+	offset = 0;
+	for (i = 0; i < len; i++) {
+		if (msgs[i].tx_buff)
+			for (j = 0; j < msgs[i].bytes_number; j++)
+				words[offset + j / word_len] |=
+					(uint32_t)msgs[i].tx_buff[j] <<
+					(data_width - (j % word_len + 1) * 8);
+		offset += spi_get_words_number(desc_extra,
+					       msgs[i].bytes_number);
+	}
+
+	/* The words are all written before the received ones are stored */
+	ret = spi_engine_transfer_message(desc, &desc_extra->msg, words, words);
+	if (ret)
+		return ret;
+
+	/* Only the messages with a rx buffer have received words */
+	offset = 0;
+	for (i = 0; i < len; i++) {
+		if (!msgs[i].rx_buff)
+			continue;
+		for (j = 0; j < msgs[i].bytes_number; j++)
+			msgs[i].rx_buff[j] = words[offset + j / word_len] >>
+					     (data_width -
+					      (j % word_len + 1) * 8);
+		offset += spi_get_words_number(desc_extra,
+					       msgs[i].bytes_number);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Transfer a list of SPI messages. The messages are compiled into a
+ * single engine program that ends with one SYNC instruction and the data FIFOs
+ * are written and read in bulk. A list that does not fit in one program is
+ * sent in several programs.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msgs Array of SPI messages
+ * @param len Number of SPI messages
+ * @return int32_t - 0 if the transfer finished
+ *		   - -EBUSY if the offload module is streaming
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_transfer(struct no_os_spi_desc *desc,
+			    struct no_os_spi_msg *msgs,
+			    uint32_t len)
+{
+	uint32_t		i;
+	uint32_t		first;
+	uint32_t		nb_cmds;
+	uint32_t		length;
+	uint32_t		nb_tx_words;
+	uint32_t		nb_rx_words;
+	bool			cs_asserted;
+	bool			cs_state;
+	int32_t			ret;
+	struct spi_engine_msg	*msg;
+	struct spi_engine_desc	*desc_extra;
+
+	if (!desc || !msgs || !len)
+		return -EINVAL;
+
+	desc_extra = desc->extra;
+
+	if (desc_extra->stream.active)
+		return -EBUSY;
+
+	/* The messages are sent through the FIFOs, see
+	 * spi_engine_write_and_read() */
+	desc_extra->offload_config = OFFLOAD_DISABLED;
+	spi_engine_write(desc_extra, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+
+	msg = &desc_extra->msg;
+	cs_asserted = false;
+	first = 0;
+
+	/* Make sure the CS is HIGH before starting a transaction */
+	spi_engine_msg_init(desc, msg);
+	ret = spi_engine_set_cs(desc, msg, true);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < len; i++) {
+		nb_cmds = msg->nb_cmds;
+		length = msg->length;
+		nb_tx_words = msg->nb_tx_words;
+		nb_rx_words = msg->nb_rx_words;
+		cs_state = cs_asserted;
+
+		ret = spi_engine_add_spi_msg(desc, msg, &msgs[i], &cs_asserted);
+		if (ret != -ENOSPC || i == first) {
+			if (ret)
+				return ret;
+			continue;
+		}
+
+		/* Send the messages that fit and start a new program */
+		msg->nb_cmds = nb_cmds;
+		msg->length = length;
+		msg->nb_tx_words = nb_tx_words;
+		msg->nb_rx_words = nb_rx_words;
+		cs_asserted = cs_state;
+
+		ret = spi_engine_transfer_batch(desc, &msgs[first], i - first);
+		if (ret)
+			return ret;
+
+		first = i;
+		spi_engine_msg_init(desc, msg);
+		ret = spi_engine_add_spi_msg(desc, msg, &msgs[i], &cs_asserted);
+		if (ret)
+			return ret;
+	}
+
+	return spi_engine_transfer_batch(desc, &msgs[first], len - first);
+}
+
 /**
  * @brief Initialize the SPI engine's offload module
  *
  * @param desc Decriptor containing SPI interface parameters
  * @param param Structure containing the offload init parameters
- * @return int32_t This function allways returns 0
+ * @return int32_t - 0 if the offload module was initialized
+ *		   - -1 if a DMAC initialization failed
+ *		   - -EBUSY if the offload module is streaming or a DMAC was
+ *		     already initialized with a different base or irq_option
  */
 int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 				const struct spi_engine_offload_init_param *param)
 {
 	struct spi_engine_desc	*eng_desc;
-	struct axi_dmac_init	dmac_init;
+	struct axi_dmac_init	dmac_init = {0};
 
 	eng_desc = desc->extra;
 
+	if (eng_desc->stream.active)
+		return -EBUSY;
+
 	eng_desc->offload_config = param->offload_config;
 
 	if(!(param->dma_flags)) {
@@ -775,14 +973,27 @@ int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 	}
 
 
-	if(param->offload_config & OFFLOAD_TX_EN) {
+	dmac_init.irq_option = param->irq_option;
+
+	/* The DMACs are initialized only once, at the first call. Later calls
+	 * can't move them or change how their completion is reported */
+	if ((param->offload_config & OFFLOAD_TX_EN) && eng_desc->offload_tx_dma &&
+	    (eng_desc->offload_tx_dma->base != param->tx_dma_baseaddr ||
+	     eng_desc->offload_tx_dma->irq_option != param->irq_option))
+		return -EBUSY;
+	if ((param->offload_config & OFFLOAD_RX_EN) && eng_desc->offload_rx_dma &&
+	    (eng_desc->offload_rx_dma->base != param->rx_dma_baseaddr ||
+	     eng_desc->offload_rx_dma->irq_option != param->irq_option))
+		return -EBUSY;
+
+	if((param->offload_config & OFFLOAD_TX_EN) && !eng_desc->offload_tx_dma) {
 		dmac_init.name = "DAC DMAC";
 		dmac_init.base = param->tx_dma_baseaddr;
 		axi_dmac_init(&eng_desc->offload_tx_dma, &dmac_init);
 		if(!eng_desc->offload_tx_dma)
 			return -1;
 	}
-	if(param->offload_config & OFFLOAD_RX_EN) {
+	if((param->offload_config & OFFLOAD_RX_EN) && !eng_desc->offload_rx_dma) {
 		dmac_init.name = "ADC DMAC";
 		dmac_init.base = param->rx_dma_baseaddr;
 		axi_dmac_init(&eng_desc->offload_rx_dma, &dmac_init);
@@ -793,6 +1004,37 @@ int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Load an offload program into the offload module.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Offload message with the commands and the data sent by them
+ * @return int32_t - 0 if the program was loaded
+ *		   - negative error code if the program is invalid
+ */
+static int32_t spi_engine_offload_load(struct no_os_spi_desc *desc,
+				       const struct spi_engine_offload_message *msg)
+{
+	struct spi_engine_desc	*eng_desc;
+	int32_t			ret;
+
+	eng_desc = desc->extra;
+
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 1);
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 0);
+
+	ret = spi_engine_compile_message(desc, msg->commands, msg->no_commands,
+					 &eng_desc->msg);
+	if (ret)
+		return ret;
+
+	eng_desc->offload_tx_len = eng_desc->msg.length;
+	eng_desc->offload_rx_len = eng_desc->msg.nb_rx_words;
+
+	return spi_engine_transfer_message(desc, &eng_desc->msg,
+					   msg->commands_data, NULL);
+}
+
 /**
  * @brief Initiate a SPI transfer in offload mode
  *
@@ -805,10 +1047,9 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 				    struct spi_engine_offload_message msg,
 				    uint32_t no_samples)
 {
-	struct spi_engine_msg	transfer;
 	struct spi_engine_desc	*eng_desc;
-	uint32_t 		i;
 	uint8_t 		word_length;
+	int32_t			ret;
 
 	eng_desc = desc->extra;
 
@@ -817,29 +1058,13 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 	     (eng_desc->offload_config & OFFLOAD_RX_EN)))
 		return -1;
 
-	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 1);
-	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 0);
-
-	eng_desc->offload_tx_len = 0;
-	eng_desc->offload_rx_len = 0;
-
-	transfer.cmds = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*transfer.cmds));
-
-	if (!transfer.cmds)
-		return -1;
-
-	transfer.tx_buf = msg.commands_data;
+	if (eng_desc->stream.active)
+		return -EBUSY;
 
 	/* Load the commands into the message */
-	transfer.cmds->next = NULL;
-	transfer.cmds->cmd = msg.commands[0];
-	i = 1;
-	while(i < msg.no_commands) {
-		spi_engine_queue_add_cmd(&transfer.cmds, msg.commands[i++]);
-
-	}
-
-	spi_engine_transfer_message(desc, &transfer);
+	ret = spi_engine_offload_load(desc, &msg);
+	if (ret)
+		return ret;
 
 	/* Start transfer */
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
@@ -876,11 +1101,159 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 		};
 		axi_dmac_transfer_start(eng_desc->offload_rx_dma, &rx_transfer);
 		axi_dmac_transfer_wait_completion(eng_desc->offload_rx_dma, 500);
+
+		return 0;
 	}
 
 	usleep(1000);
 
-	spi_engine_queue_no_os_free(&transfer.cmds);
+	return 0;
+}
+
+/**
+ * @brief RX DMA interrupt callback used while streaming, called at the end of
+ * each buffer. The DMAC already writes the next buffer of the chain.
+ *
+ * @param ctx SPI descriptor
+ */
+static void spi_engine_offload_stream_done(void *ctx)
+{
+	struct no_os_spi_desc	*desc = ctx;
+	struct spi_engine_desc	*eng_desc;
+	uint32_t		done;
+
+	eng_desc = desc->extra;
+
+	if (!eng_desc->stream.active)
+		return;
+
+	done = eng_desc->stream.index;
+	eng_desc->stream.index = (done + 1) % eng_desc->stream.nb_buffers;
+
+	if (eng_desc->stream.complete)
+		eng_desc->stream.complete(eng_desc->stream.ctx, done);
+}
+
+/**
+ * @brief Start a continuous capture in offload mode. The offload program is
+ * loaded once and stays resident. The RX DMA fills the buffers in turn,
+ * following a cyclic scatter-gather chain, so the next buffer is already
+ * queued when one is filled and no sample is lost at the switch. Each filled
+ * buffer is reported by the complete callback, from the RX DMA interrupt, and
+ * is written again after the other buffers are filled.
+ * The RX DMAC has to support scatter-gather, be initialized with IRQ_ENABLED
+ * and have its interrupt handled by axi_dmac_dev_to_mem_isr().
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param param Streaming parameters
+ * @return int32_t - 0 if the capture was started
+ *		   - -EINVAL if the parameters are invalid, a buffer doesn't
+ *		     fit in a DMA descriptor or the RX offload is not
+ *		     initialized
+ *		   - -ENOTSUP if the RX DMAC has no scatter-gather support
+ *		   - -EBUSY if a capture is already running
+ *		   - negative error code if the program or the DMA transfer
+ *		     failed
+ */
+int32_t spi_engine_offload_stream_start(struct no_os_spi_desc *desc,
+					const struct spi_engine_offload_stream_param *param)
+{
+	struct spi_engine_desc	*eng_desc;
+	struct axi_dma_sg	*sg;
+	uint32_t		size;
+	uint32_t		i;
+	int32_t			ret;
+
+	if (!desc || !param || !param->msg || !param->buffers ||
+	    !param->descs || param->nb_buffers < 2 || !param->no_samples)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+
+	if (!(eng_desc->offload_config & OFFLOAD_RX_EN) ||
+	    !eng_desc->offload_rx_dma ||
+	    eng_desc->offload_rx_dma->irq_option != IRQ_ENABLED)
+		return -EINVAL;
+
+	if (!eng_desc->offload_rx_dma->hw_sg)
+		return -ENOTSUP;
+
+	if (eng_desc->stream.active)
+		return -EBUSY;
+
+	ret = spi_engine_offload_load(desc, param->msg);
+	if (ret)
+		return ret;
+
+	size = spi_get_word_lenght(eng_desc) * eng_desc->offload_rx_len *
+	       param->no_samples;
+
+	/* Only needed to build the descriptors */
+	sg = no_os_calloc(param->nb_buffers, sizeof(*sg));
+	if (!sg)
+		return -ENOMEM;
+
+	for (i = 0; i < param->nb_buffers; i++) {
+		sg[i].size = size;
+		sg[i].dest_addr = param->buffers[i];
+		sg[i].irq = true;
+	}
+
+	eng_desc->stream.sg.descs = param->descs;
+	eng_desc->stream.sg.nb_descs = param->nb_buffers;
+	eng_desc->stream.sg.cyclic = CYCLIC;
+	eng_desc->stream.sg.complete = spi_engine_offload_stream_done;
+	eng_desc->stream.sg.complete_ctx = desc;
+	ret = axi_dmac_sg_prepare(eng_desc->offload_rx_dma,
+				  &eng_desc->stream.sg, sg);
+	no_os_free(sg);
+	if (ret)
+		return ret;
+
+	eng_desc->stream.buffers = param->buffers;
+	eng_desc->stream.nb_buffers = param->nb_buffers;
+	eng_desc->stream.index = 0;
+	eng_desc->stream.size = size;
+	eng_desc->stream.complete = param->complete;
+	eng_desc->stream.ctx = param->ctx;
+	eng_desc->stream.active = true;
+
+	ret = axi_dmac_transfer_start_sg(eng_desc->offload_rx_dma,
+					 &eng_desc->stream.sg);
+	if (ret) {
+		eng_desc->stream.active = false;
+		return ret;
+	}
+
+	/* Start the offload program, it runs on every trigger */
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
+
+	return 0;
+}
+
+/**
+ * @brief Stop a capture started by spi_engine_offload_stream_start(). The
+ * buffer being filled is not reported.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @return int32_t - 0 if the capture was stopped
+ *		   - -EINVAL if no capture is running
+ */
+int32_t spi_engine_offload_stream_stop(struct no_os_spi_desc *desc)
+{
+	struct spi_engine_desc	*eng_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+
+	if (!eng_desc->stream.active)
+		return -EINVAL;
+
+	eng_desc->stream.active = false;
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+	axi_dmac_transfer_stop(eng_desc->offload_rx_dma);
 
 	return 0;
 }
@@ -897,9 +1270,13 @@ int32_t spi_engine_remove(struct no_os_spi_desc *desc)
 
 	eng_desc = desc->extra;
 
-	if(eng_desc->offload_config & OFFLOAD_TX_EN)
+	/*
+	 * offload_config is cleared by the plain transfers, the DMACs stay
+	 * allocated until here
+	 */
+	if (eng_desc->offload_tx_dma)
 		axi_dmac_remove(eng_desc->offload_tx_dma);
-	if(eng_desc->offload_config & OFFLOAD_RX_EN)
+	if (eng_desc->offload_rx_dma)
 		axi_dmac_remove(eng_desc->offload_rx_dma);
 	no_os_free(desc->extra);
 	no_os_free(desc);
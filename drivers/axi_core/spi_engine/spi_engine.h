@@ -100,6 +100,29 @@ struct spi_engine_init_param {
 };
 
 
+/**
+ * @struct spi_engine_offload_stream
+ * @brief  State of a continuous capture in offload mode
+ */
+struct spi_engine_offload_stream {
+	/** Addresses of the buffers filled by the RX DMA */
+	const uint32_t		*buffers;
+	/** Number of buffers */
+	uint32_t		nb_buffers;
+	/** Index of the buffer being filled */
+	volatile uint32_t	index;
+	/** Size of a buffer in bytes */
+	uint32_t		size;
+	/** Cyclic chain with one RX DMA descriptor for each buffer */
+	struct axi_dma_sg_transfer	sg;
+	/** Called each time a buffer is filled */
+	void			(*complete)(void *ctx, uint32_t index);
+	/** Parameter of complete */
+	void			*ctx;
+	/** Set while the capture is running */
+	volatile bool		active;
+};
+
 /**
  * @struct spi_engine_desc
  * @brief  Structure representing an SPI engine device
@@ -118,9 +141,9 @@ struct spi_engine_desc {
 	/** Offload's module transfer direction : TX, RX or both */
 	uint8_t			offload_config;
 	/** Number of words that the module has to send */
-	uint8_t			offload_tx_len;
+	uint32_t		offload_tx_len;
 	/** Number of words that the module has to receive */
-	uint8_t			offload_rx_len;
+	uint32_t		offload_rx_len;
 	/** Base address where the HDL core is situated */
 	uint32_t		spi_engine_baseaddr;
 	/** Base address where the RX DMAC core is situated */
@@ -135,6 +158,12 @@ struct spi_engine_desc {
 	uint8_t			data_width;
 	/** The maximum data width supported by the engine */
 	uint8_t 		max_data_width;
+	/** Message compiled by spi_engine_write_and_read() */
+	struct spi_engine_msg	msg;
+	/** Words sent and received by spi_engine_write_and_read() */
+	uint32_t		words[SPI_ENGINE_MAX_XFER_WORDS];
+	/** Continuous capture in offload mode */
+	struct spi_engine_offload_stream	stream;
 };
 
 
@@ -151,6 +180,9 @@ struct spi_engine_offload_init_param {
 	uint32_t	*dma_flags;
 	/** Offload's module transfer direction : TX, RX or both */
 	uint8_t		offload_config;
+	/** DMAC interrupt usage. Streaming needs IRQ_ENABLED and the RX DMAC
+	 * interrupt handled by axi_dmac_dev_to_mem_isr() */
+	enum use_irq	irq_option;
 };
 
 /**
@@ -173,6 +205,30 @@ struct spi_engine_offload_message {
 	uint32_t rx_addr;
 };
 
+/**
+ * @struct spi_engine_offload_stream_param
+ * @brief  Parameters of a continuous capture in offload mode
+ */
+struct spi_engine_offload_stream_param {
+	/** Offload program. The tx_addr and rx_addr fields are not used */
+	const struct spi_engine_offload_message *msg;
+	/** Addresses of the buffers filled in turn. Kept until the capture is
+	 * stopped */
+	const uint32_t	*buffers;
+	/** Number of buffers, at least 2 */
+	uint32_t	nb_buffers;
+	/** One RX DMA descriptor for each buffer, in memory read by the DMAC
+	 * (not cached or flushed on its own). Kept until the capture is stopped */
+	struct axi_dmac_hw_desc	*descs;
+	/** Number of program runs stored in each buffer */
+	uint32_t	no_samples;
+	/** Called from the RX DMA interrupt with the index of each filled
+	 * buffer. The buffer has to be read before it is filled again. Optional */
+	void		(*complete)(void *ctx, uint32_t index);
+	/** Parameter of complete */
+	void		*ctx;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -200,6 +256,23 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 				  uint8_t *data,
 				  uint16_t bytes_number);
 
+/* Transfer a list of SPI messages using the SPI engine */
+int32_t spi_engine_transfer(struct no_os_spi_desc *desc,
+			    struct no_os_spi_msg *msgs,
+			    uint32_t len);
+
+/* Compile SPI engine commands into a message that can be sent many times */
+int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
+				   const uint32_t *commands,
+				   uint32_t no_commands,
+				   struct spi_engine_msg *msg);
+
+/* Send a message built by spi_engine_compile_message() */
+int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
+				    const struct spi_engine_msg *msg,
+				    const uint32_t *tx_buf,
+				    uint32_t *rx_buf);
+
 /* Free the resources used by the SPI engine device */
 int32_t spi_engine_remove(struct no_os_spi_desc *desc);
 
@@ -212,6 +285,13 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 				    struct spi_engine_offload_message msg,
 				    uint32_t no_samples);
 
+/* Start a continuous capture in offload mode */
+int32_t spi_engine_offload_stream_start(struct no_os_spi_desc *desc,
+					const struct spi_engine_offload_stream_param *param);
+
+/* Stop a continuous capture in offload mode */
+int32_t spi_engine_offload_stream_stop(struct no_os_spi_desc *desc);
+
 /* Set SPI transfer width */
 int32_t spi_engine_set_transfer_width(struct no_os_spi_desc *desc,
 				      uint8_t data_wdith);
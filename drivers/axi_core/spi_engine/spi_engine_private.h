@@ -108,6 +108,11 @@
 #define SPI_ENGINE_REG_OFFLOAD_CMD_MEM(x)	(0x110 + (0x20 * x))
 #define SPI_ENGINE_REG_OFFLOAD_SDO_MEM(x)	(0x114 + (0x20 * x))
 
+/* Maximum number of instructions of a compiled message */
+#define SPI_ENGINE_MSG_MAX_CMDS			32
+/* Maximum number of words of a transfer instruction */
+#define SPI_ENGINE_MAX_XFER_WORDS		256
+
 #define SPI_ENGINE_CMD(inst, arg1, arg2) 				\
 			(((inst & 0x03) << 12) | 			\
 			((arg1 & 0x03) << 8) | arg2 )
@@ -138,16 +143,22 @@
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
-typedef struct spi_engine_cmd_queue {
-	uint32_t	cmd;
-	struct		spi_engine_cmd_queue *next;
-} spi_engine_cmd_queue;
-
+/**
+ * @struct spi_engine_msg
+ * @brief  Engine instructions compiled from SPI engine commands. The final
+ * SYNC instruction is added when the message is sent.
+ */
 typedef struct spi_engine_msg {
-	uint32_t			*tx_buf;
-	uint32_t			*rx_buf;
+	/** Instructions, ready to be written in the command FIFO */
+	uint32_t			cmds[SPI_ENGINE_MSG_MAX_CMDS];
+	/** Number of instructions */
+	uint32_t			nb_cmds;
+	/** Number of words of all the transfers */
 	uint32_t			length;
-	struct spi_engine_cmd_queue	*cmds;
+	/** Number of words written on SDO */
+	uint32_t			nb_tx_words;
+	/** Number of words read from SDI */
+	uint32_t			nb_rx_words;
 } spi_engine_msg;
 
 #endif // SPI_ENGINE_PRIVATE_H
@@ -49,6 +49,7 @@
 #include "no_os_print_log.h"
 #include "no_os_spi.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
 #include "stdbool.h"
 #include "stdio.h"
 #include "stdlib.h"
@@ -62,23 +63,7 @@
 static uint8_t ad5758_compute_crc8(uint8_t *data,
 				   uint8_t data_size)
 {
-	uint8_t i;
-	uint8_t crc = 0;
-
-	while (data_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
-				crc <<= 1;
-				crc ^= AD5758_CRC8_POLY;
-			} else {
-				crc <<= 1;
-			}
-		}
-		data++;
-		data_size--;
-	}
-
-	return crc;
+	return no_os_crc8(no_os_crc8_msb_07_table, data, data_size, 0);
 }
 
 /**
@@ -51,7 +51,6 @@
 #include "no_os_crc16.h"
 #include "no_os_print_log.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ade9113_crc8);
 NO_OS_DECLARE_CRC16_TABLE(ade9113_crc16);
 
 /******************************************************************************/
@@ -96,7 +95,7 @@ int ade9113_read(struct ade9113_dev *dev, uint8_t reg_addr, uint8_t *reg_data,
 	buff[13] = reg_addr;
 
 	/* compute CRC and add it to command */
-	crc8 = no_os_crc8(ade9113_crc8, &buff[12], 3, 0);
+	crc8 = no_os_crc8(no_os_crc8_msb_07_table, &buff[12], 3, 0);
 	crc8 ^= 0x55;
 	buff[15] = crc8;
 	no_of_read_bytes = 6;
@@ -124,7 +123,7 @@ int ade9113_read(struct ade9113_dev *dev, uint8_t reg_addr, uint8_t *reg_data,
 		buff[12] = ADE9113_OP_MODE_LONG | buff[12];
 
 	/* compute CRC and add it to command if CRC enabled */
-	crc8 = no_os_crc8(ade9113_crc8, &buff[12], 3, 0);
+	crc8 = no_os_crc8(no_os_crc8_msb_07_table, &buff[12], 3, 0);
 	crc8 ^= 0x55;
 	buff[15] = crc8;
 
@@ -181,7 +180,7 @@ int ade9113_write(struct ade9113_dev *dev, uint8_t reg_addr, uint8_t reg_data,
 	buff[1] = reg_addr;
 	buff[2] = reg_data;
 
-	crc = no_os_crc8(ade9113_crc8, buff, 3, 0);
+	crc = no_os_crc8(no_os_crc8_msb_07_table, buff, 3, 0);
 	crc ^= 0x55;
 	buff[3] = crc;
 
@@ -319,10 +318,7 @@ int ade9113_init(struct ade9113_dev **device,
 			goto error_gpio;
 	}
 
-	/* Create the CRC-8 lookup table for polynomial ADE9113_CRC8_POLY */
-	no_os_crc8_populate_msb(ade9113_crc8, ADE9113_CRC8_POLY);
-
-	/* Create the CRC-16 lookup table for polynomial ADE9113_CRC8_POLY */
+	/* Create the CRC-16 lookup table for polynomial ADE9113_CRC16_POLY */
 	no_os_crc16_populate_msb(ade9113_crc16, ADE9113_CRC16_POLY);
 
 	/* CRC enabled by default */
@@ -52,7 +52,7 @@
 #include "no_os_error.h"
 #include "no_os_gpio.h"
 #include "no_os_irq.h"
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
@@ -68,21 +68,17 @@
  */
 static void aducm_gpio_callback(void *ctx, uint32_t event, void *pins)
 {
-	int ret;
+	uint32_t irq_id;
 	struct irq_action *action;
-	struct irq_action key;
 	struct aducm_gpio_irq_ctrl_desc *extra = ctx;
 	uint16_t *pinints = pins;
 
 	while (*pinints) {
-		key.irq_id = no_os_find_first_set_bit((uint32_t)*pinints);
-		if (key.irq_id == 32)
+		irq_id = no_os_find_first_set_bit((uint32_t)*pinints);
+		if (irq_id == 32)
 			break;
-		*pinints &= ~NO_OS_BIT(key.irq_id);
-		ret = no_os_list_read_find(extra->actions, (void **)&action, &key);
-		if (ret)
-			continue;
-
+		*pinints &= ~NO_OS_BIT(irq_id);
+		action = aducm_irq_action_find(&extra->actions, irq_id);
 		if (action)
 			action->callback(action->ctx);
 	}
@@ -96,16 +92,10 @@ static void aducm_gpio_callback(void *ctx, uint32_t event, void *pins)
  */
 static void aducm_xint_callback(void *ctx, uint32_t event, void *buff)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
 	struct aducm_gpio_irq_ctrl_desc *extra = ctx;
 
-	key.irq_id = event;
-	ret = no_os_list_read_find(extra->actions, (void **)&action, &key);
-	if (ret)
-		return;
-
+	action = aducm_irq_action_find(&extra->actions, event);
 	if (action)
 		action->callback(action->ctx);
 }
@@ -119,7 +109,7 @@ static void aducm_xint_callback(void *ctx, uint32_t event, void *buff)
 static int aducm_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 				    const struct no_os_irq_init_param *param)
 {
-	int ret;
+	int ret = -EINVAL;
 	struct no_os_irq_ctrl_desc *descriptor;
 	struct aducm_gpio_irq_ctrl_desc *extra;
 
@@ -131,16 +121,15 @@ static int aducm_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 		return -ENOMEM;
 
 	extra = no_os_calloc(1, sizeof(*extra));
-	if (!extra)
+	if (!extra) {
+		ret = -ENOMEM;
 		goto error_dev;
+	}
 
 	descriptor->irq_ctrl_id = param->irq_ctrl_id;
 	descriptor->extra = extra;
 
-	ret = no_os_list_init(&extra->actions, NO_OS_LIST_PRIORITY_LIST,
-			      irq_action_cmp);
-	if (ret)
-		goto error_extra;
+	no_os_ilist_init(&extra->actions);
 
 	switch (descriptor->irq_ctrl_id) {
 	case ADUCM_XINT_SOFT_CTRL:
@@ -186,12 +175,14 @@ error_dev:
  */
 static int aducm_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	struct irq_action *discard;
-	struct aducm_gpio_irq_ctrl_desc *extra = desc->extra;
+	struct no_os_ilist_node *node;
+	struct aducm_gpio_irq_ctrl_desc *extra;
 
 	if (!desc)
 		return -EINVAL;
 
+	extra = desc->extra;
+
 	switch (desc->irq_ctrl_id) {
 	case ADUCM_XINT_SOFT_CTRL:
 		for (int i = ADI_XINT_EVENT_INT0; i < ADI_XINT_EVENT_RESERVED; i++)
@@ -211,10 +202,9 @@ static int aducm_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 		return -EINVAL;
 	}
 
-	while (0 == no_os_list_get_last(extra->actions, (void **)&discard))
-		no_os_free(discard);
+	while ((node = no_os_ilist_get_first(&extra->actions)))
+		no_os_free(no_os_ilist_entry(node, struct irq_action, node));
 
-	no_os_list_remove(extra->actions);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -233,9 +223,8 @@ static int aducm_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		uint32_t irq_id,
 		struct no_os_callback_desc *callback_desc)
 {
-	int ret, stat;
+	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 	struct aducm_gpio_irq_ctrl_desc *extra = desc->extra;
 	uint16_t gpio_pin;
 	uint8_t gpio_port = PORT(irq_id);
@@ -246,11 +235,11 @@ static int aducm_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	if (!desc || !callback_desc)
 		return -EINVAL;
 
-	ret = no_os_list_read_find(extra->actions, (void **)&action, &action_key);
+	action = aducm_irq_action_find(&extra->actions, irq_id);
 	/*
 	* If no action was found, insert a new one, otherwise update it
 	*/
-	if (ret) {
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
@@ -260,17 +249,15 @@ static int aducm_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		action->ctx = callback_desc->ctx;
 		action->callback = callback_desc->callback;
 
-		stat = no_os_list_add_last(extra->actions, action);
-		if (stat)
-			goto free_action;
+		no_os_ilist_add_last(&extra->actions, &action->node);
 
 		if (desc->irq_ctrl_id != ADUCM_XINT_SOFT_CTRL) {
-			stat = adi_gpio_GetGroupInterruptPins(gpio_port, id, &gpio_pin);
-			if (stat)
+			ret = adi_gpio_GetGroupInterruptPins(gpio_port, id, &gpio_pin);
+			if (ret)
 				goto free_action;
 			gpio_pin |= PIN(irq_id);
-			stat = adi_gpio_SetGroupInterruptPins(gpio_port, id, gpio_pin);
-			if (stat)
+			ret = adi_gpio_SetGroupInterruptPins(gpio_port, id, gpio_pin);
+			if (ret)
 				goto free_action;
 		}
 	} else {
@@ -283,6 +270,7 @@ static int aducm_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	return 0;
 
 free_action:
+	no_os_ilist_del(&action->node);
 	no_os_free(action);
 
 	return ret;
@@ -300,8 +288,7 @@ static int aducm_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		struct no_os_callback_desc *callback_desc)
 {
 	int ret;
-	struct irq_action *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = irq_id};
+	struct irq_action *discard_action;
 	struct aducm_gpio_irq_ctrl_desc *extra = desc->extra;
 	uint16_t gpio_pin;
 	uint8_t gpio_port = PORT(irq_id);
@@ -312,9 +299,8 @@ static int aducm_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 	if (!desc || !callback_desc)
 		return -EINVAL;
 
-	ret = no_os_list_get_find(extra->actions, (void **)&discard_action,
-				  &action_key);
-	if (ret)
+	discard_action = aducm_irq_action_find(&extra->actions, irq_id);
+	if (!discard_action)
 		return -ENODEV;
 
 	if (desc->irq_ctrl_id != ADUCM_XINT_SOFT_CTRL) {
@@ -327,6 +313,7 @@ static int aducm_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 			return ret;
 	}
 
+	no_os_ilist_del(&discard_action->node);
 	no_os_free(discard_action);
 
 	return 0;
@@ -345,7 +332,6 @@ static int aducm_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
 {
 	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 	struct aducm_gpio_irq_ctrl_desc *extra = desc->extra;
 	uint16_t gpio_pin;
 	uint8_t gpio_port = PORT(irq_id);
@@ -353,8 +339,8 @@ static int aducm_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
 	if (!desc)
 		return -EINVAL;
 
-	ret = no_os_list_read_find(extra->actions, (void **)&action, &action_key);
-	if (ret)
+	action = aducm_irq_action_find(&extra->actions, irq_id);
+	if (!action)
 		return -ENODEV;
 
 	if (desc->irq_ctrl_id != ADUCM_XINT_SOFT_CTRL) {
@@ -386,9 +372,7 @@ static int aducm_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
 static int aducm_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc,
 				 uint32_t irq_id)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 	struct aducm_gpio_irq_ctrl_desc *extra = desc->extra;
 	int8_t id = (desc->irq_ctrl_id == ADUCM_GPIO_A_GROUP_SOFT_CTRL) ?
 		    ADI_GPIO_INTA_IRQ :
@@ -401,9 +385,8 @@ static int aducm_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc,
 		if(irq_id > ADI_XINT_EVENT_INT3)
 			return -EINVAL;
 
-		ret = no_os_list_read_find(extra->actions, (void **)&action,
-					   &action_key);
-		if (ret)
+		action = aducm_irq_action_find(&extra->actions, irq_id);
+		if (!action)
 			return -ENODEV;
 
 		switch(action->trig_lv) {
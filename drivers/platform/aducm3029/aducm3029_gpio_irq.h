@@ -41,6 +41,7 @@
 #define GPIO_IRQ_EXTRA_H
 
 #include <drivers/xint/adi_xint.h>
+#include "no_os_ilist.h"
 
 /******************************************************************************/
 /***************************** Include Files **********************************/
@@ -63,7 +64,7 @@ struct aducm_gpio_irq_ctrl_desc {
 	/** Memory needed by the ADI IRQ driver */
 	uint8_t irq_memory[ADI_XINT_MEMORY_SIZE];
 	/** List of user callbacks */
-	struct no_os_list_desc *actions;
+	struct no_os_ilist_node actions;
 };
 
 /**
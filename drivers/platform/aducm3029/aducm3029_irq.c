@@ -55,7 +55,7 @@
 #include "no_os_timer.h"
 #include "aducm3029_timer.h"
 #include "no_os_util.h"
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_alloc.h"
 
 /******************************************************************************/
@@ -72,15 +72,24 @@
 #define NB_INTERRUPT_CONTROLLERS	1u
 
 /**
- * @brief Action comparator function
- * @param data1 - List element
- * @param data2 - Key
- * @return 0 if the two are equal, any other integer otherwise
+ * @brief Find the action registered for an interrupt
+ * @param actions - Head of the action list
+ * @param irq_id - Interrupt identifier
+ * @return The action, or NULL if none is registered for irq_id
  */
-int32_t irq_action_cmp(void *data1, void *data2)
+struct irq_action *aducm_irq_action_find(struct no_os_ilist_node *actions,
+		uint32_t irq_id)
 {
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
+	struct no_os_ilist_node *node;
+	struct irq_action *action;
+
+	no_os_ilist_for_each(node, actions) {
+		action = no_os_ilist_entry(node, struct irq_action, node);
+		if (action->irq_id == irq_id)
+			return action;
+	}
+
+	return NULL;
 }
 
 /**
@@ -88,19 +97,42 @@ int32_t irq_action_cmp(void *data1, void *data2)
  */
 struct event_list {
 	enum no_os_irq_event event;
-	struct no_os_list_desc *actions;
+	struct no_os_ilist_node actions;
 	uint32_t hal_event;
 };
 
+#define ADUCM_IRQ_EVENT(_event, _hal_event) \
+	[_event] = { \
+		.event = _event, \
+		.actions = NO_OS_ILIST_HEAD_INIT(_events[_event].actions), \
+		.hal_event = _hal_event \
+	}
+
 static struct event_list _events[] = {
-	[NO_OS_EVT_GPIO] = {.event = NO_OS_EVT_GPIO},
-	[NO_OS_EVT_UART_TX_COMPLETE] = {.event = NO_OS_EVT_UART_TX_COMPLETE, .hal_event = UART_EVT_IRQn},
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE, .hal_event = UART_EVT_IRQn},
-	[NO_OS_EVT_UART_ERROR] = {.event = NO_OS_EVT_UART_ERROR, .hal_event = UART_EVT_IRQn},
-	[NO_OS_EVT_RTC] {.event = NO_OS_EVT_RTC},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED, .hal_event = TMR1_EVT_IRQn},
+	ADUCM_IRQ_EVENT(NO_OS_EVT_GPIO, 0),
+	ADUCM_IRQ_EVENT(NO_OS_EVT_UART_TX_COMPLETE, UART_EVT_IRQn),
+	ADUCM_IRQ_EVENT(NO_OS_EVT_UART_RX_COMPLETE, UART_EVT_IRQn),
+	ADUCM_IRQ_EVENT(NO_OS_EVT_UART_ERROR, UART_EVT_IRQn),
+	ADUCM_IRQ_EVENT(NO_OS_EVT_RTC, 0),
+	ADUCM_IRQ_EVENT(NO_OS_EVT_TIM_ELAPSED, TMR1_EVT_IRQn),
 };
 
+/**
+ * @brief Get the action registered for an event
+ * @param event - Event identifier
+ * @return The last registered action, or NULL if there is none
+ */
+static struct irq_action *aducm_irq_event_action(uint32_t event)
+{
+	struct no_os_ilist_node *node;
+
+	node = no_os_ilist_last(&_events[event].actions);
+	if (!node)
+		return NULL;
+
+	return no_os_ilist_entry(node, struct irq_action, node);
+}
+
 /**
  * @brief Call the user defined callback when a read/write operation completed.
  * @param ctx:		ADuCM3029 specific descriptor for the UART device
@@ -127,8 +159,7 @@ static void aducm_uart_callback(void *ctx, uint32_t event, void *buff)
 			extra->read_desc.buff += len;
 		} else {
 			extra->read_desc.is_nonblocking = false;
-			no_os_list_read_last(_events[NO_OS_EVT_UART_RX_COMPLETE].actions,
-					     (void **)&action);
+			action = aducm_irq_event_action(NO_OS_EVT_UART_RX_COMPLETE);
 			if (action)
 				action->callback(action->ctx);
 		}
@@ -146,8 +177,7 @@ static void aducm_uart_callback(void *ctx, uint32_t event, void *buff)
 			extra->write_desc.buff += len;
 		} else {
 			extra->write_desc.is_nonblocking = false;
-			no_os_list_read_last(_events[NO_OS_EVT_UART_TX_COMPLETE].actions,
-					     (void **)&action);
+			action = aducm_irq_event_action(NO_OS_EVT_UART_TX_COMPLETE);
 			if (action)
 				action->callback(action->ctx);
 		}
@@ -156,8 +186,7 @@ static void aducm_uart_callback(void *ctx, uint32_t event, void *buff)
 		extra->errors |= (uint32_t)buff;
 		extra->read_desc.is_nonblocking = false;
 		extra->write_desc.is_nonblocking = false;
-		no_os_list_read_last(_events[NO_OS_EVT_UART_ERROR].actions,
-				     (void **)&action);
+		action = aducm_irq_event_action(NO_OS_EVT_UART_ERROR);
 		if (action)
 			action->callback(action->ctx);
 		break;
@@ -174,8 +203,7 @@ static void aducm_rtc_callback(void *ctx, uint32_t event, void *buff)
 {
 	struct irq_action *action;
 
-	no_os_list_read_last(_events[NO_OS_EVT_RTC].actions,
-			     (void **)&action);
+	action = aducm_irq_event_action(NO_OS_EVT_RTC);
 	if (action)
 		action->callback(action->ctx);
 }
@@ -190,8 +218,7 @@ static void aducm_timer_callback(void *ctx, uint32_t event, void *buff)
 {
 	struct irq_action *action;
 	if (event == ADI_TMR_EVENT_TIMEOUT) {
-		no_os_list_read_last(_events[NO_OS_EVT_TIM_ELAPSED].actions,
-				     (void **)&action);
+		action = aducm_irq_event_action(NO_OS_EVT_TIM_ELAPSED);
 		if (action)
 			action->callback(action->ctx);
 	}
@@ -269,7 +296,6 @@ int32_t aducm3029_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	struct aducm_rtc_desc		*rtc_extra;
 	struct no_os_timer_desc			*timer_desc;
 	struct aducm_timer_desc		*timer_extra;
-	int32_t				ret;
 	struct irq_action	*action;
 	int32_t i;
 
@@ -283,45 +309,25 @@ int32_t aducm3029_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	case ADUCM_UART_INT_ID:
 		aducm_uart = callback_desc->handle;
 		for (i = NO_OS_EVT_UART_TX_COMPLETE; i <= NO_OS_EVT_UART_ERROR; i++)
-			if (!no_os_list_get_last(_events[callback_desc->event].actions,
-						 (void **)&action))
+			if (!no_os_ilist_empty(&_events[i].actions))
 				break;
 		if (i > NO_OS_EVT_UART_ERROR)
 			adi_uart_RegisterCallback(aducm_uart->uart_handler,
 						  aducm_uart_callback, callback_desc->handle);
 
-		if (_events[callback_desc->event].actions == NULL) {
-			ret = no_os_list_init(&_events[callback_desc->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
-		}
-
 		break;
 	case ADUCM_RTC_INT_ID:
 		rtc_desc = callback_desc->handle;
 		rtc_extra = rtc_desc->extra;
-		if (_events[callback_desc->event].actions == NULL) {
-			ret = no_os_list_init(&_events[callback_desc->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
+		if (no_os_ilist_empty(&_events[callback_desc->event].actions))
 			adi_rtc_RegisterCallback(rtc_extra->instance, aducm_rtc_callback,
 						 callback_desc->handle);
-		}
 
 		break;
 	case ADUCM_TIMER1_INT_ID:
 		timer_desc = callback_desc->handle;
 		timer_extra = timer_desc->extra;
-		if (_events[callback_desc->event].actions == NULL) {
-			ret = no_os_list_init(&_events[callback_desc->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
+		if (no_os_ilist_empty(&_events[callback_desc->event].actions)) {
 			/* Init function is called again to register the needed callback.
 			   This implementation can be changed in the future if adi_tmr_RegisterCallback will be available. */
 			adi_tmr_Init(timer_desc->id, aducm_timer_callback, callback_desc->handle,
@@ -337,34 +343,22 @@ int32_t aducm3029_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		return -1;
 	}
 
-	ret = no_os_list_read_last(_events[callback_desc->event].actions,
-				   (void **)&action);
-	if (ret) {
+	action = aducm_irq_event_action(callback_desc->event);
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
 
-		action->irq_id = callback_desc->event;
-		action->handle = callback_desc->handle;
-		action->callback = callback_desc->callback;
-		action->ctx = callback_desc->ctx;
-
-		ret = no_os_list_add_last(_events[callback_desc->event].actions,
-					  action);
-		if (ret)
-			goto free_action;
-	} else {
-		action->irq_id = callback_desc->event;
-		action->handle = callback_desc->handle;
-		action->callback = callback_desc->callback;
-		action->ctx = callback_desc->ctx;
+		no_os_ilist_add_last(&_events[callback_desc->event].actions,
+				     &action->node);
 	}
 
-	return 0;
-free_action:
-	no_os_free(action);
+	action->irq_id = callback_desc->event;
+	action->handle = callback_desc->handle;
+	action->callback = callback_desc->callback;
+	action->ctx = callback_desc->ctx;
 
-	return ret;
+	return 0;
 }
 
 /**
@@ -377,28 +371,25 @@ free_action:
 int32_t aducm3029_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	struct irq_action			*action;
-	uint32_t					ret;
+	struct no_os_ilist_node			*node;
 	int i;
 	struct no_os_aducm_uart_desc	*aducm_uart;
 
-	if (!desc || !desc->extra || irq_id >= NB_INTERRUPTS)
+	if (!desc || !desc->extra || irq_id >= NB_INTERRUPTS || !cb)
 		return -1;
 
-	aducm_uart = cb->handle;
-
-	ret = no_os_list_get_last(_events[cb->event].actions, (void **)&action);
-	if (ret)
-		return ret;
+	node = no_os_ilist_get_last(&_events[cb->event].actions);
+	if (!node)
+		return -1;
 
-	ret = no_os_list_remove(_events[cb->event].actions);
-	if (ret)
-		return ret;
+	no_os_free(no_os_ilist_entry(node, struct irq_action, node));
 
-	_events[cb->event].actions = NULL;
+	if (irq_id != ADUCM_UART_INT_ID)
+		return 0;
 
+	aducm_uart = cb->handle;
 	for (i = NO_OS_EVT_UART_TX_COMPLETE; i <= NO_OS_EVT_UART_ERROR; i++)
-		if (!no_os_list_get_last(_events[cb->event].actions, (void **)&action))
+		if (!no_os_ilist_empty(&_events[i].actions))
 			break;
 	if (i > NO_OS_EVT_UART_ERROR)
 		adi_uart_RegisterCallback(aducm_uart->uart_handler, NULL, NULL);
@@ -461,7 +452,6 @@ int32_t aducm3029_irq_enable(struct no_os_irq_ctrl_desc *desc,
 	struct no_os_rtc_desc		*rtc_desc;
 	struct aducm_rtc_desc		*aducm_rtc;
 	struct irq_action			*action;
-	int32_t						ret;
 
 	if (!desc || !desc->extra || irq_id >= NB_INTERRUPTS)
 		return -1;
@@ -471,10 +461,9 @@ int32_t aducm3029_irq_enable(struct no_os_irq_ctrl_desc *desc,
 		NVIC_EnableIRQ(UART_EVT_IRQn);
 		break;
 	case ADUCM_RTC_INT_ID:
-		ret = no_os_list_read_last(_events[NO_OS_EVT_RTC].actions,
-					   (void **)&action);
-		if (ret)
-			return ret;
+		action = aducm_irq_event_action(NO_OS_EVT_RTC);
+		if (!action)
+			return -1;
 
 		rtc_desc = action->handle;
 		aducm_rtc = rtc_desc->extra;
@@ -503,7 +492,6 @@ int32_t aducm3029_irq_disable(struct no_os_irq_ctrl_desc *desc,
 	struct no_os_rtc_desc		*rtc_desc;
 	struct aducm_rtc_desc		*aducm_rtc;
 	struct irq_action			*action;
-	int32_t						ret;
 
 	if (!desc || !desc->extra || irq_id >= NB_INTERRUPTS)
 		return -1;
@@ -513,10 +501,9 @@ int32_t aducm3029_irq_disable(struct no_os_irq_ctrl_desc *desc,
 		NVIC_DisableIRQ(UART_EVT_IRQn);
 		break;
 	case ADUCM_RTC_INT_ID:
-		ret = no_os_list_read_last(_events[NO_OS_EVT_RTC].actions,
-					   (void **)&action);
-		if (ret)
-			return ret;
+		action = aducm_irq_event_action(NO_OS_EVT_RTC);
+		if (!action)
+			return -1;
 
 		rtc_desc = action->handle;
 		aducm_rtc = rtc_desc->extra;
@@ -48,6 +48,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "no_os_irq.h"
+#include "no_os_ilist.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -121,6 +122,8 @@ extern const struct no_os_irq_platform_ops aducm_irq_ops;
  * @brief Struct used to store a (peripheral, callback) pair
  */
 struct irq_action {
+	/** Link in the action list */
+	struct no_os_ilist_node node;
 	/** Interrupt event */
 	uint32_t irq_id;
 	/** Peripheral handler */
@@ -134,7 +137,8 @@ struct irq_action {
 	enum no_os_irq_trig_level trig_lv;
 };
 
-/** Action comparator function */
-int32_t irq_action_cmp(void *data1, void *data2);
+/** Find the action registered for an interrupt */
+struct irq_action *aducm_irq_action_find(struct no_os_ilist_node *actions,
+		uint32_t irq_id);
 
 #endif // ADUCM3029_IRQ_H
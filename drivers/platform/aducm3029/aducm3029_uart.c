@@ -90,7 +90,7 @@ static uint8_t c;
 void uart_rx_callback(void *context)
 {
 	struct no_os_uart_desc *d = context;
-	lf256fifo_write(d->rx_fifo, c);
+	no_os_spsc_ring_write(d->rx_fifo, &c, 1);
 	no_os_uart_read_nonblocking(d, &c, 1);
 }
 
@@ -172,12 +172,8 @@ static int32_t aducm3029_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	}
 
 	if (desc->rx_fifo) {
-		for (idx = 0; idx < bytes_number; idx++) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[idx]);
-			if (ret)
-				return idx ? idx : -EAGAIN;
-		}
-		return idx;
+		idx = no_os_spsc_ring_read(desc->rx_fifo, data, bytes_number);
+		return idx ? idx : -EAGAIN;
 	}
 
 	/* Wait until a previously aducm3029_uart_read_nonblocking ends */
@@ -406,7 +402,8 @@ static int32_t aducm3029_uart_init(struct no_os_uart_desc **desc,
 
 	// nonblocking uart_read
 	if(param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = no_os_spsc_ring_init(&descriptor->rx_fifo, 1,
+					   NO_OS_UART_RX_FIFO_SIZE);
 		if (ret < 0)
 			goto failure;
 
@@ -448,7 +445,7 @@ error_register:
 error_nvic:
 	no_os_irq_ctrl_remove(aducm_desc->nvic);
 error_fifo:
-	lf256fifo_remove(descriptor->rx_fifo);
+	no_os_spsc_ring_remove(descriptor->rx_fifo);
 failure:
 	free_desc_mem(descriptor);
 	*desc = NULL;
@@ -472,7 +469,7 @@ static int32_t aducm3029_uart_remove(struct no_os_uart_desc *desc)
 	aducm_desc = desc->extra;
 	if (desc->rx_fifo) {
 		no_os_irq_disable(aducm_desc->nvic, desc->irq_id);
-		lf256fifo_remove(desc->rx_fifo);
+		no_os_spsc_ring_remove(desc->rx_fifo);
 		desc->rx_fifo = NULL;
 		no_os_irq_unregister_callback(aducm_desc->nvic, desc->irq_id,
 					      &aducm_desc->rx_callback);
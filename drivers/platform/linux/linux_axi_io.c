@@ -1,6 +1,6 @@
 /***************************************************************************//**
  *   @file   linux/linux_axi_io.c
- *   @brief  Implementation of AXI IO through UIO/devmem.
+ *   @brief  Implementation of AXI IO through persistent UIO/devmem mappings.
  *   @author Dragos Bogdan (dragos.bogdan@analog.com)
 ********************************************************************************
  * Copyright 2020(c) Analog Devices, Inc.
@@ -42,123 +42,350 @@
 /******************************************************************************/
 #include <fcntl.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include "no_os_error.h"
+#include "no_os_util.h"
 #include "no_os_axi_io.h"
+#include "linux_axi_io.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_axi_io_window
+ * @brief Register window kept mapped between accesses.
+ */
+struct linux_axi_io_window {
+	/** Slot in use */
+	bool used;
+	/** UIO index (/dev/uioX) or physical base address (DEVMEM) */
+	uint32_t base;
+	/** Number of bytes accessible starting from regs */
+	uint32_t size;
+	/** /dev/uioX or /dev/mem file descriptor */
+	int fd;
+	/** Address returned by mmap() */
+	void *map;
+	/** Length passed to mmap() */
+	size_t map_len;
+	/** Address of the first register of the window */
+	volatile uint8_t *regs;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+static struct linux_axi_io_window windows[LINUX_AXI_IO_MAX_MAPS];
+
+/*
+ * Protects windows[] and the accesses through them. A window may be unmapped
+ * to grow it, so no thread (e.g. the linux_irq and linux_dma handlers) may
+ * use the old mapping meanwhile.
+ */
+static pthread_mutex_t windows_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+#ifndef DEVMEM
 /**
- * @brief AXI IO through UIO read/write function.
+ * @brief Get the size of the first memory map exported by an UIO device.
  * @param base - UIO index (/dev/uioX).
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return Size in bytes, 0 if it cannot be determined.
  */
-static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-			      uint32_t *write)
+static uint32_t uio_get_map_size(uint32_t base)
 {
-	char buf[32];
+	char path[64];
+	unsigned long size;
+	FILE *f;
 	int ret;
-	int uio_fd;
-	int32_t status = 0;
-	void *uio_addr;
 
-	sprintf(buf, "/dev/uio%"PRIu32"", base);
+	snprintf(path, sizeof(path), "/sys/class/uio/uio%"PRIu32"/maps/map0/size",
+		 base);
 
-	uio_fd = open(buf, O_RDWR);
-	if (uio_fd < 0) {
-		printf("%s: Can't open %s\n\r", __func__, buf);
-		return -1;
+	f = fopen(path, "r");
+	if (!f)
+		return 0;
+
+	ret = fscanf(f, "%lx", &size);
+	fclose(f);
+	if (ret != 1)
+		return 0;
+
+	return size;
+}
+#endif
+
+/**
+ * @brief Map a register window through UIO or /dev/mem.
+ * @param win - Window to be filled.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Minimum number of bytes to be mapped, 0 for the default size.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t window_open(struct linux_axi_io_window *win, uint32_t base,
+			   uint32_t size)
+{
+	long page_size = sysconf(_SC_PAGESIZE);
+	uint32_t delta = 0;
+	off_t map_offset = 0;
+	char path[32];
+
+#ifdef DEVMEM
+	if (!size)
+		size = LINUX_AXI_IO_DEFAULT_SIZE;
+	delta = base & (page_size - 1);
+	map_offset = base - delta;
+	snprintf(path, sizeof(path), "/dev/mem");
+	win->fd = open(path, O_RDWR | O_SYNC);
+#else
+	size = no_os_max_t(uint32_t, size, uio_get_map_size(base));
+	if (!size)
+		size = page_size;
+	snprintf(path, sizeof(path), "/dev/uio%"PRIu32"", base);
+	win->fd = open(path, O_RDWR);
+#endif
+	if (win->fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		return -ENODEV;
 	}
 
-	uio_addr = mmap(NULL,
-			offset + sizeof(*read),
-			PROT_READ|PROT_WRITE,
-			MAP_SHARED,
-			uio_fd,
-			0);
-	if (uio_addr == MAP_FAILED) {
+	win->map_len = NO_OS_DIV_ROUND_UP(size + delta, page_size) * page_size;
+	win->map = mmap(NULL, win->map_len, PROT_READ | PROT_WRITE, MAP_SHARED,
+			win->fd, map_offset);
+	if (win->map == MAP_FAILED) {
 		printf("%s: mmap() failed\n\r", __func__);
-		status = -1;
-		goto close;
+		close(win->fd);
+		return -ENOMEM;
 	}
 
-	if (read)
-		*read = *(uint32_t *)((uintptr_t)uio_addr + offset);
-	if (write)
-		*(uint32_t *)((uintptr_t)uio_addr + offset) = *write;
+	win->regs = (volatile uint8_t *)win->map + delta;
+	win->size = win->map_len - delta;
+	win->base = base;
+	win->used = true;
 
-	ret = munmap(uio_addr, offset + sizeof(*read));
-	if (ret < 0) {
+	return 0;
+}
+
+/**
+ * @brief Unmap a register window.
+ * @param win - Window to be released.
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t window_close(struct linux_axi_io_window *win)
+{
+	int32_t status = 0;
+
+	if (!win->used)
+		return 0;
+
+	if (munmap(win->map, win->map_len) < 0) {
 		printf("%s: munmap() failed\n\r", __func__);
 		status = -1;
 	}
 
-close:
-	ret = close(uio_fd);
-	if (ret < 0) {
-		printf("%s: Can't close %s\n\r", __func__, buf);
+	if (close(win->fd) < 0) {
+		printf("%s: close() failed\n\r", __func__);
 		status = -1;
 	}
 
+	win->used = false;
+
 	return status;
 }
 
-#ifdef DEVMEM
 /**
- * @brief AXI IO through devmem read/write function.
- * @param base - Base address.
+ * @brief Find the cached window of a base.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @return The window, NULL if the base is not mapped.
+ */
+static struct linux_axi_io_window *window_find(uint32_t base)
+{
+	uint32_t i;
+
+	for (i = 0; i < LINUX_AXI_IO_MAX_MAPS; i++)
+		if (windows[i].used && windows[i].base == base)
+			return &windows[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Get a window covering [offset, offset + len), mapping or growing it
+ *        if needed. Must be called with windows_lock held.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @param len - Number of bytes to be accessed.
+ * @return The window, NULL in case of error.
  */
-static int32_t devmem_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-				 uint32_t *write)
+static struct linux_axi_io_window *window_get(uint32_t base, uint32_t offset,
+		uint32_t len)
 {
-	char command[64];
-	char answer[64];
-	FILE *stream;
-	int32_t ret;
-
-	if (write)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x w 0x%x", base + offset, *write);
-	else if (read)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x", base + offset);
-	else
-		return -1;
-
-	if (ret < 0 || ret >= (int32_t) sizeof(command))
-		return -1;
-
-	stream = popen(command, "r");
-	if (stream == NULL)
-		return -1;
-
-	if (!(fgets(answer, sizeof(answer), stream))) {
-		ret = -1;
-		goto close;
+	struct linux_axi_io_window *win;
+	uint32_t i;
+
+	/* The end of the window has to fit in the size of a mapping */
+	if ((uint64_t)offset + len > UINT32_MAX)
+		return NULL;
+
+	win = window_find(base);
+	if (win) {
+		if ((uint64_t)offset + len <= win->size)
+			return win;
+		if (window_close(win))
+			return NULL;
+		if (window_open(win, base, offset + len))
+			return NULL;
+		return win;
 	}
 
-	if (read)
-		*read = strtol(answer, NULL, 0);
+	for (i = 0; i < LINUX_AXI_IO_MAX_MAPS; i++)
+		if (!windows[i].used)
+			break;
+	if (i == LINUX_AXI_IO_MAX_MAPS) {
+		printf("%s: No free mapping slot\n\r", __func__);
+		return NULL;
+	}
 
-	ret = 0;
-close:
-	pclose(stream);
+	if (window_open(&windows[i], base, offset + len))
+		return NULL;
+
+	return &windows[i];
+}
+
+/**
+ * @brief Map a register window and keep it mapped until
+ *        linux_axi_io_unmap() or linux_axi_io_remove() is called.
+ *
+ * Calling this is optional, no_os_axi_io_read()/no_os_axi_io_write() map the
+ * window on first access. It is useful to map the whole register space of a
+ * core upfront instead of growing the mapping on demand.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param size - Size of the register window in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_map(uint32_t base, uint32_t size)
+{
+	struct linux_axi_io_window *win;
+
+	pthread_mutex_lock(&windows_lock);
+	win = window_get(base, 0, size);
+	pthread_mutex_unlock(&windows_lock);
+
+	return win ? 0 : -ENOMEM;
+}
+
+/**
+ * @brief Release the mapping of a register window.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_unmap(uint32_t base)
+{
+	struct linux_axi_io_window *win;
+	int32_t ret = -EINVAL;
+
+	pthread_mutex_lock(&windows_lock);
+	win = window_find(base);
+	if (win)
+		ret = window_close(win);
+	pthread_mutex_unlock(&windows_lock);
 
 	return ret;
 }
-#endif //DEVMEM
+
+/**
+ * @brief Release all the register windows.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_remove(void)
+{
+	int32_t status = 0;
+	uint32_t i;
+
+	pthread_mutex_lock(&windows_lock);
+	for (i = 0; i < LINUX_AXI_IO_MAX_MAPS; i++)
+		if (window_close(&windows[i]))
+			status = -1;
+	pthread_mutex_unlock(&windows_lock);
+
+	return status;
+}
+
+/**
+ * @brief Read consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Location where read data will be stored.
+ * @param count - Number of registers to be read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_read_block(uint32_t base, uint32_t offset,
+				uint32_t *data, uint32_t count)
+{
+	struct linux_axi_io_window *win;
+	volatile uint32_t *reg;
+	uint32_t i;
+
+	if (!data || count > UINT32_MAX / sizeof(*data))
+		return -EINVAL;
+
+	pthread_mutex_lock(&windows_lock);
+	win = window_get(base, offset, count * sizeof(*data));
+	if (!win) {
+		pthread_mutex_unlock(&windows_lock);
+		return -ENOMEM;
+	}
+
+	reg = (volatile uint32_t *)(win->regs + offset);
+	for (i = 0; i < count; i++)
+		data[i] = reg[i];
+	pthread_mutex_unlock(&windows_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Write consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Data to be written.
+ * @param count - Number of registers to be written.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_write_block(uint32_t base, uint32_t offset,
+				 const uint32_t *data, uint32_t count)
+{
+	struct linux_axi_io_window *win;
+	volatile uint32_t *reg;
+	uint32_t i;
+
+	if (!data || count > UINT32_MAX / sizeof(*data))
+		return -EINVAL;
+
+	pthread_mutex_lock(&windows_lock);
+	win = window_get(base, offset, count * sizeof(*data));
+	if (!win) {
+		pthread_mutex_unlock(&windows_lock);
+		return -ENOMEM;
+	}
+
+	reg = (volatile uint32_t *)(win->regs + offset);
+	for (i = 0; i < count; i++)
+		reg[i] = data[i];
+	pthread_mutex_unlock(&windows_lock);
+
+	return 0;
+}
+
 /**
  * @brief AXI IO through UIO/devmem read function.
  * @param base - UIO index (/dev/uioX)/base address.
@@ -168,25 +395,17 @@ close:
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, data, NULL);
-#else
-	return uio_read_write(base, offset, data, NULL);
-#endif
+	return linux_axi_io_read_block(base, offset, data, 1) ? -1 : 0;
 }
 
 /**
- * @brief AXI IO through UIO specific write function.
- * @param base - UIO index (/dev/uioX).
+ * @brief AXI IO through UIO/devmem write function.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Data to be written.
  * @return 0 in case of success, -1 otherwise.
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, NULL, &data);
-#else
-	return uio_read_write(base, offset, NULL, &data);
-#endif
+	return linux_axi_io_write_block(base, offset, &data, 1) ? -1 : 0;
 }
@@ -0,0 +1,83 @@
+/***************************************************************************//**
+ *   @file   linux/linux_axi_io.h
+ *   @brief  Header containing the persistent mapping API used by the Linux
+ *           AXI IO implementation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_AXI_IO_H_
+#define LINUX_AXI_IO_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_axi_io.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of register windows kept mapped at the same time */
+#ifndef LINUX_AXI_IO_MAX_MAPS
+#define LINUX_AXI_IO_MAX_MAPS		16
+#endif
+
+/** Window size used when a base is mapped on first access (DEVMEM only) */
+#ifndef LINUX_AXI_IO_DEFAULT_SIZE
+#define LINUX_AXI_IO_DEFAULT_SIZE	0x10000
+#endif
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Map a register window and keep it cached until linux_axi_io_unmap(). */
+int32_t linux_axi_io_map(uint32_t base, uint32_t size);
+
+/* Release the cached mapping of a register window. */
+int32_t linux_axi_io_unmap(uint32_t base);
+
+/* Release all the cached register windows. */
+int32_t linux_axi_io_remove(void);
+
+/* Read consecutive 32-bit registers from a register window. */
+int32_t linux_axi_io_read_block(uint32_t base, uint32_t offset,
+				uint32_t *data, uint32_t count);
+
+/* Write consecutive 32-bit registers of a register window. */
+int32_t linux_axi_io_write_block(uint32_t base, uint32_t offset,
+				 const uint32_t *data, uint32_t count);
+
+#endif // LINUX_AXI_IO_H_
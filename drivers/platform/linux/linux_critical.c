@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ *   @file   linux_critical.c
+ *   @brief  Linux critical section implementation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <pthread.h>
+#include "no_os_critical.h"
+
+/*
+ * The interrupt handlers of this platform run in the threads of linux_irq and
+ * linux_dma, so a recursive mutex excludes them like masking the interrupts
+ * would.
+ */
+static pthread_mutex_t linux_critical_lock;
+static pthread_once_t linux_critical_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Create the recursive lock behind the critical sections.
+ * @return None.
+ */
+static void linux_critical_init(void)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&linux_critical_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+/**
+ * @brief Enter a critical section.
+ * @return None.
+ */
+void no_os_critical_enter(void)
+{
+	pthread_once(&linux_critical_once, linux_critical_init);
+	pthread_mutex_lock(&linux_critical_lock);
+}
+
+/**
+ * @brief Leave a critical section.
+ * @return None.
+ */
+void no_os_critical_exit(void)
+{
+	pthread_mutex_unlock(&linux_critical_lock);
+}
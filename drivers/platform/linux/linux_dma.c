@@ -0,0 +1,392 @@
+/***************************************************************************//**
+ *   @file   linux_dma.c
+ *   @brief  Source file for Linux DMA platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "linux_irq.h"
+#include "linux_dma.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_dma_ch
+ * @brief Linux platform specific DMA channel. Each channel has a worker
+ * thread which copies the configured transfer and then raises the channel's
+ * interrupt line.
+ */
+struct linux_dma_ch {
+	/** Worker thread */
+	pthread_t thread;
+	/** Protects the fields below */
+	pthread_mutex_t lock;
+	/** Signals the worker to start and the waiters that it is done */
+	pthread_cond_t cond;
+	/** Generic DMA channel */
+	struct no_os_dma_ch *ch;
+	/** IRQ controller on which the completion is signaled */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Configured transfer */
+	struct no_os_dma_xfer_desc *xfer;
+	/** A transfer start was requested */
+	bool start;
+	/** The worker is copying the data */
+	bool busy;
+	/** The transfer in progress was aborted */
+	bool aborted;
+	/** The worker has to exit */
+	bool stop;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief DMA channel worker thread.
+ * @param arg - Linux DMA channel.
+ * @return NULL
+ */
+static void *linux_dma_thread(void *arg)
+{
+	struct linux_dma_ch *lch = arg;
+	struct no_os_dma_xfer_desc *xfer;
+
+	pthread_mutex_lock(&lch->lock);
+	while (true) {
+		while (!lch->start && !lch->stop)
+			pthread_cond_wait(&lch->cond, &lch->lock);
+
+		if (lch->stop)
+			break;
+
+		lch->start = false;
+		lch->busy = true;
+		xfer = lch->xfer;
+		pthread_mutex_unlock(&lch->lock);
+
+		memcpy(xfer->dst, xfer->src, xfer->length);
+
+		pthread_mutex_lock(&lch->lock);
+		lch->busy = false;
+		if (!lch->aborted)
+			linux_irq_trigger(lch->irq_ctrl, lch->ch->irq_num);
+		lch->aborted = false;
+		pthread_cond_broadcast(&lch->cond);
+	}
+	pthread_mutex_unlock(&lch->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Stop the worker threads of the first channels.
+ * @param desc - Descriptor for the DMA controller.
+ * @param nb_ch - Number of channels to be stopped.
+ */
+static void linux_dma_stop_threads(struct no_os_dma_desc *desc, uint32_t nb_ch)
+{
+	struct linux_dma_ch *lch = desc->extra;
+	uint32_t i;
+
+	for (i = 0; i < nb_ch; i++) {
+		pthread_mutex_lock(&lch[i].lock);
+		lch[i].stop = true;
+		pthread_cond_signal(&lch[i].cond);
+		pthread_mutex_unlock(&lch[i].lock);
+
+		pthread_join(lch[i].thread, NULL);
+		pthread_cond_destroy(&lch[i].cond);
+		pthread_mutex_destroy(&lch[i].lock);
+	}
+}
+
+/**
+ * @brief Initialize a DMA controller. The transfers are done using memcpy()
+ * and their completion is signaled on a Linux IRQ controller, one line per
+ * channel, so the generic scatter gather handler runs as it does on MCUs.
+ * @param desc - Descriptor to be initialized.
+ * @param param - Initialization parameter for the decriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_dma_init(struct no_os_dma_desc **desc,
+			  struct no_os_dma_init_param *param)
+{
+	struct no_os_dma_desc *descriptor;
+	struct linux_dma_ch *lch;
+	uint32_t i;
+	int ret;
+
+	struct no_os_irq_init_param irq_param = {
+		.irq_ctrl_id = param->id,
+		.platform_ops = &linux_irq_ops,
+		.extra = NULL
+	};
+
+	if (!param->num_ch || param->num_ch > LINUX_IRQ_NB)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->channels = no_os_calloc(param->num_ch,
+					    sizeof(*descriptor->channels));
+	if (!descriptor->channels) {
+		ret = -ENOMEM;
+		goto free_descriptor;
+	}
+
+	lch = no_os_calloc(param->num_ch, sizeof(*lch));
+	if (!lch) {
+		ret = -ENOMEM;
+		goto free_channels;
+	}
+
+	ret = no_os_irq_ctrl_init(&descriptor->irq_ctrl, &irq_param);
+	if (ret)
+		goto free_lch;
+
+	descriptor->id = param->id;
+	descriptor->num_ch = param->num_ch;
+	descriptor->extra = lch;
+	for (i = 0; i < param->num_ch; i++) {
+		descriptor->channels[i].id = i;
+		descriptor->channels[i].irq_num = i;
+		descriptor->channels[i].extra = &lch[i];
+		descriptor->channels[i].free = true;
+
+		lch[i].ch = &descriptor->channels[i];
+		lch[i].irq_ctrl = descriptor->irq_ctrl;
+		pthread_mutex_init(&lch[i].lock, NULL);
+		pthread_cond_init(&lch[i].cond, NULL);
+
+		ret = -pthread_create(&lch[i].thread, NULL, linux_dma_thread,
+				      &lch[i]);
+		if (ret) {
+			pthread_cond_destroy(&lch[i].cond);
+			pthread_mutex_destroy(&lch[i].lock);
+			goto stop_threads;
+		}
+	}
+
+	*desc = descriptor;
+
+	return 0;
+
+stop_threads:
+	linux_dma_stop_threads(descriptor, i);
+	no_os_irq_ctrl_remove(descriptor->irq_ctrl);
+free_lch:
+	no_os_free(lch);
+free_channels:
+	no_os_free(descriptor->channels);
+free_descriptor:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated for a DMA descriptor.
+ * @param desc - Descriptor to be freed.
+ * @return 0
+ */
+static int linux_dma_remove(struct no_os_dma_desc *desc)
+{
+	linux_dma_stop_threads(desc, desc->num_ch);
+	no_os_irq_ctrl_remove(desc->irq_ctrl);
+
+	no_os_free(desc->extra);
+	no_os_free(desc->channels);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Whether or not the channel has a transfer started.
+ * @param desc - DMA controller descriptor.
+ * @param ch - The channel for which we want to do the checking.
+ * @return true if the channel is busy, false otherwise.
+ */
+static bool linux_dma_in_progress(struct no_os_dma_desc *desc,
+				  struct no_os_dma_ch *ch)
+{
+	struct linux_dma_ch *lch = ch->extra;
+	bool busy;
+
+	pthread_mutex_lock(&lch->lock);
+	busy = lch->start || lch->busy;
+	pthread_mutex_unlock(&lch->lock);
+
+	return busy;
+}
+
+/**
+ * @brief Get a free DMA channel.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The index of the acquired channel.
+ * @return 0 if a channel was acquired
+ * 	   -EBUSY if there are no free channels
+ */
+static int linux_dma_acquire_free_ch(struct no_os_dma_desc *desc, uint32_t *ch)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->num_ch; i++) {
+		if (!desc->channels[i].free || desc->channels[i].sync_lock ||
+		    linux_dma_in_progress(desc, &desc->channels[i]))
+			continue;
+
+		*ch = i;
+		desc->channels[i].free = false;
+
+		return 0;
+	}
+
+	return -EBUSY;
+}
+
+/**
+ * @brief Disable a DMA channel. Waits for the copy in progress, if any, and
+ * drops its completion interrupt.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The channel.
+ * @return 0
+ */
+static int linux_dma_xfer_abort(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_ch *lch = ch->extra;
+
+	pthread_mutex_lock(&lch->lock);
+	lch->start = false;
+	if (lch->busy)
+		lch->aborted = true;
+	while (lch->busy)
+		pthread_cond_wait(&lch->cond, &lch->lock);
+	pthread_mutex_unlock(&lch->lock);
+
+	return linux_irq_clear_pending(desc->irq_ctrl, ch->irq_num);
+}
+
+/**
+ * @brief Free DMA channel.
+ * @param desc - Structure containing the state of the DMA controller.
+ * @param ch - Index in the DMA controller struct's channel array for the
+ * 	       currently acquired channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_dma_release_ch(struct no_os_dma_desc *desc, uint32_t ch)
+{
+	return linux_dma_xfer_abort(desc, &desc->channels[ch]);
+}
+
+/**
+ * @brief Configure a DMA channel for a transfer.
+ * @param channel - The DMA channel descriptor.
+ * @param xfer - Descriptor for the transfer.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int linux_dma_config_xfer(struct no_os_dma_ch *channel,
+				 struct no_os_dma_xfer_desc *xfer)
+{
+	struct linux_dma_ch *lch = channel->extra;
+
+	switch (xfer->xfer_type) {
+	case MEM_TO_MEM:
+	case MEM_TO_DEV:
+	case DEV_TO_MEM:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&lch->lock);
+	lch->xfer = xfer;
+	pthread_mutex_unlock(&lch->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Start a DMA transfer for a specific channel.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The channel.
+ * @return 0 in case of success, -EINVAL if no transfer was configured.
+ */
+static int linux_dma_xfer_start(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_ch *lch = ch->extra;
+	int ret = 0;
+
+	pthread_mutex_lock(&lch->lock);
+	if (lch->xfer) {
+		lch->start = true;
+		pthread_cond_signal(&lch->cond);
+	} else {
+		ret = -EINVAL;
+	}
+	pthread_mutex_unlock(&lch->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Linux platform specific callbacks for the DMA API
+ */
+struct no_os_dma_platform_ops linux_dma_ops = {
+	.dma_init = linux_dma_init,
+	.dma_remove = linux_dma_remove,
+	.dma_config_xfer = linux_dma_config_xfer,
+	.dma_xfer_start = linux_dma_xfer_start,
+	.dma_xfer_abort = linux_dma_xfer_abort,
+	.dma_acquire_ch = linux_dma_acquire_free_ch,
+	.dma_release_ch = linux_dma_release_ch,
+	.dma_ch_in_progress = linux_dma_in_progress,
+};
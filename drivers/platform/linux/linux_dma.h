@@ -1,10 +1,8 @@
 /***************************************************************************//**
- *   @file   no_os_lf256fifo.h
- *   @brief  SPSC lock-free fifo of fixed size (256), specialized for UART.
- *   @author Darius Berghe (darius.berghe@analog.com)
+ *   @file   linux_dma.h
+ *   @brief  Header file for Linux DMA platform driver.
 ********************************************************************************
- *   @copyright
- * Copyright 2020(c) Analog Devices, Inc.
+ * Copyright 2024(c) Analog Devices, Inc.
  *
  * All rights reserved.
  *
@@ -38,22 +36,17 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
-#ifndef __LFFIFO_H
-#define __LFFIFO_H
+#ifndef LINUX_DMA_H_
+#define LINUX_DMA_H_
 
-#include <stdlib.h>
-#include <stdint.h>
-#include <stdbool.h>
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_dma.h"
 
-struct lf256fifo;
-
-int lf256fifo_init(struct lf256fifo **);
-bool lf256fifo_is_full(struct lf256fifo *);
-bool lf256fifo_is_empty(struct lf256fifo *);
-int lf256fifo_read(struct lf256fifo *, uint8_t *);
-int lf256fifo_write(struct lf256fifo *, uint8_t);
-void lf256fifo_flush(struct lf256fifo *);
-void lf256fifo_remove(struct lf256fifo *fifo);
-
-#endif
+/**
+ * @brief Linux specific DMA platform ops.
+ */
+extern struct no_os_dma_platform_ops linux_dma_ops;
 
+#endif //LINUX_DMA_H_
@@ -0,0 +1,1142 @@
+/***************************************************************************//**
+ *   @file   linux_gpiochip.c
+ *   @brief  Source file for Linux GPIO character device platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "linux_irq.h"
+#include "linux_gpiochip.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Consumer label of the requested lines */
+#define LINUX_GPIOCHIP_CONSUMER		"no-os"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpiochip_desc
+ * @brief Linux GPIO character device descriptor
+ */
+struct linux_gpiochip_desc {
+	/** Request of the single line */
+	struct linux_gpiochip_group group;
+	/** Bias flags */
+	uint64_t bias;
+	/** Set if the line is an output */
+	bool output;
+};
+
+/**
+ * @struct linux_gpiochip_irq_line
+ * @brief Interrupt slot of a GPIO line
+ */
+struct linux_gpiochip_irq_line {
+	/** Controller the slot belongs to */
+	struct linux_gpiochip_irq_desc *gdesc;
+	/** Set while the slot is bound to a line */
+	bool used;
+	/** Line offset on the chip */
+	uint32_t offset;
+	/** Line request file descriptor, -1 if not requested */
+	int fd;
+	/** Edge detection flags */
+	uint64_t edge;
+	/** Edge events read, but not handled yet */
+	uint32_t events;
+	/** User callback */
+	void (*callback)(void *context);
+	/** User callback parameter */
+	void *ctx;
+};
+
+/**
+ * @struct linux_gpiochip_irq_desc
+ * @brief Linux GPIO character device IRQ controller descriptor
+ *
+ * The edge events are read by a thread and raised on an inner Linux IRQ
+ * controller, which runs the callbacks, so that they are serialized with each
+ * other and with the global disable sections, as on the other platforms.
+ * The lines are bound to the inner controller slots when first used, so any
+ * line offset may be an interrupt source, up to LINUX_IRQ_NB lines at once.
+ */
+struct linux_gpiochip_irq_desc {
+	/** Controller running the callbacks */
+	struct no_os_irq_ctrl_desc *irq;
+	/** Event reader thread */
+	pthread_t thread;
+	/** Protects the line state */
+	pthread_mutex_t lock;
+	/** Wakes up the event reader thread */
+	int efd;
+	/** Set when the event reader thread has to exit */
+	bool stop;
+	/** Line slots, indexed by the inner controller IRQ id */
+	struct linux_gpiochip_irq_line lines[LINUX_IRQ_NB];
+	/** Slots whose line is to be released by the event reader thread */
+	uint64_t release;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Get the mask covering a number of lines.
+ * @param nb_lines - Number of lines.
+ * @return The mask.
+ */
+static uint64_t linux_gpiochip_mask(uint32_t nb_lines)
+{
+	if (nb_lines >= GPIO_V2_LINES_MAX)
+		return UINT64_MAX;
+
+	return (1ULL << nb_lines) - 1;
+}
+
+/**
+ * @brief Request lines of a GPIO chip.
+ * @param chip - Index of the /dev/gpiochip device.
+ * @param offsets - Line offsets.
+ * @param nb_lines - Number of lines.
+ * @param flags - Line flags.
+ * @param values - Initial output values, if the lines are outputs.
+ * @param fd - The line request file descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_request(uint32_t chip, const uint32_t *offsets,
+				      uint32_t nb_lines, uint64_t flags,
+				      uint64_t values, int *fd)
+{
+	struct gpio_v2_line_request req;
+	char path[32];
+	int chip_fd;
+	int ret;
+
+	if (!offsets || !nb_lines || nb_lines > GPIO_V2_LINES_MAX)
+		return -EINVAL;
+
+	snprintf(path, sizeof(path), "/dev/gpiochip%" PRIu32, chip);
+	chip_fd = open(path, O_RDWR | O_CLOEXEC);
+	if (chip_fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		return -errno;
+	}
+
+	memset(&req, 0, sizeof(req));
+	memcpy(req.offsets, offsets, nb_lines * sizeof(*offsets));
+	strncpy(req.consumer, LINUX_GPIOCHIP_CONSUMER, sizeof(req.consumer) - 1);
+	req.num_lines = nb_lines;
+	req.config.flags = flags;
+	if (flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+		req.config.num_attrs = 1;
+		req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		req.config.attrs[0].attr.values = values;
+		req.config.attrs[0].mask = linux_gpiochip_mask(nb_lines);
+	}
+
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+	if (ret < 0)
+		ret = -errno;
+	close(chip_fd);
+	if (ret) {
+		printf("%s: Can't request the lines of %s\n\r", __func__, path);
+		return ret;
+	}
+
+	*fd = req.fd;
+
+	return 0;
+}
+
+/**
+ * @brief Change the configuration of requested lines.
+ * @param fd - The line request file descriptor.
+ * @param nb_lines - Number of requested lines.
+ * @param flags - Line flags.
+ * @param values - Output values, if the lines become outputs.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_set_config(int fd, uint32_t nb_lines,
+		uint64_t flags, uint64_t values)
+{
+	struct gpio_v2_line_config config;
+
+	memset(&config, 0, sizeof(config));
+	config.flags = flags;
+	if (flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+		config.num_attrs = 1;
+		config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		config.attrs[0].attr.values = values;
+		config.attrs[0].mask = linux_gpiochip_mask(nb_lines);
+	}
+
+	if (ioctl(fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Request several lines of a GPIO chip, so they can be set or read
+ * with a single ioctl.
+ * @param group - The group descriptor.
+ * @param chip - Index of the /dev/gpiochip device.
+ * @param offsets - Line offsets.
+ * @param nb_lines - Number of lines, at most 64.
+ * @param output - Request the lines as outputs, otherwise as inputs.
+ * @param values - Initial output values, bit i for offsets[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpiochip_group_get(struct linux_gpiochip_group **group,
+				 uint32_t chip, const uint32_t *offsets,
+				 uint32_t nb_lines, bool output, uint64_t values)
+{
+	struct linux_gpiochip_group *descriptor;
+	uint64_t flags;
+	int32_t ret;
+
+	if (!group)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	flags = output ? GPIO_V2_LINE_FLAG_OUTPUT : GPIO_V2_LINE_FLAG_INPUT;
+	ret = linux_gpiochip_request(chip, offsets, nb_lines, flags, values,
+				     &descriptor->fd);
+	if (ret) {
+		no_os_free(descriptor);
+		return ret;
+	}
+
+	descriptor->nb_lines = nb_lines;
+	*group = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Set the lines of a group selected by mask, with a single ioctl.
+ * @param group - The group descriptor.
+ * @param mask - Lines to be set, bit i for offsets[i].
+ * @param values - Line values, bit i for offsets[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpiochip_group_set_values(struct linux_gpiochip_group *group,
+					uint64_t mask, uint64_t values)
+{
+	struct gpio_v2_line_values lv = {
+		.bits = values,
+		.mask = mask,
+	};
+
+	if (!group)
+		return -EINVAL;
+
+	if (ioctl(group->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lv) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Read the lines of a group selected by mask, with a single ioctl.
+ * @param group - The group descriptor.
+ * @param mask - Lines to be read, bit i for offsets[i].
+ * @param values - Line values, bit i for offsets[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpiochip_group_get_values(struct linux_gpiochip_group *group,
+					uint64_t mask, uint64_t *values)
+{
+	struct gpio_v2_line_values lv = {
+		.mask = mask,
+	};
+
+	if (!group || !values)
+		return -EINVAL;
+
+	if (ioctl(group->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &lv) < 0)
+		return -errno;
+
+	*values = lv.bits & mask;
+
+	return 0;
+}
+
+/**
+ * @brief Release the lines of a group.
+ * @param group - The group descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t linux_gpiochip_group_remove(struct linux_gpiochip_group *group)
+{
+	if (!group)
+		return -EINVAL;
+
+	close(group->fd);
+	no_os_free(group);
+
+	return 0;
+}
+
+/**
+ * @brief Obtain the GPIO decriptor. The line is requested as an input.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_get(struct no_os_gpio_desc **desc,
+				  const struct no_os_gpio_init_param *param)
+{
+	struct linux_gpiochip_desc *linux_desc;
+	struct no_os_gpio_desc *descriptor;
+	uint32_t offset;
+	int32_t ret;
+
+	if (!desc || !param || param->port < 0 || param->number < 0)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	switch (param->pull) {
+	case NO_OS_PULL_UP:
+	case NO_OS_PULL_UP_WEAK:
+		linux_desc->bias = GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+		break;
+	case NO_OS_PULL_DOWN:
+	case NO_OS_PULL_DOWN_WEAK:
+		linux_desc->bias = GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+		break;
+	default:
+		linux_desc->bias = 0;
+		break;
+	}
+
+	offset = param->number;
+	ret = linux_gpiochip_request(param->port, &offset, 1,
+				     GPIO_V2_LINE_FLAG_INPUT | linux_desc->bias,
+				     0, &linux_desc->group.fd);
+	if (ret)
+		goto free_linux_desc;
+
+	linux_desc->group.nb_lines = 1;
+
+	descriptor->port = param->port;
+	descriptor->number = param->number;
+	descriptor->pull = param->pull;
+	descriptor->extra = linux_desc;
+
+	*desc = descriptor;
+
+	return 0;
+
+free_linux_desc:
+	no_os_free(linux_desc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Get the value of an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_get_optional(struct no_os_gpio_desc **desc,
+		const struct no_os_gpio_init_param *param)
+{
+	if (!param) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return linux_gpiochip_get(desc, param);
+}
+
+/**
+ * @brief Release the line and free the descriptor.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_gpiochip_remove(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpiochip_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	close(linux_desc->group.fd);
+	no_os_free(linux_desc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_direction_input(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpiochip_desc *linux_desc;
+	int32_t ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	ret = linux_gpiochip_set_config(linux_desc->group.fd, 1,
+					GPIO_V2_LINE_FLAG_INPUT |
+					linux_desc->bias, 0);
+	if (ret)
+		return ret;
+
+	linux_desc->output = false;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO. The value is
+ * applied along with the direction.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	struct linux_gpiochip_desc *linux_desc;
+	int32_t ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	ret = linux_gpiochip_set_config(linux_desc->group.fd, 1,
+					GPIO_V2_LINE_FLAG_OUTPUT |
+					linux_desc->bias, !!value);
+	if (ret)
+		return ret;
+
+	linux_desc->output = true;
+
+	return 0;
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ *                    Example: NO_OS_GPIO_OUT
+ *                             NO_OS_GPIO_IN
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_gpiochip_get_direction(struct no_os_gpio_desc *desc,
+		uint8_t *direction)
+{
+	struct linux_gpiochip_desc *linux_desc;
+
+	if (!desc || !desc->extra || !direction)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	*direction = linux_desc->output ? NO_OS_GPIO_OUT : NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_set_value(struct no_os_gpio_desc *desc,
+					uint8_t value)
+{
+	struct linux_gpiochip_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	return linux_gpiochip_group_set_values(&linux_desc->group, 1, !!value);
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_get_value(struct no_os_gpio_desc *desc,
+					uint8_t *value)
+{
+	struct linux_gpiochip_desc *linux_desc;
+	uint64_t values = 0;
+	int32_t ret;
+
+	if (!desc || !desc->extra || !value)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	ret = linux_gpiochip_group_get_values(&linux_desc->group, 1, &values);
+	if (ret)
+		return ret;
+
+	*value = values ? NO_OS_GPIO_HIGH : NO_OS_GPIO_LOW;
+
+	return 0;
+}
+
+/**
+ * @brief Wake up the event reader thread.
+ * @param gdesc - GPIO IRQ controller descriptor.
+ */
+static void linux_gpiochip_irq_kick(struct linux_gpiochip_irq_desc *gdesc)
+{
+	uint64_t val = 1;
+
+	if (write(gdesc->efd, &val, sizeof(val)) != sizeof(val))
+		printf("%s: Can't wake up the event thread\n\r", __func__);
+}
+
+/**
+ * @brief Get the slot bound to a line. Must be called with the lock held.
+ * @param gdesc - GPIO IRQ controller descriptor.
+ * @param offset - Line offset.
+ * @param alloc - Bind a free slot to the line if it has none.
+ * @return Slot index, -ENOENT if the line has no slot, -ENOSPC if all the
+ * slots are in use.
+ */
+static int32_t linux_gpiochip_irq_slot(struct linux_gpiochip_irq_desc *gdesc,
+				       uint32_t offset, bool alloc)
+{
+	int32_t free_slot = -ENOSPC;
+	int32_t i;
+
+	for (i = 0; i < LINUX_IRQ_NB; i++) {
+		if (!gdesc->lines[i].used) {
+			if (free_slot < 0)
+				free_slot = i;
+			continue;
+		}
+		if (gdesc->lines[i].offset == offset)
+			return i;
+	}
+
+	if (!alloc)
+		return -ENOENT;
+	if (free_slot < 0)
+		return free_slot;
+
+	gdesc->lines[free_slot].used = true;
+	gdesc->lines[free_slot].offset = offset;
+	gdesc->lines[free_slot].fd = -1;
+	gdesc->lines[free_slot].edge = GPIO_V2_LINE_FLAG_EDGE_RISING;
+	gdesc->lines[free_slot].events = 0;
+	gdesc->lines[free_slot].callback = NULL;
+	gdesc->lines[free_slot].ctx = NULL;
+
+	return free_slot;
+}
+
+/**
+ * @brief Inner controller callback of a slot. Calls the user callback once
+ * for every edge event read since the last call.
+ * @param context - Line slot.
+ */
+static void linux_gpiochip_irq_handler(void *context)
+{
+	struct linux_gpiochip_irq_line *line = context;
+	struct linux_gpiochip_irq_desc *gdesc = line->gdesc;
+	void (*callback)(void *context);
+	uint32_t events;
+	void *ctx;
+
+	pthread_mutex_lock(&gdesc->lock);
+	events = line->events;
+	line->events = 0;
+	callback = line->callback;
+	ctx = line->ctx;
+	pthread_mutex_unlock(&gdesc->lock);
+
+	if (!callback)
+		return;
+
+	while (events--)
+		callback(ctx);
+}
+
+/**
+ * @brief Event reader thread. Waits for edge events on the requested lines
+ * and raises the matching interrupt on the inner IRQ controller.
+ * @param arg - GPIO IRQ controller descriptor.
+ * @return NULL
+ */
+static void *linux_gpiochip_irq_thread(void *arg)
+{
+	struct linux_gpiochip_irq_desc *gdesc = arg;
+	struct gpio_v2_line_event events[16];
+	struct pollfd fds[LINUX_IRQ_NB + 1];
+	uint32_t slots[LINUX_IRQ_NB + 1];
+	struct linux_gpiochip_irq_line *line;
+	uint32_t nb_fds;
+	uint64_t val;
+	ssize_t ret;
+	uint32_t i;
+
+	while (true) {
+		pthread_mutex_lock(&gdesc->lock);
+		if (gdesc->stop) {
+			pthread_mutex_unlock(&gdesc->lock);
+			break;
+		}
+
+		/* Lines are released here, so no polled descriptor is closed */
+		for (i = 0; i < LINUX_IRQ_NB; i++) {
+			if (!(gdesc->release & (1ULL << i)))
+				continue;
+			line = &gdesc->lines[i];
+			close(line->fd);
+			line->fd = -1;
+			/* Keep the slot if a callback was registered meanwhile */
+			if (!line->callback)
+				line->used = false;
+		}
+		gdesc->release = 0;
+
+		fds[0].fd = gdesc->efd;
+		fds[0].events = POLLIN;
+		nb_fds = 1;
+		for (i = 0; i < LINUX_IRQ_NB; i++) {
+			if (!gdesc->lines[i].used || gdesc->lines[i].fd < 0)
+				continue;
+			fds[nb_fds].fd = gdesc->lines[i].fd;
+			fds[nb_fds].events = POLLIN;
+			slots[nb_fds] = i;
+			nb_fds++;
+		}
+		pthread_mutex_unlock(&gdesc->lock);
+
+		if (poll(fds, nb_fds, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			if (read(gdesc->efd, &val, sizeof(val)) != sizeof(val))
+				break;
+			continue;
+		}
+
+		for (i = 1; i < nb_fds; i++) {
+			if (!(fds[i].revents & POLLIN))
+				continue;
+			ret = read(fds[i].fd, events, sizeof(events));
+			if (ret < (ssize_t)sizeof(events[0]))
+				continue;
+
+			/* Each event is handled, even if raised as one interrupt */
+			pthread_mutex_lock(&gdesc->lock);
+			gdesc->lines[slots[i]].events += ret / sizeof(events[0]);
+			pthread_mutex_unlock(&gdesc->lock);
+
+			linux_irq_trigger(gdesc->irq, slots[i]);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the GPIO IRQ controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ controller parameters.
+ * 		  irq_ctrl_id is the /dev/gpiochip index.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+		const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_init_param irq_param = {
+		.platform_ops = &linux_irq_ops,
+	};
+	struct linux_gpiochip_irq_desc *gdesc;
+	struct no_os_irq_ctrl_desc *descriptor;
+	uint32_t i;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	gdesc = no_os_calloc(1, sizeof(*gdesc));
+	if (!gdesc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	for (i = 0; i < LINUX_IRQ_NB; i++) {
+		gdesc->lines[i].gdesc = gdesc;
+		gdesc->lines[i].fd = -1;
+	}
+
+	irq_param.irq_ctrl_id = param->irq_ctrl_id;
+	ret = no_os_irq_ctrl_init(&gdesc->irq, &irq_param);
+	if (ret)
+		goto free_gdesc;
+
+	gdesc->efd = eventfd(0, EFD_CLOEXEC);
+	if (gdesc->efd < 0) {
+		ret = -errno;
+		goto remove_irq;
+	}
+
+	pthread_mutex_init(&gdesc->lock, NULL);
+
+	ret = -pthread_create(&gdesc->thread, NULL, linux_gpiochip_irq_thread,
+			      gdesc);
+	if (ret)
+		goto destroy_lock;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->platform_ops = param->platform_ops;
+	descriptor->extra = gdesc;
+
+	*desc = descriptor;
+
+	return 0;
+
+destroy_lock:
+	pthread_mutex_destroy(&gdesc->lock);
+	close(gdesc->efd);
+remove_irq:
+	no_os_irq_ctrl_remove(gdesc->irq);
+free_gdesc:
+	no_os_free(gdesc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the event reader thread, release the lines and free the
+ * resources allocated for the GPIO IRQ controller.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_gpiochip_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	uint32_t i;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	gdesc->stop = true;
+	pthread_mutex_unlock(&gdesc->lock);
+	linux_gpiochip_irq_kick(gdesc);
+	pthread_join(gdesc->thread, NULL);
+
+	no_os_irq_ctrl_remove(gdesc->irq);
+
+	for (i = 0; i < LINUX_IRQ_NB; i++)
+		if (gdesc->lines[i].fd >= 0)
+			close(gdesc->lines[i].fd);
+
+	pthread_mutex_destroy(&gdesc->lock);
+	close(gdesc->efd);
+	no_os_free(gdesc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a callback for the edge events of a line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_register_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id, struct no_os_callback_desc *cb)
+{
+	struct no_os_callback_desc slot_cb = {
+		.callback = linux_gpiochip_irq_handler,
+	};
+	struct linux_gpiochip_irq_desc *gdesc;
+	int32_t slot;
+
+	if (!desc || !desc->extra || !cb)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, true);
+	if (slot >= 0) {
+		gdesc->lines[slot].callback = cb->callback;
+		gdesc->lines[slot].ctx = cb->ctx;
+	}
+	pthread_mutex_unlock(&gdesc->lock);
+	if (slot < 0)
+		return slot;
+
+	slot_cb.ctx = &gdesc->lines[slot];
+
+	return no_os_irq_register_callback(gdesc->irq, slot, &slot_cb);
+}
+
+/**
+ * @brief Unregister the callback of a line and release the line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_unregister_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id, struct no_os_callback_desc *cb)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	int32_t slot;
+	int32_t ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, false);
+	pthread_mutex_unlock(&gdesc->lock);
+	if (slot < 0)
+		return -EINVAL;
+
+	no_os_irq_disable(gdesc->irq, slot);
+	ret = no_os_irq_unregister_callback(gdesc->irq, slot, cb);
+
+	pthread_mutex_lock(&gdesc->lock);
+	gdesc->lines[slot].callback = NULL;
+	gdesc->lines[slot].ctx = NULL;
+	gdesc->lines[slot].events = 0;
+	if (gdesc->lines[slot].fd >= 0) {
+		/* The slot is freed once the thread released the line */
+		gdesc->release |= 1ULL << slot;
+		linux_gpiochip_irq_kick(gdesc);
+	} else {
+		gdesc->lines[slot].used = false;
+	}
+	pthread_mutex_unlock(&gdesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Allow the callbacks to run again.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_global_enable(struct no_os_irq_ctrl_desc
+		*desc)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	return no_os_irq_global_enable(gdesc->irq);
+}
+
+/**
+ * @brief Hold off the callbacks. The events are handled once enabled again.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_global_disable(struct no_os_irq_ctrl_desc
+		*desc)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	return no_os_irq_global_disable(gdesc->irq);
+}
+
+/**
+ * @brief Set the edges detected on a line. Level triggers are not supported
+ * by the GPIO character device.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param trig - The trigger condition.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_trigger_level_set(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id, enum no_os_irq_trig_level trig)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	struct linux_gpiochip_irq_line *line;
+	int32_t slot;
+	uint64_t edge;
+	int32_t ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	switch (trig) {
+	case NO_OS_IRQ_EDGE_RISING:
+		edge = GPIO_V2_LINE_FLAG_EDGE_RISING;
+		break;
+	case NO_OS_IRQ_EDGE_FALLING:
+		edge = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	case NO_OS_IRQ_EDGE_BOTH:
+		edge = GPIO_V2_LINE_FLAG_EDGE_RISING |
+		       GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, true);
+	if (slot < 0) {
+		ret = slot;
+		goto unlock;
+	}
+
+	line = &gdesc->lines[slot];
+	line->edge = edge;
+	if (line->fd >= 0)
+		ret = linux_gpiochip_set_config(line->fd, 1,
+						GPIO_V2_LINE_FLAG_INPUT | edge, 0);
+unlock:
+	pthread_mutex_unlock(&gdesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable the edge events of a line. The line is requested the first
+ * time it is enabled. Events which occurred while disabled are dropped.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_enable(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	struct linux_gpiochip_irq_line *line;
+	int32_t slot;
+	int32_t ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, true);
+	if (slot < 0) {
+		pthread_mutex_unlock(&gdesc->lock);
+		return slot;
+	}
+
+	line = &gdesc->lines[slot];
+	/* A line waiting to be released is still requested */
+	gdesc->release &= ~(1ULL << slot);
+	if (line->fd < 0) {
+		ret = linux_gpiochip_request(desc->irq_ctrl_id, &irq_id, 1,
+					     GPIO_V2_LINE_FLAG_INPUT |
+					     line->edge, 0, &line->fd);
+		if (!ret)
+			linux_gpiochip_irq_kick(gdesc);
+	}
+	line->events = 0;
+	pthread_mutex_unlock(&gdesc->lock);
+	if (ret)
+		return ret;
+
+	linux_irq_clear_pending(gdesc->irq, slot);
+
+	return no_os_irq_enable(gdesc->irq, slot);
+}
+
+/**
+ * @brief Disable the edge events of a line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_disable(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	int32_t slot;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, false);
+	pthread_mutex_unlock(&gdesc->lock);
+	if (slot < 0)
+		return -EINVAL;
+
+	return no_os_irq_disable(gdesc->irq, slot);
+}
+
+/**
+ * @brief Set the priority of a line's callback.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Line offset.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpiochip_irq_set_priority(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id, uint32_t priority_level)
+{
+	struct linux_gpiochip_irq_desc *gdesc;
+	int32_t slot;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	pthread_mutex_lock(&gdesc->lock);
+	slot = linux_gpiochip_irq_slot(gdesc, irq_id, true);
+	pthread_mutex_unlock(&gdesc->lock);
+	if (slot < 0)
+		return slot;
+
+	return no_os_irq_set_priority(gdesc->irq, slot, priority_level);
+}
+
+/**
+ * @brief Linux GPIO character device platform ops structure
+ */
+const struct no_os_gpio_platform_ops linux_gpiochip_ops = {
+	.gpio_ops_get = &linux_gpiochip_get,
+	.gpio_ops_get_optional = &linux_gpiochip_get_optional,
+	.gpio_ops_remove = &linux_gpiochip_remove,
+	.gpio_ops_direction_input = &linux_gpiochip_direction_input,
+	.gpio_ops_direction_output = &linux_gpiochip_direction_output,
+	.gpio_ops_get_direction = &linux_gpiochip_get_direction,
+	.gpio_ops_set_value = &linux_gpiochip_set_value,
+	.gpio_ops_get_value = &linux_gpiochip_get_value,
+};
+
+/**
+ * @brief Linux GPIO character device IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_gpiochip_irq_ops = {
+	.init = &linux_gpiochip_irq_ctrl_init,
+	.register_callback = &linux_gpiochip_irq_register_callback,
+	.unregister_callback = &linux_gpiochip_irq_unregister_callback,
+	.global_enable = &linux_gpiochip_irq_global_enable,
+	.global_disable = &linux_gpiochip_irq_global_disable,
+	.trigger_level_set = &linux_gpiochip_irq_trigger_level_set,
+	.enable = &linux_gpiochip_irq_enable,
+	.disable = &linux_gpiochip_irq_disable,
+	.set_priority = &linux_gpiochip_irq_set_priority,
+	.remove = &linux_gpiochip_irq_ctrl_remove
+};
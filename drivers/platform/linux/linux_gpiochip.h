@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ *   @file   linux_gpiochip.h
+ *   @brief  Header file for Linux GPIO character device platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_GPIOCHIP_H_
+#define LINUX_GPIOCHIP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpiochip_group
+ * @brief Lines of a GPIO chip requested together, so that they are set or
+ * read with a single ioctl. Bit i of the masks and values used with a group
+ * refers to offsets[i] of linux_gpiochip_group_get().
+ */
+struct linux_gpiochip_group {
+	/** Line request file descriptor */
+	int fd;
+	/** Number of lines in the group */
+	uint32_t nb_lines;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Request several lines of /dev/gpiochip"chip" at once. */
+int32_t linux_gpiochip_group_get(struct linux_gpiochip_group **group,
+				 uint32_t chip, const uint32_t *offsets,
+				 uint32_t nb_lines, bool output, uint64_t values);
+
+/* Set the lines of a group selected by mask. */
+int32_t linux_gpiochip_group_set_values(struct linux_gpiochip_group *group,
+					uint64_t mask, uint64_t values);
+
+/* Read the lines of a group selected by mask. */
+int32_t linux_gpiochip_group_get_values(struct linux_gpiochip_group *group,
+					uint64_t mask, uint64_t *values);
+
+/* Release the lines of a group. */
+int32_t linux_gpiochip_group_remove(struct linux_gpiochip_group *group);
+
+/**
+ * @brief Linux GPIO character device platform ops. The port is the
+ * /dev/gpiochip index and the number is the line offset on that chip.
+ */
+extern const struct no_os_gpio_platform_ops linux_gpiochip_ops;
+
+/**
+ * @brief Linux GPIO character device edge event IRQ ops. The controller id is
+ * the /dev/gpiochip index and the IRQ id is the line offset. Up to LINUX_IRQ_NB
+ * lines may be used at once. The callback is called once for each edge event.
+ * The line must not also be requested as a GPIO.
+ */
+extern const struct no_os_irq_platform_ops linux_gpiochip_irq_ops;
+
+#endif // LINUX_GPIOCHIP_H_
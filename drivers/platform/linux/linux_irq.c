@@ -0,0 +1,546 @@
+/***************************************************************************//**
+ *   @file   linux_irq.c
+ *   @brief  Source file for Linux IRQ platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "linux_irq.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_line
+ * @brief State of an interrupt line
+ */
+struct linux_irq_line {
+	/** Handler registered for the line */
+	void (*callback)(void *context);
+	/** Parameter passed to the handler */
+	void *ctx;
+	/** Lower values are handled first */
+	uint32_t priority;
+};
+
+/**
+ * @struct linux_irq_desc
+ * @brief Linux platform specific IRQ controller descriptor
+ *
+ * The interrupts are raised by setting a bit in the pending mask and writing
+ * the eventfd. A dispatcher thread waits on the eventfd and runs the handlers
+ * of the pending and enabled lines with the lock held, so the handlers never
+ * run concurrently with each other. While the global disable depth is not 0
+ * the dispatcher leaves the lines pending; the last global_enable() wakes it
+ * up again.
+ */
+struct linux_irq_desc {
+	/** Dispatcher thread */
+	pthread_t thread;
+	/** Protects the descriptor, held while the handlers run */
+	pthread_mutex_t lock;
+	/** Number of global_disable() calls not yet matched by global_enable() */
+	uint32_t disable_depth;
+	/** Wakes up the dispatcher thread */
+	int efd;
+	/** Raised lines, updated atomically */
+	uint64_t pending;
+	/** Enabled lines */
+	uint64_t enabled;
+	/** Set when the dispatcher thread has to exit */
+	bool stop;
+	/** Per line state */
+	struct linux_irq_line lines[LINUX_IRQ_NB];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Wake up the dispatcher thread.
+ * @param ldesc - Linux IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_kick(struct linux_irq_desc *ldesc)
+{
+	uint64_t val = 1;
+
+	if (write(ldesc->efd, &val, sizeof(val)) != sizeof(val))
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Find the pending and enabled line with the highest priority.
+ * @param ldesc - Linux IRQ controller descriptor.
+ * @param ready - Mask of the pending and enabled lines.
+ * @return Index of the line to be handled.
+ */
+static uint32_t linux_irq_next(struct linux_irq_desc *ldesc, uint64_t ready)
+{
+	uint32_t best = __builtin_ctzll(ready);
+	uint32_t i;
+
+	ready &= ready - 1;
+	while (ready) {
+		i = __builtin_ctzll(ready);
+		if (ldesc->lines[i].priority < ldesc->lines[best].priority)
+			best = i;
+		ready &= ready - 1;
+	}
+
+	return best;
+}
+
+/**
+ * @brief Dispatcher thread. Runs the handlers of the raised lines.
+ * @param arg - Linux IRQ controller descriptor.
+ * @return NULL
+ */
+static void *linux_irq_thread(void *arg)
+{
+	struct linux_irq_desc *ldesc = arg;
+	struct linux_irq_line *line;
+	uint64_t ready;
+	uint64_t val;
+	uint32_t i;
+
+	while (true) {
+		if (read(ldesc->efd, &val, sizeof(val)) != sizeof(val)) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		pthread_mutex_lock(&ldesc->lock);
+		if (ldesc->stop) {
+			pthread_mutex_unlock(&ldesc->lock);
+			break;
+		}
+
+		/*
+		 * Lines raised by the handlers themselves are picked up in the
+		 * same pass, as tail chained interrupts would be.
+		 */
+		while (!ldesc->disable_depth) {
+			ready = __atomic_load_n(&ldesc->pending, __ATOMIC_ACQUIRE);
+			ready &= ldesc->enabled;
+			if (!ready)
+				break;
+
+			i = linux_irq_next(ldesc, ready);
+			__atomic_fetch_and(&ldesc->pending, ~(1ULL << i),
+					   __ATOMIC_ACQ_REL);
+
+			line = &ldesc->lines[i];
+			if (line->callback)
+				line->callback(line->ctx);
+		}
+
+		pthread_mutex_unlock(&ldesc->lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the IRQ controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ controller parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				   const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_irq_desc *ldesc;
+	pthread_mutexattr_t attr;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ldesc->efd = eventfd(0, EFD_CLOEXEC);
+	if (ldesc->efd < 0) {
+		ret = -errno;
+		goto free_ldesc;
+	}
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	ret = -pthread_mutex_init(&ldesc->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	if (ret)
+		goto close_fd;
+
+	ret = -pthread_create(&ldesc->thread, NULL, linux_irq_thread, ldesc);
+	if (ret)
+		goto destroy_lock;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->platform_ops = param->platform_ops;
+	descriptor->extra = ldesc;
+
+	*desc = descriptor;
+
+	return 0;
+
+destroy_lock:
+	pthread_mutex_destroy(&ldesc->lock);
+close_fd:
+	close(ldesc->efd);
+free_ldesc:
+	no_os_free(ldesc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Register a callback for an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || !cb || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].callback = cb->callback;
+	ldesc->lines[irq_id].ctx = cb->ctx;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Unregister the callback of an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].callback = NULL;
+	ldesc->lines[irq_id].ctx = NULL;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Allow the handlers to run again after linux_irq_global_disable().
+ * Without a matching disable, e.g. when enabling the interrupts after init,
+ * this does nothing.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+	int32_t ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	if (ldesc->disable_depth) {
+		ldesc->disable_depth--;
+		/* Run the lines raised while the handlers were held off */
+		if (!ldesc->disable_depth &&
+		    (__atomic_load_n(&ldesc->pending, __ATOMIC_ACQUIRE) &
+		     ldesc->enabled))
+			ret = linux_irq_kick(ldesc);
+	}
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Hold off the handlers. Waits for a running handler to return.
+ * Calls may be nested, the handlers run again after the same number of
+ * linux_irq_global_enable() calls.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	/* The lock is held by the dispatcher while a handler runs */
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->disable_depth++;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Set the trigger condition of an interrupt line. The lines are
+ * raised by software, so any condition is accepted.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param trig - New trigger condition.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	if (!desc || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Enable an interrupt line. An interrupt raised while the line was
+ * disabled is handled once the line is enabled.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+	bool pending;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->enabled |= 1ULL << irq_id;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	pending = __atomic_load_n(&ldesc->pending, __ATOMIC_ACQUIRE) &
+		  (1ULL << irq_id);
+	if (pending)
+		return linux_irq_kick(ldesc);
+
+	return 0;
+}
+
+/**
+ * @brief Disable an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->enabled &= ~(1ULL << irq_id);
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of an interrupt line. When several lines are
+ * pending, the one with the lowest priority level is handled first.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id,
+				      uint32_t priority_level)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].priority = priority_level;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Raise a software interrupt. May be called from any thread,
+ * including from an interrupt handler.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_trigger(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	__atomic_fetch_or(&ldesc->pending, 1ULL << irq_id, __ATOMIC_ACQ_REL);
+
+	return linux_irq_kick(ldesc);
+}
+
+/**
+ * @brief Drop an interrupt which was raised, but not handled yet.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t linux_irq_clear_pending(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_NB)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	__atomic_fetch_and(&ldesc->pending, ~(1ULL << irq_id), __ATOMIC_ACQ_REL);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the dispatcher thread and free the IRQ controller resources.
+ * Must not be called from an interrupt handler.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int32_t linux_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->stop = true;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	linux_irq_kick(ldesc);
+	pthread_join(ldesc->thread, NULL);
+
+	pthread_mutex_destroy(&ldesc->lock);
+	close(ldesc->efd);
+	no_os_free(ldesc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_irq_ops = {
+	.init = &linux_irq_ctrl_init,
+	.register_callback = &linux_irq_register_callback,
+	.unregister_callback = &linux_irq_unregister_callback,
+	.global_enable = &linux_irq_global_enable,
+	.global_disable = &linux_irq_global_disable,
+	.trigger_level_set = &linux_irq_trigger_level_set,
+	.enable = &linux_irq_enable,
+	.disable = &linux_irq_disable,
+	.set_priority = &linux_irq_set_priority,
+	.remove = &linux_irq_ctrl_remove
+};
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ *   @file   linux_semaphore.c
+ *   @brief  Implementation of the semaphore API for the Linux platform.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <semaphore.h>
+#include "no_os_alloc.h"
+#include "no_os_semaphore.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize semaphore. The semaphore starts without tokens, so the
+ * first take blocks until a give.
+ * @param semaphore - Pointer toward the semaphore. Left untouched if already
+ * 		      set.
+ * @return None.
+ */
+void no_os_semaphore_init(void **semaphore)
+{
+	sem_t *sem;
+
+	if (!semaphore || *semaphore)
+		return;
+
+	sem = no_os_calloc(1, sizeof(*sem));
+	if (!sem)
+		return;
+
+	if (sem_init(sem, 0, 0)) {
+		no_os_free(sem);
+		return;
+	}
+
+	*semaphore = sem;
+}
+
+/**
+ * @brief Take token from semaphore. Blocks until a token is available.
+ * @param semaphore - Pointer toward the semaphore.
+ * @return None.
+ */
+void no_os_semaphore_take(void *semaphore)
+{
+	if (!semaphore)
+		return;
+
+	while (sem_wait(semaphore) && errno == EINTR)
+		;
+}
+
+/**
+ * @brief Give token to semaphore.
+ * @param semaphore - Pointer toward the semaphore.
+ * @return None.
+ */
+void no_os_semaphore_give(void *semaphore)
+{
+	if (semaphore)
+		sem_post(semaphore);
+}
+
+/**
+ * @brief Remove semaphore.
+ * @param semaphore - Pointer toward the semaphore.
+ * @return None.
+ */
+void no_os_semaphore_remove(void *semaphore)
+{
+	if (!semaphore)
+		return;
+
+	sem_destroy(semaphore);
+	no_os_free(semaphore);
+}
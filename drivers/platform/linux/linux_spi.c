@@ -44,16 +44,34 @@
 #include "no_os_error.h"
 #include "no_os_spi.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "linux_spi.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <string.h>
 #include <linux/spi/spidev.h>
 
-#warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/**
+ * Maximum number of transfers sent with a single SPI_IOC_MESSAGE request.
+ * The ioctl size field limits it to 511.
+ */
+#ifndef LINUX_SPI_MAX_XFERS
+#define LINUX_SPI_MAX_XFERS	64
+#endif
+
+/** Default size of the spidev buffer, used if it can't be read from sysfs */
+#define LINUX_SPI_DEFAULT_BUFSIZ	4096
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -66,12 +84,61 @@
 struct linux_spi_desc {
 	/** /dev/spidev"device_id"."chip_select" file descriptor */
 	int spidev_fd;
+	/** Maximum number of bytes in a single SPI_IOC_MESSAGE request */
+	uint32_t bufsiz;
+	/** Transfers of the SPI_IOC_MESSAGE request being built */
+	struct spi_ioc_transfer xfers[LINUX_SPI_MAX_XFERS];
+	/**
+	 * Serializes the users of xfers (the caller and the worker thread) and
+	 * keeps the requests of a split list of messages together.
+	 */
+	pthread_mutex_t xfer_lock;
+	/** Worker thread sending the background transfers */
+	pthread_t thread;
+	/** Set once the worker thread was created */
+	bool thread_started;
+	/** Protects the background transfer state */
+	pthread_mutex_t lock;
+	/** Signals the worker thread */
+	pthread_cond_t cond;
+	/** Messages of the pending background transfer */
+	struct no_os_spi_msg *msgs;
+	/** Number of messages of the pending background transfer */
+	uint32_t len;
+	/** Called once the background transfer is done */
+	void (*callback)(void *, int32_t);
+	/** Parameter for the callback */
+	void *ctx;
+	/** Set when the worker thread has to exit */
+	bool stop;
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Get the maximum number of bytes spidev accepts in a single request.
+ * @return The spidev bufsiz module parameter.
+ */
+static uint32_t linux_spi_get_bufsiz(void)
+{
+	unsigned int bufsiz;
+	FILE *f;
+	int ret;
+
+	f = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+	if (!f)
+		return LINUX_SPI_DEFAULT_BUFSIZ;
+
+	ret = fscanf(f, "%u", &bufsiz);
+	fclose(f);
+	if (ret != 1 || !bufsiz)
+		return LINUX_SPI_DEFAULT_BUFSIZ;
+
+	return bufsiz;
+}
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -91,11 +158,16 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_spi_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_spi_desc*) no_os_calloc(1, sizeof(
 				struct linux_spi_desc));
 	if (!linux_desc)
 		goto free_desc;
 
+	pthread_mutex_init(&linux_desc->lock, NULL);
+	pthread_mutex_init(&linux_desc->xfer_lock, NULL);
+	pthread_cond_init(&linux_desc->cond, NULL);
+	linux_desc->bufsiz = linux_spi_get_bufsiz();
+
 	descriptor->extra = linux_desc;
 
 	snprintf(path, sizeof(path), "/dev/spidev%d.%d",
@@ -132,6 +204,9 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 
 	return 0;
 free:
+	pthread_cond_destroy(&linux_desc->cond);
+	pthread_mutex_destroy(&linux_desc->xfer_lock);
+	pthread_mutex_destroy(&linux_desc->lock);
 	no_os_free(linux_desc);
 free_desc:
 	no_os_free(descriptor);
@@ -160,8 +235,10 @@ int32_t linux_spi_write_and_read(struct no_os_spi_desc *desc,
 
 	linux_desc = desc->extra;
 
+	pthread_mutex_lock(&linux_desc->xfer_lock);
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(1), &tr);
-	if (ret == 1) {
+	pthread_mutex_unlock(&linux_desc->xfer_lock);
+	if (ret < 0) {
 		printf("%s: Can't send spi message\n\r", __func__);
 		return -1;
 	}
@@ -181,6 +258,17 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 
 	linux_desc = desc->extra;
 
+	if (linux_desc->thread_started) {
+		pthread_mutex_lock(&linux_desc->lock);
+		linux_desc->stop = true;
+		pthread_cond_signal(&linux_desc->cond);
+		pthread_mutex_unlock(&linux_desc->lock);
+		pthread_join(linux_desc->thread, NULL);
+	}
+	pthread_cond_destroy(&linux_desc->cond);
+	pthread_mutex_destroy(&linux_desc->xfer_lock);
+	pthread_mutex_destroy(&linux_desc->lock);
+
 	ret = close(linux_desc->spidev_fd);
 	if (ret < 0) {
 		printf("%s: Can't close device\n\r", __func__);
@@ -193,41 +281,227 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 	return 0;
 }
 
-static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
-				  struct no_os_spi_msg *msgs,
-				  uint32_t len)
+/**
+ * @brief Send the transfers built in the descriptor's array with a single
+ * SPI_IOC_MESSAGE request.
+ * @param linux_desc - Linux SPI descriptor.
+ * @param nb_xfers - Number of transfers in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_spi_send_xfers(struct linux_spi_desc *linux_desc,
+				    uint32_t nb_xfers)
+{
+	int ret;
+
+	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(nb_xfers),
+		    linux_desc->xfers);
+	if (ret < 0) {
+		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
+		return -errno;
+	}
+
+	return 0;
+}
 
+/**
+ * @brief Send a list of messages. The messages are coalesced in as few
+ * SPI_IOC_MESSAGE requests as the spidev limits allow, using the transfer
+ * array of the descriptor, so no memory is allocated. Must be called with
+ * xfer_lock held.
+ *
+ * cs_delay_first is inserted as an empty transfer with a delay, right after
+ * CS is asserted, and cs_delay_last is mapped to the delay_usecs of the
+ * message. spidev can't delay the CS assert following a deassert, so a
+ * message with both cs_change and cs_change_delay ends the request and the
+ * delay is done before sending the next one.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_spi_send_msgs(struct no_os_spi_desc *desc,
+				   struct no_os_spi_msg *msgs,
+				   uint32_t len)
 {
-	struct spi_ioc_transfer *tr;
 	struct linux_spi_desc	*linux_desc;
-	int			ret;
+	struct spi_ioc_transfer *tr;
+	bool			cs_active = false;
+	uint32_t		nb_xfers = 0;
+	uint32_t		bytes = 0;
 	uint32_t		i;
+	int32_t			ret;
 
 	linux_desc = desc->extra;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
-
 	for (i = 0; i < len; i++) {
-		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
-		tr[i].rx_buf = (unsigned long) msgs[i].rx_buff;
-		tr[i].len = msgs[i].bytes_number;
-		tr[i].cs_change = msgs[i].cs_change;
-		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
+		/*
+		 * Leave room for the message and its CS setup delay. A request
+		 * which is split keeps CS asserted if the message asks for it.
+		 */
+		if (nb_xfers && (nb_xfers + 2 > LINUX_SPI_MAX_XFERS ||
+				 bytes + msgs[i].bytes_number > linux_desc->bufsiz)) {
+			linux_desc->xfers[nb_xfers - 1].cs_change =
+				!msgs[i - 1].cs_change;
+			ret = linux_spi_send_xfers(linux_desc, nb_xfers);
+			if (ret)
+				return ret;
+			nb_xfers = 0;
+			bytes = 0;
+		}
+
+		if (!cs_active && msgs[i].cs_delay_first) {
+			tr = &linux_desc->xfers[nb_xfers++];
+			memset(tr, 0, sizeof(*tr));
+			tr->delay_usecs = no_os_min(msgs[i].cs_delay_first,
+						    (uint32_t)UINT16_MAX);
+		}
+
+		tr = &linux_desc->xfers[nb_xfers++];
+		memset(tr, 0, sizeof(*tr));
+		tr->tx_buf = (unsigned long) msgs[i].tx_buff;
+		tr->rx_buf = (unsigned long) msgs[i].rx_buff;
+		tr->len = msgs[i].bytes_number;
+		tr->cs_change = msgs[i].cs_change;
+		tr->delay_usecs = no_os_min(msgs[i].cs_delay_last,
+					    (uint32_t)UINT16_MAX);
+		bytes += msgs[i].bytes_number;
+		cs_active = !msgs[i].cs_change;
+
+		if (msgs[i].cs_change && msgs[i].cs_change_delay && i + 1 < len) {
+			/* CS is deasserted at the end of the request */
+			tr->cs_change = 0;
+			ret = linux_spi_send_xfers(linux_desc, nb_xfers);
+			if (ret)
+				return ret;
+			nb_xfers = 0;
+			bytes = 0;
+			usleep(msgs[i].cs_change_delay);
+		}
 	}
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
+	if (!nb_xfers)
+		return 0;
 
-	no_os_free(tr);
+	/*
+	 * cs_change on the last transfer of a request keeps CS asserted, which
+	 * is the opposite of its meaning for the other transfers.
+	 */
+	linux_desc->xfers[nb_xfers - 1].cs_change = !msgs[len - 1].cs_change;
 
-	if (ret < 0) {
-		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
-		return ret;
+	return linux_spi_send_xfers(linux_desc, nb_xfers);
+}
+
+/**
+ * @brief Send a list of messages, coalesced in as few SPI_IOC_MESSAGE
+ * requests as possible.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs,
+				  uint32_t len)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	int32_t ret;
+
+	pthread_mutex_lock(&linux_desc->xfer_lock);
+	ret = linux_spi_send_msgs(desc, msgs, len);
+	pthread_mutex_unlock(&linux_desc->xfer_lock);
+
+	return ret;
+}
+
+/**
+ * @brief Worker thread sending the background transfers.
+ * @param arg - The SPI descriptor.
+ * @return NULL
+ */
+static void *linux_spi_thread(void *arg)
+{
+	struct no_os_spi_desc *desc = arg;
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct no_os_spi_msg *msgs;
+	void (*callback)(void *, int32_t);
+	void *ctx;
+	uint32_t len;
+	int32_t ret;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	while (true) {
+		while (!linux_desc->msgs && !linux_desc->stop)
+			pthread_cond_wait(&linux_desc->cond, &linux_desc->lock);
+
+		if (linux_desc->stop)
+			break;
+
+		msgs = linux_desc->msgs;
+		len = linux_desc->len;
+		callback = linux_desc->callback;
+		ctx = linux_desc->ctx;
+		linux_desc->msgs = NULL;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		ret = linux_spi_transfer(desc, msgs, len);
+		if (callback)
+			callback(ctx, ret);
+
+		pthread_mutex_lock(&linux_desc->lock);
 	}
+	pthread_mutex_unlock(&linux_desc->lock);
 
-	return 0;
+	return NULL;
+}
+
+/**
+ * @brief Send a list of messages from a worker thread, using a single
+ * SPI_IOC_MESSAGE request, and invoke a callback once it is done.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @param callback - Called from the worker thread once the messages were sent,
+ *		     with the result of the transfer.
+ * @param ctx - Parameter for the callback.
+ * @return 0 in case of success, -EBUSY if a transfer is already pending,
+ * 	   negative error code otherwise.
+ */
+static int32_t linux_spi_transfer_async(struct no_os_spi_desc *desc,
+					struct no_os_spi_msg *msgs,
+					uint32_t len,
+					void (*callback)(void *, int32_t),
+					void *ctx)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	int32_t ret = 0;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	if (!linux_desc->thread_started) {
+		ret = -pthread_create(&linux_desc->thread, NULL,
+				      linux_spi_thread, desc);
+		if (ret)
+			goto unlock;
+		linux_desc->thread_started = true;
+	}
+
+	if (linux_desc->msgs) {
+		ret = -EBUSY;
+		goto unlock;
+	}
+
+	linux_desc->msgs = msgs;
+	linux_desc->len = len;
+	linux_desc->callback = callback;
+	linux_desc->ctx = ctx;
+	pthread_cond_signal(&linux_desc->cond);
+
+unlock:
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return ret;
 }
+
 /**
  * @brief Linux platform specific SPI platform ops structure
  */
@@ -235,5 +509,6 @@ const struct no_os_spi_platform_ops linux_spi_ops = {
 	.init = &linux_spi_init,
 	.write_and_read = &linux_spi_write_and_read,
 	.remove = &linux_spi_remove,
-	.transfer = &linux_spi_transfer
+	.transfer = &linux_spi_transfer,
+	.transfer_async = &linux_spi_transfer_async
 };
@@ -41,7 +41,7 @@
 
 #include "max32660.h"
 #include "no_os_irq.h"
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "uart.h"
 
 /**
@@ -52,6 +52,7 @@ struct irq_action {
 	void *handle;
 	void (*callback)(void *context);
 	void *ctx;
+	struct no_os_ilist_node node;
 };
 
 /**
@@ -59,7 +60,7 @@ struct irq_action {
  */
 struct event_list {
 	enum no_os_irq_event event;
-	struct no_os_list_desc *actions;
+	struct no_os_ilist_node actions;
 };
 
 /**
@@ -73,8 +74,9 @@ extern const struct no_os_irq_platform_ops max_irq_ops;
 void max_uart_callback(mxc_uart_req_t *, int);
 
 /**
- * @brief irq_action compare function
+ * @brief Find the action registered for an interrupt
  */
-int32_t irq_action_cmp(void *data1, void *data2);
+struct irq_action *max_irq_action_find(struct no_os_ilist_node *actions,
+				       uint32_t irq_id);
 
 #endif
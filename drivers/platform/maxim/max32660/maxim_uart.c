@@ -50,7 +50,7 @@
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
-#include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 #include "uart.h"
 
 /**
@@ -110,12 +110,8 @@ static int32_t max_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 		return -EINVAL;
 
 	if (desc->rx_fifo) {
-		for (i = 0; i < bytes_number; i++) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
-			if (ret)
-				return i ? (int32_t)i : -EAGAIN;
-		}
-		return i;
+		i = no_os_spsc_ring_read(desc->rx_fifo, data, bytes_number);
+		return i ? (int32_t)i : -EAGAIN;
 	}
 
 	ret = MXC_UART_Read(MXC_UART_GET_UART(desc->device_id), data,
@@ -235,7 +231,7 @@ static int32_t max_uart_write_nonblocking(struct no_os_uart_desc *desc,
 void uart_rx_callback(void *context)
 {
 	struct no_os_uart_desc *d = context;
-	lf256fifo_write(d->rx_fifo, c);
+	no_os_spsc_ring_write(d->rx_fifo, &c, 1);
 	max_uart_read_nonblocking(d, &c, 1);
 }
 
@@ -377,7 +373,8 @@ static int32_t max_uart_init(struct no_os_uart_desc **desc,
 	*desc = descriptor;
 
 	if (param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = no_os_spsc_ring_init(&descriptor->rx_fifo, 1,
+					   NO_OS_UART_RX_FIFO_SIZE);
 		if (ret)
 			goto error;
 
@@ -448,8 +445,7 @@ static int32_t max_uart_remove(struct no_os_uart_desc *desc)
 					      MXC_UART_GET_IRQ(desc->device_id),
 					      &discard);
 		no_os_irq_ctrl_remove(extra->nvic);
-		lf256fifo_remove(desc->rx_fifo);
-		no_os_free(desc->rx_fifo);
+		no_os_spsc_ring_remove(desc->rx_fifo);
 	}
 
 	MXC_UART_Shutdown(MXC_UART_GET_UART(desc->device_id));
@@ -45,7 +45,7 @@
 #include "no_os_util.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
-#include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 #include "gcr_regs.h"
 #include "mxc_sys.h"
 #include "mxc_delay.h"
@@ -51,31 +51,48 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
+/** Event list entry, with an empty action list */
+#define MAX_IRQ_EVENT(_event)	[_event] = { \
+	.event = _event, \
+	.actions = NO_OS_ILIST_HEAD_INIT(_events[_event].actions), \
+}
+
 static struct event_list _events[] = {
-	[NO_OS_EVT_GPIO] = {.event = NO_OS_EVT_GPIO},
-	[NO_OS_EVT_UART_TX_COMPLETE] = {.event = NO_OS_EVT_UART_TX_COMPLETE},
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE},
-	[NO_OS_EVT_UART_ERROR] = {.event = NO_OS_EVT_UART_ERROR},
-	[NO_OS_EVT_RTC] = {.event = NO_OS_EVT_RTC},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED},
-	[NO_OS_EVT_DMA_RX_COMPLETE] = {.event = NO_OS_EVT_DMA_RX_COMPLETE},
-	[NO_OS_EVT_DMA_TX_COMPLETE] = {.event = NO_OS_EVT_DMA_TX_COMPLETE},
-	[NO_OS_EVT_USB] = {.event = NO_OS_EVT_USB},
+	MAX_IRQ_EVENT(NO_OS_EVT_GPIO),
+	MAX_IRQ_EVENT(NO_OS_EVT_UART_TX_COMPLETE),
+	MAX_IRQ_EVENT(NO_OS_EVT_UART_RX_COMPLETE),
+	MAX_IRQ_EVENT(NO_OS_EVT_UART_ERROR),
+	MAX_IRQ_EVENT(NO_OS_EVT_RTC),
+	MAX_IRQ_EVENT(NO_OS_EVT_TIM_ELAPSED),
+	MAX_IRQ_EVENT(NO_OS_EVT_DMA_RX_COMPLETE),
+	MAX_IRQ_EVENT(NO_OS_EVT_DMA_TX_COMPLETE),
+	MAX_IRQ_EVENT(NO_OS_EVT_USB),
 };
 
 extern mxc_uart_req_t uart_irq_state[MXC_UART_INSTANCES];
 extern bool is_callback;
 
 /**
- * @brief Action comparator function
- * @param data1 - List element
- * @param data2 - Key
- * @return 0 if the two are equal, any other integer otherwise
+ * @brief Find the action registered for an interrupt. The actions are linked
+ * in the event list, so the lookup from the interrupt handlers does not
+ * allocate.
+ * @param actions - Head of the event action list
+ * @param irq_id - The interrupt vector entry id
+ * @return The action, NULL if none is registered
  */
-int32_t irq_action_cmp(void *data1, void *data2)
+struct irq_action *max_irq_action_find(struct no_os_ilist_node *actions,
+				       uint32_t irq_id)
 {
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
+	struct no_os_ilist_node *pos;
+	struct irq_action *action;
+
+	no_os_ilist_for_each(pos, actions) {
+		action = no_os_ilist_entry(pos, struct irq_action, node);
+		if (action->irq_id == irq_id)
+			return action;
+	}
+
+	return NULL;
 }
 
 /**
@@ -100,13 +117,12 @@ static bool is_gpio_irq_id(uint32_t irq_id)
  */
 static void _timer_common_callback(mxc_tmr_regs_t *tmr)
 {
-	int ret;
-	struct irq_action key = {.irq_id = MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr))};
+	uint32_t irq_id = MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr));
 	struct irq_action *action;
 	struct event_list *evt_list = &_events[NO_OS_EVT_TIM_ELAPSED];
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
-	if (ret)
+	action = max_irq_action_find(&evt_list->actions, irq_id);
+	if (!action)
 		return;
 
 	if (action->callback)
@@ -189,23 +205,18 @@ static void max_dma_handler(uint32_t ch_num)
 	struct event_list *rx_evt_list = &_events[NO_OS_EVT_DMA_RX_COMPLETE];
 	struct event_list *tx_evt_list = &_events[NO_OS_EVT_DMA_TX_COMPLETE];
 	struct irq_action *rx_action, *tx_action;
-	struct irq_action key = {.irq_id = max_dma_get_irq(0, ch_num)};
-	int ret;
+	uint32_t irq_id = max_dma_get_irq(0, ch_num);
 
 	/* Clear the DMA interrupt flag */
 	MAX_DMA->ch[ch_num].st |= NO_OS_BIT(2);
 
-	if (rx_evt_list->actions) {
-		ret = no_os_list_read_find(rx_evt_list->actions, (void **)&rx_action, &key);
-		if (!ret && rx_action->callback)
-			rx_action->callback(rx_action->ctx);
-	}
+	rx_action = max_irq_action_find(&rx_evt_list->actions, irq_id);
+	if (rx_action && rx_action->callback)
+		rx_action->callback(rx_action->ctx);
 
-	if (tx_evt_list->actions) {
-		ret = no_os_list_read_find(tx_evt_list->actions, (void **)&tx_action, &key);
-		if (!ret && tx_action->callback)
-			tx_action->callback(tx_action->ctx);
-	}
+	tx_action = max_irq_action_find(&tx_evt_list->actions, irq_id);
+	if (tx_action && tx_action->callback)
+		tx_action->callback(tx_action->ctx);
 }
 
 void DMA0_IRQHandler()
@@ -290,17 +301,18 @@ void DMA15_IRQHandler()
 
 void RTC_IRQHandler()
 {
-	int ret;
 	uint32_t flags = MXC_RTC_GetFlags();
 	struct event_list *evt_list = &_events[NO_OS_EVT_RTC];
+	struct no_os_ilist_node *node;
 	struct irq_action *action;
 
 	if (flags & MXC_RTC_INT_FL_LONG) {
 		MXC_RTC_ClearFlags(MXC_RTC_INT_FL_LONG);
-		ret = no_os_list_read_first(evt_list->actions, (void **)&action);
-		if (ret < 0)
+		node = no_os_ilist_first(&evt_list->actions);
+		if (!node)
 			return;
 
+		action = no_os_ilist_entry(node, struct irq_action, node);
 		if (action->callback)
 			action->callback(action->ctx);
 	}
@@ -308,13 +320,11 @@ void RTC_IRQHandler()
 
 void USB_IRQHandler(void)
 {
-	int ret;
-	struct irq_action key = {.irq_id = USB_IRQn};
 	struct irq_action *action;
 	struct event_list *evt_list = &_events[NO_OS_EVT_USB];
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
-	if (ret)
+	action = max_irq_action_find(&evt_list->actions, USB_IRQn);
+	if (!action)
 		return;
 
 	if (action->callback)
@@ -332,8 +342,6 @@ void max_uart_callback(mxc_uart_req_t *req, int result)
 	struct event_list *ee;
 	struct irq_action *a;
 	uint32_t uart_id = MXC_UART_GET_IDX(req->uart);
-	struct irq_action key = {.irq_id = MXC_UART_GET_IRQ(uart_id)};
-	int ret;
 
 	if (result)
 		ee = &_events[NO_OS_EVT_UART_ERROR];
@@ -344,8 +352,8 @@ void max_uart_callback(mxc_uart_req_t *req, int result)
 	else
 		return;
 
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret)
+	a = max_irq_action_find(&ee->actions, MXC_UART_GET_IRQ(uart_id));
+	if (!a)
 		return;
 
 	uart_irq_state[uart_id].uart = NULL;
@@ -389,15 +397,14 @@ int32_t max_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
  */
 int32_t max_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	void *discard;
+	struct no_os_ilist_node *node;
+
 	if (!desc)
 		return -EINVAL;
 
 	for (uint32_t i = 0; i < NO_OS_ARRAY_SIZE(_events); i++) {
-		while (0 == no_os_list_get_first(_events[i].actions, &discard))
-			free(discard);
-		no_os_list_remove(_events[i].actions);
-		_events[i].actions = NULL;
+		while ((node = no_os_ilist_get_first(&_events[i].actions)))
+			no_os_free(no_os_ilist_entry(node, struct irq_action, node));
 	}
 	free(desc);
 
@@ -417,10 +424,8 @@ int32_t max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 				  struct no_os_callback_desc *callback_desc)
 {
 	int ret;
-	void *discard;
 	bool new_action = false;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 
 	if(is_gpio_irq_id(irq_id))
 		return -ENOSYS;
@@ -429,22 +434,13 @@ int32_t max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	    || callback_desc->event >= NO_OS_ARRAY_SIZE(_events))
 		return -EINVAL;
 
-	if (_events[callback_desc->event].actions == NULL) {
-		ret = no_os_list_init(&_events[callback_desc->event].actions,
-				      NO_OS_LIST_PRIORITY_LIST,
-				      irq_action_cmp);
-		if (ret)
-			return ret;
-	}
-
-	ret = no_os_list_read_find(_events[callback_desc->event].actions,
-				   (void **)&action,
-				   &action_key);
+	action = max_irq_action_find(&_events[callback_desc->event].actions,
+				     irq_id);
 	/*
 	 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
 	 * otherwise update
 	 */
-	if (ret) {
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
@@ -454,10 +450,8 @@ int32_t max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		action->callback = callback_desc->callback;
 		action->ctx = callback_desc->ctx;
 
-		ret = no_os_list_add_last(_events[callback_desc->event].actions, action);
-		if (ret)
-			goto free_action;
-
+		no_os_ilist_add_last(&_events[callback_desc->event].actions,
+				     &action->node);
 		new_action = true;
 	}
 
@@ -498,9 +492,8 @@ int32_t max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	return 0;
 
 remove_new_action:
-	no_os_list_get_last(_events[callback_desc->event].actions, &discard);
-free_action:
-	free(action);
+	no_os_ilist_del(&action->node);
+	no_os_free(action);
 	return ret;
 }
 
@@ -514,22 +507,16 @@ free_action:
 int32_t max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				    uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	int ret;
-	void *discard_action = NULL;
-	struct irq_action action_key= {.irq_id = irq_id};
+	struct irq_action *action;
 
 	if(is_gpio_irq_id(irq_id))
 		return -ENOSYS;
 
-	if (!desc || !cb)
+	if (!desc || !cb || cb->event >= NO_OS_ARRAY_SIZE(_events))
 		return -EINVAL;
 
 	switch (cb->peripheral) {
-	case NO_OS_UART_IRQ:
-		action_key.handle = cb->handle;
-		break;
 	case NO_OS_RTC_IRQ:
-		action_key.handle = MXC_RTC;
 		MXC_RTC_DisableInt(MXC_RTC_INT_EN_LONG);
 		break;
 	case NO_OS_TIM_IRQ:
@@ -539,14 +526,14 @@ int32_t max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		break;
 	}
 
-	ret = no_os_list_get_find(_events[cb->event].actions, &discard_action,
-				  &action_key);
-	if (ret)
+	action = max_irq_action_find(&_events[cb->event].actions, irq_id);
+	if (!action)
 		return -ENODEV;
 
-	free(discard_action);
+	no_os_ilist_del(&action->node);
+	no_os_free(action);
 
-	return ret;
+	return 0;
 }
 
 /**
@@ -41,7 +41,7 @@
 /************************* Include Files **************************************/
 /******************************************************************************/
 #include "no_os_error.h"
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
@@ -56,6 +56,7 @@
  * @brief Struct used to store a (peripheral, callback) pair
  */
 struct irq_action {
+	struct no_os_ilist_node node;
 	uint32_t irq_id;
 	void (*callback)(void *context);
 	void *ctx;
@@ -64,19 +65,32 @@ struct irq_action {
 /******************************************************************************/
 /***************************** Static variables *******************************/
 /******************************************************************************/
-static struct no_os_list_desc *actions;
-
-static int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
-}
+static struct no_os_ilist_node actions = NO_OS_ILIST_HEAD_INIT(actions);
 
 static bool initialized = false;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
+/**
+ * @brief Find the action registered for a pin
+ * @param irq_id - Pin id.
+ * @return The action, or NULL if none is registered.
+ */
+static struct irq_action *pico_gpio_irq_action_find(uint32_t irq_id)
+{
+	struct no_os_ilist_node *pos;
+	struct irq_action *action;
+
+	no_os_ilist_for_each(pos, &actions) {
+		action = no_os_ilist_entry(pos, struct irq_action, node);
+		if (action->irq_id == irq_id)
+			return action;
+	}
+
+	return NULL;
+}
+
 /**
  * @brief GPIO interrupt handler callback
  * @param pin pin number on which the interrupt occurred
@@ -84,16 +98,10 @@ static bool initialized = false;
  */
 void pico_gpio_callback(unsigned int pin, uint32_t events)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
-
-	key.irq_id = pin;
-	ret = no_os_list_read_find(actions, (void **)&action, &key);
-	if (ret)
-		return;
 
-	if (action->callback)
+	action = pico_gpio_irq_action_find(pin);
+	if (action && action->callback)
 		action->callback(action->ctx);
 }
 
@@ -128,10 +136,6 @@ static int32_t pico_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 		gpio_irq_desc->extra = pico_gpio_irq;
 		gpio_irq_desc->irq_ctrl_id = param->irq_ctrl_id;
 
-		ret = no_os_list_init(&actions, NO_OS_LIST_PRIORITY_LIST, irq_action_cmp);
-		if (ret)
-			goto error;
-
 		initialized = true;
 	}
 
@@ -140,9 +144,7 @@ static int32_t pico_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 	return 0;
 
 error:
-	no_os_list_remove(actions);
 	no_os_free(gpio_irq_desc);
-	no_os_free(pico_gpio_irq);
 	return ret;
 }
 
@@ -153,15 +155,13 @@ error:
  */
 static int32_t pico_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	struct no_os_callback_desc *discard;
+	struct no_os_ilist_node *node;
 
 	if (!desc)
 		return -EINVAL;
 
-	while (0 == no_os_list_get_first(actions, (void **)&discard))
-		no_os_free(discard);
-
-	no_os_list_remove(actions);
+	while ((node = no_os_ilist_get_first(&actions)))
+		no_os_free(no_os_ilist_entry(node, struct irq_action, node));
 
 	initialized = false;
 
@@ -223,9 +223,7 @@ static int32_t pico_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		uint32_t irq_id,
 		struct no_os_callback_desc *cb)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 	struct pico_gpio_irq_desc *pico_gpio_irq;
 
 	if (!desc || !desc->extra || !cb  || !(irq_id < PICO_GPIO_MAX_PIN_NB))
@@ -233,35 +231,25 @@ static int32_t pico_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 
 	pico_gpio_irq = desc->extra;
 
-	ret = no_os_list_read_find(actions, (void **)&action, &action_key);
+	action = pico_gpio_irq_action_find(irq_id);
 	/* If no action was found, insert a new one, otherwise update it */
-	if (ret) {
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
 
-		action->irq_id = irq_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
-
-		ret = no_os_list_add_last(actions, action);
-		if (ret)
-			goto free_action;
-	} else {
-		action->irq_id = irq_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
+		no_os_ilist_add_last(&actions, &action->node);
 	}
 
+	action->irq_id = irq_id;
+	action->ctx = cb->ctx;
+	action->callback = cb->callback;
+
 	gpio_set_irq_enabled_with_callback(irq_id,
 					   pico_gpio_irq->pin_trigger_lvl[irq_id],
 					   false,
 					   pico_gpio_callback);
 	return 0;
-
-free_action:
-	no_os_free(action);
-	return ret;
 }
 
 /**
@@ -276,9 +264,7 @@ static int32_t pico_gpio_irq_unregister_callback(
 	uint32_t irq_id,
 	struct no_os_callback_desc *cb)
 {
-	int ret;
-	struct irq_action *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = desc->irq_ctrl_id};
+	struct irq_action *discard_action;
 	struct pico_gpio_irq_desc *pico_gpio_irq;
 
 	if (!desc || !desc->extra || !(irq_id < PICO_GPIO_MAX_PIN_NB))
@@ -290,10 +276,11 @@ static int32_t pico_gpio_irq_unregister_callback(
 					   false,
 					   NULL);
 
-	ret = no_os_list_read_find(actions, (void **)&discard_action, &action_key);
-	if (ret)
+	discard_action = pico_gpio_irq_action_find(irq_id);
+	if (!discard_action)
 		return -ENODEV;
 
+	no_os_ilist_del(&discard_action->node);
 	no_os_free(discard_action);
 	return 0;
 }
@@ -42,7 +42,7 @@
 /******************************************************************************/
 
 #include "no_os_irq.h"
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_uart.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
@@ -69,11 +69,12 @@ struct irq_action {
 	void *handle;
 	void (*callback)(void *context);
 	void *ctx;
+	struct no_os_ilist_node node;
 };
 
 struct event_list {
 	enum no_os_irq_event event;
-	struct no_os_list_desc *actions;
+	struct no_os_ilist_node actions;
 };
 
 /******************************************************************************/
@@ -84,29 +85,58 @@ static bool initialized =  false;
 static uint32_t irq_enabled_mask = 0;
 
 static struct event_list _events[] = {
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED},
+	[NO_OS_EVT_UART_RX_COMPLETE] = {
+		.event = NO_OS_EVT_UART_RX_COMPLETE,
+		.actions = NO_OS_ILIST_HEAD_INIT(
+			_events[NO_OS_EVT_UART_RX_COMPLETE].actions),
+	},
+	[NO_OS_EVT_TIM_ELAPSED] = {
+		.event = NO_OS_EVT_TIM_ELAPSED,
+		.actions = NO_OS_ILIST_HEAD_INIT(
+			_events[NO_OS_EVT_TIM_ELAPSED].actions),
+	},
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Find the action registered for an interrupt. The actions are linked
+ * in the event list, so the lookup from the interrupt handlers neither
+ * allocates nor goes through the no_os_list iterator.
+ * @param evt_list - Event list.
+ * @param irq_id - Interrupt identifier.
+ * @return The action, or NULL if none is registered.
+ */
+static struct irq_action *pico_irq_action_find(struct event_list *evt_list,
+		uint32_t irq_id)
+{
+	struct no_os_ilist_node *pos;
+	struct irq_action *action;
+
+	no_os_ilist_for_each(pos, &evt_list->actions) {
+		action = no_os_ilist_entry(pos, struct irq_action, node);
+		if (action->irq_id == irq_id)
+			return action;
+	}
+
+	return NULL;
+}
+
 /**
  * @brief UART interrupt handler.
  * @param uart - UART instance.
  */
 static void _uart_common_handler(uart_inst_t *uart)
 {
-	int ret;
 	struct event_list *evt_list = &_events[NO_OS_EVT_UART_RX_COMPLETE];
 	struct irq_action *action;
 
 	uint8_t uart_irq_id = (uart == uart0) ? UART0_IRQ : UART1_IRQ;
-	struct irq_action key = {.irq_id = uart_irq_id};
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
-	if (ret)
+	action = pico_irq_action_find(evt_list, uart_irq_id);
+	if (!action)
 		return;
 
 	if (action->callback)
@@ -119,14 +149,11 @@ static void _uart_common_handler(uart_inst_t *uart)
  */
 static void _alarm_callback(uint alarm_num)
 {
-	int ret;
 	struct event_list *evt_list = &_events[NO_OS_EVT_TIM_ELAPSED];
 	struct irq_action *action;
 
-	struct irq_action key = {.irq_id = alarm_num};
-
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
-	if (ret)
+	action = pico_irq_action_find(evt_list, alarm_num);
+	if (!action)
 		return;
 
 	if (action->callback)
@@ -154,18 +181,6 @@ void on_uart1_rx(void)
 		_uart_common_handler(uart1);
 }
 
-/**
- * @brief Action comparator function.
- * @param data1 - List element.
- * @param data2 - Key.
- * @return 0 if the two are equal, any other integer otherwise.
- */
-int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
-}
-
 /**
  * @brief Initialized the controller for pico external interrupts.
  * @param desc  - Pointer where the configured instance is stored.
@@ -235,26 +250,13 @@ int32_t pico_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 				   uint32_t irq_id,
 				   struct no_os_callback_desc *cb)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 
 	switch (cb->peripheral) {
 	case NO_OS_UART_IRQ:
 		/* Set up the interrupt handler */
 		irq_set_exclusive_handler(irq_id,
 					  cb->handle == uart0 ? on_uart0_rx : on_uart1_rx);
-
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret) {
-				irq_remove_handler(irq_id,
-						   cb->handle == uart0 ? on_uart0_rx : on_uart1_rx);
-				return ret;
-			}
-		}
 		break;
 	case NO_OS_TIM_IRQ:
 		/* Set up the interrupt handler */
@@ -262,50 +264,29 @@ int32_t pico_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		/* By default, disable alarm irq.
 		The user shall enable the interrupt when seen fit. */
 		irq_set_enabled(irq_id, false);
-
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret) {
-				hardware_alarm_set_callback(irq_id, NULL);
-				return ret;
-			}
-		}
 		break;
 	default:
 		return -EINVAL;
 	}
 
-	ret = no_os_list_read_find(_events[cb->event].actions,
-				   (void **)&action,
-				   &action_key);
+	action = pico_irq_action_find(&_events[cb->event], irq_id);
 	/*
 	 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
 	 * otherwise update
 	 */
-	if (ret) {
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
 
-		action->irq_id = irq_id;
-		action->handle = cb->handle;
-		action->callback = cb->callback;
-		action->ctx = cb->ctx;
-
-		ret = no_os_list_add_last(_events[cb->event].actions, action);
-		if (ret) {
-			no_os_free(action);
-			return ret;
-		}
-	} else {
-		action->irq_id = irq_id;
-		action->handle = cb->handle;
-		action->callback = cb->callback;
-		action->ctx = cb->ctx;
+		no_os_ilist_add_last(&_events[cb->event].actions, &action->node);
 	}
 
+	action->irq_id = irq_id;
+	action->handle = cb->handle;
+	action->callback = cb->callback;
+	action->ctx = cb->ctx;
+
 	return 0;
 }
 
@@ -319,17 +300,15 @@ int32_t pico_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 int32_t pico_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				     uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	int ret;
-	void *discard;
-	struct irq_action key;
+	struct irq_action *action;
 
-	key.handle = cb->handle;
-	ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
-	if (ret)
-		return ret;
+	action = pico_irq_action_find(&_events[cb->event], irq_id);
+	if (!action)
+		return -ENOENT;
 
+	no_os_ilist_del(&action->node);
 	irq_remove_handler(irq_id, NULL);
-	no_os_free(discard);
+	no_os_free(action);
 
 	return 0;
 }
@@ -43,7 +43,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <errno.h>
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
@@ -65,38 +65,49 @@ struct irq_action {
 	uint32_t irq_id;
 	void (*callback)(void *context);
 	void *ctx;
+	struct no_os_ilist_node node;
 };
 
 /******************************************************************************/
 /***************************** Static variables *******************************/
 /******************************************************************************/
-static struct no_os_list_desc *actions;
-
-static int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
-}
+static struct no_os_ilist_node actions = NO_OS_ILIST_HEAD_INIT(actions);
 
 static bool initialized[STM32_IRQ_CTRL_NB] =  {false};
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
+/**
+ * @brief Find the action registered for a pin. The actions are linked in the
+ * list, so the lookup from the interrupt handlers does not allocate.
+ * @param irq_id - Pin number.
+ * @return The action, NULL if none is registered.
+ */
+static struct irq_action *stm32_gpio_irq_action_find(uint32_t irq_id)
+{
+	struct no_os_ilist_node *pos;
+	struct irq_action *action;
+
+	no_os_ilist_for_each(pos, &actions) {
+		action = no_os_ilist_entry(pos, struct irq_action, node);
+		if (action->irq_id == irq_id)
+			return action;
+	}
+
+	return NULL;
+}
+
 /**
  * @brief Generic Interrupt handler callback
  * @param pin pin number on which the interrupt occurred (GPIO_PIN_pin)
  */
 static inline void stm32_handle_generic_callback(uint16_t pin)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
-
-	key.irq_id = no_os_find_first_set_bit(pin);
 
-	ret = no_os_list_read_find(actions, (void **)&action, &key);
-	if (ret)
+	action = stm32_gpio_irq_action_find(no_os_find_first_set_bit(pin));
+	if (!action)
 		return;
 
 	if (action->callback)
@@ -141,7 +152,6 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 {
 	static struct no_os_irq_ctrl_desc *gpio_irq_desc_arr[STM32_IRQ_CTRL_NB];
 
-	int ret;
 	struct no_os_irq_ctrl_desc *gpio_irq_desc;
 	struct stm32_gpio_irq_desc *sdesc;
 	struct stm32_gpio_irq_init_param *gpio_irq_ip;
@@ -167,8 +177,8 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 
 		sdesc = (struct stm32_gpio_irq_desc*)no_os_calloc(1, sizeof(*sdesc));
 		if (!sdesc) {
-			ret = -ENOMEM;
-			goto error;
+			no_os_free(gpio_irq_desc);
+			return -ENOMEM;
 		}
 		/* Add port number */
 		sdesc->port_nb = gpio_irq_ip->port_nb;
@@ -176,10 +186,6 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 		gpio_irq_desc->extra = sdesc;
 		gpio_irq_desc->irq_ctrl_id = param->irq_ctrl_id;
 
-		ret = no_os_list_init(&actions, NO_OS_LIST_PRIORITY_LIST, irq_action_cmp);
-		if (ret)
-			goto error;
-
 		gpio_irq_desc_arr[param->irq_ctrl_id] = gpio_irq_desc;
 		initialized[param->irq_ctrl_id] = true;
 	}
@@ -187,12 +193,6 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 	*desc = gpio_irq_desc_arr[param->irq_ctrl_id];
 
 	return 0;
-error:
-	no_os_list_remove(actions);
-	no_os_free(gpio_irq_desc);
-	no_os_free(sdesc);
-
-	return ret;
 }
 
 /**
@@ -202,15 +202,16 @@ error:
  */
 static int32_t stm32_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	struct no_os_callback_desc *discard;
+	struct irq_action *action;
 
 	if (!desc)
 		return -EINVAL;
 
-	while (0 == no_os_list_get_first(actions, (void **)&discard))
-		no_os_free(discard);
-
-	no_os_list_remove(actions);
+	action = stm32_gpio_irq_action_find(desc->irq_ctrl_id);
+	if (action) {
+		no_os_ilist_del(&action->node);
+		no_os_free(action);
+	}
 
 	initialized[desc->irq_ctrl_id] = false;
 
@@ -282,7 +283,6 @@ static int32_t stm32_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
 {
 	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = desc->irq_ctrl_id};
 	struct stm32_gpio_irq_desc *sdesc;
 
 	if (!desc || !desc->extra || !cb || !IS_EXTI_GPIO_PIN(desc->irq_ctrl_id))
@@ -290,28 +290,22 @@ static int32_t stm32_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
 
 	sdesc = desc->extra;
 
-	ret = no_os_list_read_find(actions, (void **)&action, &action_key);
+	action = stm32_gpio_irq_action_find(desc->irq_ctrl_id);
 	/*
 	* If no action was found, insert a new one, otherwise update it
 	*/
-	if (ret) {
+	if (!action) {
 		action = no_os_calloc(1, sizeof(*action));
 		if (!action)
 			return -ENOMEM;
 
-		action->irq_id = desc->irq_ctrl_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
-
-		ret = no_os_list_add_last(actions, action);
-		if (ret)
-			goto free_action;
-	} else {
-		action->irq_id = desc->irq_ctrl_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
+		no_os_ilist_add_last(&actions, &action->node);
 	}
 
+	action->irq_id = desc->irq_ctrl_id;
+	action->ctx = cb->ctx;
+	action->callback = cb->callback;
+
 	EXTI_ConfigTypeDef config;
 	config.Mode = EXTI_MODE_INTERRUPT;
 	config.GPIOSel = sdesc->port_nb;
@@ -325,6 +319,7 @@ static int32_t stm32_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
 	return 0;
 
 free_action:
+	no_os_ilist_del(&action->node);
 	no_os_free(action);
 	return ret;
 }
@@ -340,18 +335,17 @@ static int32_t stm32_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc
 		*desc,
 		uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	int ret;
-	struct irq_action *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = desc->irq_ctrl_id};
+	struct irq_action *action;
 
 	if (!desc || !cb || !IS_EXTI_GPIO_PIN(desc->irq_ctrl_id))
 		return -EINVAL;
 
-	ret = no_os_list_read_find(actions, (void **)&discard_action, &action_key);
-	if (ret)
+	action = stm32_gpio_irq_action_find(desc->irq_ctrl_id);
+	if (!action)
 		return -ENODEV;
 
-	no_os_free(discard_action);
+	no_os_ilist_del(&action->node);
+	no_os_free(action);
 	return 0;
 }
 
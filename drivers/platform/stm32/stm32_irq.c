@@ -44,7 +44,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <errno.h>
-#include "no_os_list.h"
+#include "no_os_ilist.h"
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
@@ -54,12 +54,14 @@ struct irq_action {
 	void *handle;
 	void (*callback)(void *context);
 	void *ctx;
+	struct no_os_ilist_node node;
 };
 
 struct event_list {
 	enum no_os_irq_event event;
 	uint32_t hal_event;
-	struct no_os_list_desc *actions;
+	/* Zeroed until the first callback is registered for the event */
+	struct no_os_ilist_node actions;
 };
 
 static bool initialized =  false;
@@ -79,10 +81,60 @@ static struct event_list _events[] = {
 #endif
 };
 
-static int32_t irq_action_cmp(void *data1, void *data2)
+/**
+ * @brief Find the action registered for a peripheral handle. The actions are
+ * linked in the event list, so the lookup from the HAL callbacks does not
+ * allocate.
+ * @param ee - Event list.
+ * @param handle - HAL handle of the peripheral.
+ * @return The action, NULL if none is registered.
+ */
+static struct irq_action *stm32_irq_action_find(struct event_list *ee,
+		void *handle)
 {
-	return (int32_t)((struct irq_action *)data1)->handle -
-	       (int32_t)((struct irq_action *)data2)->handle;
+	struct no_os_ilist_node *pos;
+	struct irq_action *a;
+
+	if (!ee->actions.next)
+		return NULL;
+
+	no_os_ilist_for_each(pos, &ee->actions) {
+		a = no_os_ilist_entry(pos, struct irq_action, node);
+		if (a->handle == handle)
+			return a;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Add the action of a callback to an event list, or update the one
+ * already registered for the same handle.
+ * @param ee - Event list.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, -ENOMEM otherwise.
+ */
+static int stm32_irq_action_add(struct event_list *ee,
+				struct no_os_callback_desc *cb)
+{
+	struct irq_action *a;
+
+	a = stm32_irq_action_find(ee, cb->handle);
+	if (!a) {
+		a = no_os_calloc(1, sizeof(*a));
+		if (!a)
+			return -ENOMEM;
+
+		if (!ee->actions.next)
+			no_os_ilist_init(&ee->actions);
+		no_os_ilist_add_last(&ee->actions, &a->node);
+	}
+
+	a->handle = cb->handle;
+	a->callback = cb->callback;
+	a->ctx = cb->ctx;
+
+	return 0;
 }
 
 #ifdef HAL_TIM_MODULE_ENABLED
@@ -90,12 +142,10 @@ void HAL_TIM_PeriodElapsedCallback (TIM_HandleTypeDef *htim)
 {
 	struct event_list *ee = &_events[NO_OS_EVT_TIM_ELAPSED];
 	struct irq_action *a;
-	struct irq_action key = {.handle = htim};
-	int ret;
 
 	/* Find & call callback */
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret < 0)
+	a = stm32_irq_action_find(ee, htim);
+	if (!a)
 		return;
 
 	if(a->callback)
@@ -106,12 +156,10 @@ void HAL_TIM_PWM_PulseFinishedCallback (TIM_HandleTypeDef *htim)
 {
 	struct event_list *ee = &_events[NO_OS_EVT_TIM_PWM_PULSE_FINISHED];
 	struct irq_action *a;
-	struct irq_action key = {.handle = htim};
-	int ret;
 
 	/* Find & call callback */
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret < 0)
+	a = stm32_irq_action_find(ee, htim);
+	if (!a)
 		return;
 
 	if(a->callback)
@@ -124,10 +172,9 @@ static inline void _common_uart_callback(UART_HandleTypeDef *huart,
 {
 	struct event_list *ue = &_events[no_os_event];
 	struct irq_action *a;
-	struct irq_action key = {.handle = huart};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
+
+	a = stm32_irq_action_find(ue, huart);
+	if (!a)
 		return;
 
 	if(a->callback)
@@ -140,10 +187,9 @@ static inline void _common_sai_dma_callback(SAI_HandleTypeDef *hsai,
 {
 	struct event_list *ue = &_events[no_os_event];
 	struct irq_action *a;
-	struct irq_action key = {.handle = hsai};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
+
+	a = stm32_irq_action_find(ue, hsai);
+	if (!a)
 		return;
 
 	if(a->callback)
@@ -157,10 +203,9 @@ static inline void _common_tim_dma_callback(DMA_HandleTypeDef *hdma,
 {
 	struct event_list *ue = &_events[no_os_event];
 	struct irq_action *a;
-	struct irq_action key = {.handle = hdma};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
+
+	a = stm32_irq_action_find(ue, hdma);
+	if (!a)
 		return;
 
 	if(a->callback)
@@ -289,12 +334,10 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 #endif
 #ifdef HAL_TIM_MODULE_ENABLED
 	pTIM_CallbackTypeDef pTimCallback;
-	struct irq_action action_key = {.handle = cb->handle};
 #ifdef HAL_DMA_MODULE_ENABLED
 	DMA_HandleTypeDef pDmaCallback;
 #endif
 #endif
-	struct irq_action *li;
 	uint32_t hal_event = _events[cb->event].hal_event;
 
 	switch (cb->peripheral) {
@@ -319,25 +362,7 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			break;
 		}
 
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret < 0)
-				return ret;
-		}
-
-		li = no_os_calloc(1, sizeof(struct irq_action));
-		if(!li)
-			return -ENOMEM;
-
-		li->handle = cb->handle;
-		li->callback = cb->callback;
-		li->ctx = cb->ctx;
-		ret = no_os_list_add_last(_events[cb->event].actions, li);
-		if (ret < 0) {
-			no_os_free(li);
-			return ret;
-		}
+		ret = stm32_irq_action_add(&_events[cb->event], cb);
 		break;
 #ifdef HAL_TIM_MODULE_ENABLED
 	case NO_OS_TIM_IRQ:
@@ -357,38 +382,7 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			ret = -EFAULT;
 			break;
 		}
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret < 0)
-				return ret;
-		}
-
-		ret = no_os_list_read_find(_events[cb->event].actions,
-					   (void**)&li,
-					   &action_key);
-		/*
-		 * If an action with the same handle as the function parameter does not exists, insert a new one,
-		 * otherwise update
-		 */
-		if (ret) {
-			li = no_os_calloc(1, sizeof(struct irq_action));
-			if(!li)
-				return -ENOMEM;
-
-			li->handle = cb->handle;
-			li->callback = cb->callback;
-			li->ctx = cb->ctx;
-			ret = no_os_list_add_last(_events[cb->event].actions, li);
-			if (ret < 0) {
-				no_os_free(li);
-				return ret;
-			}
-		} else {
-			li->handle = cb->handle;
-			li->callback = cb->callback;
-			li->ctx = cb->ctx;
-		}
+		ret = stm32_irq_action_add(&_events[cb->event], cb);
 		break;
 #endif
 #if defined(HAL_DMA_MODULE_ENABLED) && defined(HAL_SAI_MODULE_ENABLED)
@@ -397,25 +391,7 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		case HAL_DMA_XFER_CPLT_CB_ID:
 			pSaiDmaCallback = _SAIRxCpltCallback;
 			ret = HAL_SAI_RegisterCallback(cb->handle, hal_event, pSaiDmaCallback);
-			if (_events[cb->event].actions == NULL) {
-				ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-						      irq_action_cmp);
-				if (ret < 0)
-					return ret;
-			}
-
-			li = no_os_calloc(1, sizeof(struct irq_action));
-			if(!li)
-				return -ENOMEM;
-
-			li->handle = cb->handle;
-			li->callback = cb->callback;
-			li->ctx = cb->ctx;
-			ret = no_os_list_add_last(_events[cb->event].actions, li);
-			if (ret < 0) {
-				no_os_free(li);
-				return ret;
-			}
+			ret = stm32_irq_action_add(&_events[cb->event], cb);
 			break;
 		case HAL_DMA_XFER_HALFCPLT_CB_ID:
 			pSaiDmaCallback = _SAI_RxHalfCpltCallback;
@@ -424,24 +400,7 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 				ret = -EFAULT;
 				break;
 			}
-			if (_events[cb->event].actions == NULL) {
-				ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-						      irq_action_cmp);
-				if (ret < 0)
-					return ret;
-			}
-			li = no_os_calloc(1, sizeof(struct irq_action));
-			if(!li)
-				return -ENOMEM;
-
-			li->handle = cb->handle;
-			li->callback = cb->callback;
-			li->ctx = cb->ctx;
-			ret = no_os_list_add_last(_events[cb->event].actions, li);
-			if (ret < 0) {
-				no_os_free(li);
-				return ret;
-			}
+			ret = stm32_irq_action_add(&_events[cb->event], cb);
 			break;
 		}
 		break;
@@ -471,25 +430,7 @@ int32_t stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			return -EINVAL;
 		};
 
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret < 0)
-				return ret;
-		}
-
-		li = no_os_calloc(1, sizeof(struct irq_action));
-		if(!li)
-			return -ENOMEM;
-
-		li->handle = cb->handle;
-		li->callback = cb->callback;
-		li->ctx = cb->ctx;
-		ret = no_os_list_add_last(_events[cb->event].actions, li);
-		if (ret < 0) {
-			no_os_free(li);
-			return ret;
-		}
+		ret = stm32_irq_action_add(&_events[cb->event], cb);
 		break;
 #endif
 
@@ -512,26 +453,21 @@ int32_t stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				      uint32_t irq_id, struct no_os_callback_desc *cb)
 {
 	int ret;
-	void *discard;
-	struct irq_action key;
+	struct irq_action *a;
 	uint32_t hal_event = _events[cb->event].hal_event;
 
+	a = stm32_irq_action_find(&_events[cb->event], cb->handle);
+	if (!a)
+		return -ENODEV;
+
 	switch (cb->peripheral) {
 	case NO_OS_UART_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
-		if (ret < 0)
-			break;
 		ret = HAL_UART_UnRegisterCallback(cb->handle, hal_event);
 		if (ret != HAL_OK)
 			ret = -EFAULT;
 		break;
 #ifdef HAL_TIM_MODULE_ENABLED
 	case NO_OS_TIM_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
-		if (ret < 0)
-			break;
 		ret = HAL_TIM_UnRegisterCallback(cb->handle, hal_event);
 		if (ret != HAL_OK)
 			ret = -EFAULT;
@@ -539,10 +475,6 @@ int32_t stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 #endif
 #if defined(HAL_DMA_MODULE_ENABLED) && defined(HAL_SAI_MODULE_ENABLED)
 	case NO_OS_TDM_DMA_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
-		if (ret < 0)
-			break;
 		ret = HAL_SAI_UnRegisterCallback(cb->handle, hal_event);
 		if (ret != HAL_OK)
 			ret = -EFAULT;
@@ -550,21 +482,17 @@ int32_t stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 #endif
 #if defined (HAL_TIM_MODULE_ENABLED) && defined(HAL_DMA_MODULE_ENABLED)
 	case NO_OS_TIM_DMA_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
-		if (ret < 0)
-			break;
 		ret = HAL_DMA_UnRegisterCallback(cb->handle, hal_event);
 		if (ret != HAL_OK)
 			ret = -EFAULT;
 		break;
 #endif
 	default:
-		ret = -EINVAL;
-		break;
+		return -EINVAL;
 	}
 
-	no_os_free(discard);
+	no_os_ilist_del(&a->node);
+	no_os_free(a);
 
 	return ret;
 }
@@ -46,7 +46,7 @@
 #include "no_os_alloc.h"
 #include "no_os_irq.h"
 #include "stm32_irq.h"
-#include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 
 /**
  * @brief stm32 platform specific TDM platform ops structure
@@ -167,7 +167,8 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 	}
 
 	if(param->rx_complete_callback) {
-		ret = lf256fifo_init(&tdm_desc->rx_fifo);
+		ret = no_os_spsc_ring_init(&tdm_desc->rx_fifo, 1,
+					   NO_OS_TDM_RX_FIFO_SIZE);
 		if (ret < 0)
 			goto error;
 
@@ -224,6 +225,7 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 
 	return 0;
 error:
+	no_os_spsc_ring_remove(tdm_desc->rx_fifo);
 	no_os_free(tdm_desc);
 	no_os_free(tdesc);
 	return ret;
@@ -243,6 +245,7 @@ int32_t stm32_tdm_remove(struct no_os_tdm_desc *desc)
 
 	tdesc = desc->extra;
 	HAL_SAI_DeInit(&tdesc->hsai);
+	no_os_spsc_ring_remove(desc->rx_fifo);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -40,7 +40,7 @@
 #include <stdlib.h>
 #include "no_os_uart.h"
 #include "no_os_irq.h"
-#include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 #include "no_os_alloc.h"
 #include "stm32_irq.h"
 #include "stm32_uart.h"
@@ -51,7 +51,7 @@ static uint8_t c;
 void uart_rx_callback(void *context)
 {
 	struct no_os_uart_desc *d = context;
-	lf256fifo_write(d->rx_fifo, c);
+	no_os_spsc_ring_write(d->rx_fifo, &c, 1);
 	HAL_UART_Receive_IT(((struct stm32_uart_desc *)d->extra)->huart, &c, 1);
 }
 
@@ -130,7 +130,8 @@ static int32_t stm32_uart_init(struct no_os_uart_desc **desc,
 
 	// nonblocking uart_read
 	if(param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = no_os_spsc_ring_init(&descriptor->rx_fifo, 1,
+					   NO_OS_UART_RX_FIFO_SIZE);
 		if (ret < 0)
 			goto error;
 
@@ -199,7 +200,7 @@ static int32_t stm32_uart_remove(struct no_os_uart_desc *desc)
 	HAL_UART_DeInit(sud->huart);
 	if (desc->rx_fifo) {
 		no_os_irq_disable(sud->nvic, desc->irq_id);
-		lf256fifo_remove(desc->rx_fifo);
+		no_os_spsc_ring_remove(desc->rx_fifo);
 		desc->rx_fifo = NULL;
 		no_os_irq_unregister_callback(sud->nvic, desc->irq_id, &sud->rx_callback);
 		no_os_irq_ctrl_remove(sud->nvic);
@@ -271,13 +272,8 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	sud = desc->extra;
 
 	if (desc->rx_fifo) {
-		while(i < bytes_number) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
-			if (ret < 0)
-				return i ? i : -EAGAIN;
-			i++;
-		}
-		return i;
+		i = no_os_spsc_ring_read(desc->rx_fifo, data, bytes_number);
+		return i ? i : -EAGAIN;
 	} else {
 		ret = HAL_UART_Receive(sud->huart, (uint8_t *)data, bytes_number,
 				       sud->timeout);
@@ -0,0 +1,84 @@
+/***************************************************************************//**
+ *   @file   xilinx_critical.c
+ *   @brief  Xilinx critical section implementation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdint.h>
+#include <xil_exception.h>
+#ifdef __MICROBLAZE__
+#include <mb_interface.h>
+/* Interrupt enable bit of the MicroBlaze machine status register */
+#define XILINX_CRITICAL_MSR_IE		0x2
+#define xilinx_critical_irq_masked()	(!(mfmsr() & XILINX_CRITICAL_MSR_IE))
+#else
+#include <xpseudo_asm.h>
+/* The IRQ mask bit of CPSR (DAIF on the 64 bit cores) */
+#define xilinx_critical_irq_masked()	(mfcpsr() & XIL_EXCEPTION_IRQ)
+#endif
+#include "no_os_critical.h"
+
+/* Set if the interrupts were masked before the outermost critical section */
+static uint32_t xilinx_critical_masked;
+/* Depth of the nested critical sections */
+static uint32_t xilinx_critical_nesting;
+
+/**
+ * @brief Mask the interrupts. The previous state is saved on the outermost
+ * call.
+ * @return None.
+ */
+void no_os_critical_enter(void)
+{
+	uint32_t masked = xilinx_critical_irq_masked();
+
+	Xil_ExceptionDisable();
+
+	if (!xilinx_critical_nesting++)
+		xilinx_critical_masked = masked;
+}
+
+/**
+ * @brief Unmask the interrupts once the outermost critical section is left,
+ * unless they were masked before.
+ * @return None.
+ */
+void no_os_critical_exit(void)
+{
+	if (--xilinx_critical_nesting)
+		return;
+
+	if (!xilinx_critical_masked)
+		Xil_ExceptionEnable();
+}
@@ -43,7 +43,7 @@
 #include "xilinx_irq.h"
 #ifdef XPAR_XUARTPS_NUM_INSTANCES
 #include "no_os_irq.h"
-#include "no_os_fifo.h"
+#include "no_os_spsc_ring.h"
 #include <xil_exception.h>
 #include <xuartps.h>
 #endif
@@ -78,10 +78,9 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 		ret = no_os_irq_disable(irq_desc, xil_uart_desc->irq_id);
 		if (ret < 0)
 			return ret;
-		ret = no_os_fifo_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
-					xil_uart_desc->bytes_received);
-		if (ret < 0)
-			return ret;
+		/* Only called when the fifo is empty, all the bytes fit */
+		no_os_spsc_ring_write(xil_uart_desc->fifo, xil_uart_desc->buff,
+				      xil_uart_desc->bytes_received);
 		xil_uart_desc->bytes_received = 0;
 		switch(xil_uart_desc->type) {
 		case UART_PS:
@@ -105,12 +104,14 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 #endif // XUARTPS_H
 
 /**
- * @brief Read byte from fifo.
+ * @brief Read bytes from fifo.
  * @param desc - Instance descriptor containing a fifo element
- * @param data - read value.
- * @return 0 in case of success, -1 otherwise.
+ * @param data - read values.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read in case of success, -1 otherwise.
  */
-static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
+static int32_t xil_uart_read_bytes(struct no_os_uart_desc *desc, uint8_t *data,
+				   uint32_t bytes_number)
 {
 	struct xil_uart_desc *xil_uart_desc = desc->extra;
 #ifdef XUARTLITE_H
@@ -123,20 +124,14 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 	switch(xil_uart_desc->type) {
 	case UART_PS:
 #ifdef XUARTPS_H
-		while (xil_uart_desc->fifo == NULL) {
+		while (!no_os_spsc_ring_used(xil_uart_desc->fifo)) {
 			/* nothing in fifo, wait until something is received */
 			ret = uart_fifo_insert(desc);
 			if (ret < 0)
 				return ret;
 		}
 
-		*data = xil_uart_desc->fifo->data[xil_uart_desc->fifo_read_offset];
-		xil_uart_desc->fifo_read_offset++;
-
-		if (xil_uart_desc->fifo->len - xil_uart_desc->fifo_read_offset <= 0) {
-			xil_uart_desc->fifo_read_offset = 0;
-			xil_uart_desc->fifo = no_os_fifo_remove(xil_uart_desc->fifo);
-		}
+		return no_os_spsc_ring_read(xil_uart_desc->fifo, data, bytes_number);
 #endif // XUARTPS_H
 		break;
 	case UART_PL:
@@ -144,13 +139,15 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 		while (!(Xil_In32(instance->RegBaseAddress + XUL_STATUS_REG_OFFSET) &
 			 XUL_SR_RX_FIFO_VALID_DATA));
 		*data = Xil_In32(instance->RegBaseAddress + XUL_RX_FIFO_OFFSET);
+
+		return 1;
 #endif // XUARTLITE_H
 		break;
 	default:
 		break;
 	}
 
-	return 0;
+	return -1;
 }
 
 /**
@@ -163,11 +160,14 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 static int32_t xil_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 			     uint32_t bytes_number)
 {
-	int ret;
-	for (uint32_t i = 0; i < bytes_number; i++) {
-		ret = xil_uart_read_byte(desc, &data[i]);
+	int32_t ret;
+	uint32_t i = 0;
+
+	while (i < bytes_number) {
+		ret = xil_uart_read_bytes(desc, &data[i], bytes_number - i);
 		if (ret < 0)
 			return ret;
+		i += ret;
 	}
 
 	return bytes_number;
@@ -399,6 +399,11 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 		xil_uart_desc->instance = no_os_calloc(1, sizeof(XUartPs));
 		if (!(xil_uart_desc->instance))
 			goto error_free_xil_uart_desc;
+
+		status = no_os_spsc_ring_init(&xil_uart_desc->fifo, 1,
+					      UART_BUFF_LENGTH);
+		if (status)
+			goto error_free_instance;
 		/*
 		 * Initialize the UART driver so that it's ready to use
 		 * Look up the configuration in the config table, then initialize it.
@@ -469,6 +474,7 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 	return 0;
 
 error_free_instance:
+	no_os_spsc_ring_remove(xil_uart_desc->fifo);
 	no_os_free(xil_uart_desc->instance);
 error_free_xil_uart_desc:
 	no_os_free(xil_uart_desc);
@@ -486,6 +492,7 @@ error_free_descriptor:
 static int32_t xil_uart_remove(struct no_os_uart_desc *desc)
 {
 	struct xil_uart_desc *xil_uart_desc = desc->extra;
+	no_os_spsc_ring_remove(xil_uart_desc->fifo);
 	no_os_free(xil_uart_desc->instance);
 	no_os_free(xil_uart_desc);
 	no_os_free(desc);
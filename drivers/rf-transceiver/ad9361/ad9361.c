@@ -690,15 +690,15 @@ const char *ad9361_ensm_states[] = {
 };
 
 /**
- * SPI multiple bytes register read.
+ * SPI multiple bytes register read. The caller must hold the bus lock.
  * @param spi
  * @param reg The register address.
  * @param rbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
-			 uint8_t *rbuf, uint32_t num)
+static int32_t __ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+				  uint8_t *rbuf, uint32_t num)
 {
 	int32_t ret = 0;
 	uint16_t cmd;
@@ -712,7 +712,7 @@ int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 		return -ENOMEM;
 	rbuffer[0] = cmd >> 8;
 	rbuffer[1] = cmd & 0xFF;
-	ret = no_os_spi_write_and_read(spi, &rbuffer[0], 2 + num);
+	ret = __no_os_spi_write_and_read(spi, &rbuffer[0], 2 + num);
 
 	if (ret < 0)
 		dev_err(&spi->dev, "Read Error %"PRId32, ret);
@@ -732,6 +732,29 @@ int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 	return ret;
 }
 
+/**
+ * SPI multiple bytes register read.
+ * @param spi
+ * @param reg The register address.
+ * @param rbuf The data buffer.
+ * @param num The number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+			 uint8_t *rbuf, uint32_t num)
+{
+	int32_t ret;
+
+	ret = no_os_spi_bus_lock(spi);
+	if (ret)
+		return ret;
+
+	ret = __ad9361_spi_readm(spi, reg, rbuf, num);
+	no_os_spi_bus_unlock(spi);
+
+	return ret;
+}
+
 /**
  * SPI register read.
  * @param spi
@@ -808,14 +831,14 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 	__ad9361_spi_readf(spi, reg, mask, find_first_bit(mask))
 
 /**
- * SPI register write.
+ * SPI register write. The caller must hold the bus lock.
  * @param spi
  * @param reg The register address.
  * @param val The value of the register.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
-			 uint32_t reg, uint32_t val)
+static int32_t __ad9361_spi_write(struct no_os_spi_desc *spi,
+				  uint32_t reg, uint32_t val)
 {
 	uint8_t buf[3];
 	int32_t ret;
@@ -826,7 +849,7 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 	buf[1] = cmd & 0xFF;
 	buf[2] = val;
 
-	ret = no_os_spi_write_and_read(spi, buf, 3);
+	ret = __no_os_spi_write_and_read(spi, buf, 3);
 	if (ret < 0) {
 		dev_err(&spi->dev, "Write Error %"PRId32, ret);
 		return ret;
@@ -839,6 +862,28 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 	return 0;
 }
 
+/**
+ * SPI register write.
+ * @param spi
+ * @param reg The register address.
+ * @param val The value of the register.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
+			 uint32_t reg, uint32_t val)
+{
+	int32_t ret;
+
+	ret = no_os_spi_bus_lock(spi);
+	if (ret)
+		return ret;
+
+	ret = __ad9361_spi_write(spi, reg, val);
+	no_os_spi_bus_unlock(spi);
+
+	return ret;
+}
+
 /**
  * IIO SPI register write.
  * @param phy The AD9361 state structure.
@@ -870,14 +915,24 @@ static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
 	if (!mask)
 		return -EINVAL;
 
-	ret = ad9361_spi_readm(spi, reg, &buf, 1);
-	if (ret < 0)
+	/* Keep the other devices on the bus from accessing it in between */
+	ret = no_os_spi_bus_lock(spi);
+	if (ret)
 		return ret;
 
+	ret = __ad9361_spi_readm(spi, reg, &buf, 1);
+	if (ret < 0)
+		goto unlock;
+
 	buf &= ~mask;
 	buf |= ((val << offset) & mask);
 
-	return ad9361_spi_write(spi, reg, buf);
+	ret = __ad9361_spi_write(spi, reg, buf);
+
+unlock:
+	no_os_spi_bus_unlock(spi);
+
+	return ret;
 }
 
 /**
@@ -53,6 +53,7 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
@@ -77,6 +78,12 @@
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
 #define NO_TRIGGER				(uint32_t)-1
+/* Maximum number of blocks a client can request with BUFFERS_COUNT */
+#define IIO_MAX_BUFFERS_COUNT	4
+/* Channels of a raw scan unpacked by iio_buffer_push_raw_scan */
+#define IIO_RAW_SCAN_MAX_CHANNELS	32
+/* Longest value formatted at once: "-2147483648.4294967295 dB" */
+#define IIO_VAL_STR_MAX		32
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -162,6 +169,16 @@ struct iio_buffer_priv {
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Set if scans are stored in ring instead of cb */
+	bool			lock_free;
+	/* Lock-free storage. A reference will be found in buffer */
+	struct no_os_spsc_ring	ring;
+	/* Number of blocks requested by the application or by the client */
+	uint32_t		buffers_count;
+	/* Multi-block storage. A reference will be found in buffer */
+	struct no_os_spsc_ring	blocks;
+	/* Bytes of the oldest block in blocks that were already sent */
+	uint32_t		block_offset;
 };
 
 /**
@@ -206,6 +223,19 @@ struct iio_trig_priv {
 	bool	triggered;
 };
 
+/**
+ * @struct iio_lookup_entry
+ * @brief Entry of the name lookup table built by iio_init().
+ */
+struct iio_lookup_entry {
+	/** Array the name belongs to. NULL for unused entries */
+	const void	*scope;
+	/** Device id, trigger id, channel id or attribute name */
+	const char	*name;
+	/** Index of the element in its array */
+	uint32_t	idx;
+};
+
 struct iio_desc {
 	struct iiod_desc	*iiod;
 	struct iiod_ops		iiod_ops;
@@ -218,6 +248,12 @@ struct iio_desc {
 	uint32_t		nb_devs;
 	struct iio_trig_priv	*trigs;
 	uint32_t		nb_trigs;
+	/* Hash table used to find devices, channels and attributes by name */
+	struct iio_lookup_entry	*lookup;
+	/* Number of entries in lookup - 1. Number of entries is a power of 2 */
+	uint32_t		lookup_mask;
+	/* Channel ids referenced from lookup */
+	char			*ch_ids;
 	struct no_os_uart_desc	*uart_desc;
 	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
 	int (*send)(void *conn, uint8_t *buf, uint32_t len);
@@ -227,9 +263,72 @@ struct iio_desc {
 	struct tcp_socket_desc	*current_sock;
 	/* Instance of server socket */
 	struct tcp_socket_desc	*server;
+	/* Client socket of each iiod connection */
+	struct tcp_socket_desc	*conn_socks[IIOD_MAX_CONNECTIONS];
+	/* Maximum time to wait for network events when no connection is busy */
+	uint32_t		poll_timeout_ms;
+	/* Cleared if the network interface can't poll sockets */
+	bool			poll_supported;
 #endif
 };
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+#ifdef NO_OS_ALLOC_POOL
+
+/* Connection buffers kept in the pool, the other clients use the heap */
+#ifndef IIO_CONN_POOL_NB_BUFFERS
+#define IIO_CONN_POOL_NB_BUFFERS	2
+#endif
+
+NO_OS_DECLARE_POOL_MEM(iio_conn_buf_mem, IIOD_CONN_BUFFER_SIZE,
+		       IIO_CONN_POOL_NB_BUFFERS);
+
+static struct no_os_pool iio_conn_buf_pool =
+	NO_OS_POOL_INIT(iio_conn_buf_mem, IIOD_CONN_BUFFER_SIZE,
+			IIO_CONN_POOL_NB_BUFFERS);
+
+/* Clients connecting and leaving do not fragment the heap */
+static struct no_os_arena iio_conn_arena = {
+	.name = "iio_conn",
+	.pools = &iio_conn_buf_pool,
+	.nb_pools = 1,
+	.heap_fallback = true,
+};
+
+/**
+ * @brief Get the arena network connection buffers are allocated from.
+ * @return The arena.
+ */
+struct no_os_arena *iio_get_conn_arena(void)
+{
+	return &iio_conn_arena;
+}
+
+static inline void *iio_conn_buf_alloc(void)
+{
+	return no_os_arena_calloc(&iio_conn_arena, 1, IIOD_CONN_BUFFER_SIZE);
+}
+
+static inline void iio_conn_buf_free(void *buf)
+{
+	no_os_arena_free(&iio_conn_arena, buf);
+}
+
+#else
+
+static inline void *iio_conn_buf_alloc(void)
+{
+	return no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
+}
+
+static inline void iio_conn_buf_free(void *buf)
+{
+	no_os_free(buf);
+}
+
+#endif
+#endif
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -294,28 +393,189 @@ static inline void _print_ch_id(char *buff, struct iio_channel *ch)
 	}
 }
 
+/* FNV-1a hash of name, mixed with the scope address */
+static uint32_t iio_lookup_hash(const void *scope, const char *name)
+{
+	uint32_t hash = 2166136261u ^ (uint32_t)((uintptr_t)scope >> 2);
+
+	while (*name) {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Find the index of a name in the lookup table.
+ * @param desc - IIO descriptor.
+ * @param scope - Array the name belongs to.
+ * @param name - Name to search.
+ * @return Index of the element in scope, negative value if not found.
+ */
+static int32_t iio_lookup(struct iio_desc *desc, const void *scope,
+			  const char *name)
+{
+	struct iio_lookup_entry *entry;
+	uint32_t i;
+
+	if (!scope || !desc->lookup)
+		return -ENOENT;
+
+	i = iio_lookup_hash(scope, name) & desc->lookup_mask;
+	while (desc->lookup[i].scope) {
+		entry = &desc->lookup[i];
+		if (entry->scope == scope && !strcmp(entry->name, name))
+			return entry->idx;
+		i = (i + 1) & desc->lookup_mask;
+	}
+
+	return -ENOENT;
+}
+
+/* Add an entry in the lookup table. The first entry with a name is kept */
+static void iio_lookup_add(struct iio_desc *desc, const void *scope,
+			   const char *name, uint32_t idx)
+{
+	uint32_t i;
+
+	if (iio_lookup(desc, scope, name) >= 0)
+		return;
+
+	i = iio_lookup_hash(scope, name) & desc->lookup_mask;
+	while (desc->lookup[i].scope)
+		i = (i + 1) & desc->lookup_mask;
+
+	desc->lookup[i].scope = scope;
+	desc->lookup[i].name = name;
+	desc->lookup[i].idx = idx;
+}
+
+/* Number of attributes in a NULL terminated array */
+static uint32_t iio_nb_attrs(struct iio_attribute *attributes)
+{
+	uint32_t i = 0;
+
+	if (attributes)
+		while (attributes[i].name)
+			i++;
+
+	return i;
+}
+
+static void iio_lookup_add_attrs(struct iio_desc *desc,
+				 struct iio_attribute *attributes)
+{
+	uint32_t i;
+
+	for (i = 0; i < iio_nb_attrs(attributes); i++)
+		iio_lookup_add(desc, attributes, attributes[i].name, i);
+}
+
+/*
+ * Channel ids are stored for input and output channels of a device in
+ * different scopes, as they can have the same id. The scopes are members of
+ * the device descriptor, which no other table is keyed by: the device
+ * entry itself would collide with the device ids scope (desc->devs).
+ * Devices sharing a descriptor also share its channel indexes.
+ */
+static inline const void *iio_ch_scope(struct iio_dev_priv *dev, bool ch_out)
+{
+	if (ch_out)
+		return &dev->dev_descriptor->num_ch;
+
+	return &dev->dev_descriptor->channels;
+}
+
+/**
+ * @brief Build the table used to find devices, triggers, channels and
+ * attributes by name.
+ * @param desc - IIO descriptor.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_init_lookup(struct iio_desc *desc)
+{
+	struct iio_device *device;
+	struct iio_channel *ch;
+	char ch_id[MAX_CHN_ID];
+	uint32_t nb_entries, ids_size, i, j, of;
+
+	nb_entries = desc->nb_devs + desc->nb_trigs;
+	ids_size = 0;
+	for (i = 0; i < desc->nb_devs; i++) {
+		device = desc->devs[i].dev_descriptor;
+		nb_entries += iio_nb_attrs(device->attributes) +
+			      iio_nb_attrs(device->debug_attributes) +
+			      iio_nb_attrs(device->buffer_attributes) +
+			      device->num_ch;
+		for (j = 0; j < device->num_ch; j++) {
+			nb_entries += iio_nb_attrs(device->channels[j].attributes);
+			_print_ch_id(ch_id, &device->channels[j]);
+			ids_size += strlen(ch_id) + 1;
+		}
+	}
+	for (i = 0; i < desc->nb_trigs; i++)
+		nb_entries += iio_nb_attrs(desc->trigs[i].descriptor->attributes);
+
+	/* Keep the table at most half full */
+	desc->lookup_mask = 1;
+	while (desc->lookup_mask < 2 * nb_entries)
+		desc->lookup_mask <<= 1;
+	desc->lookup = (struct iio_lookup_entry *)no_os_calloc(desc->lookup_mask,
+			sizeof(*desc->lookup));
+	if (!desc->lookup)
+		return -ENOMEM;
+	desc->lookup_mask--;
+
+	desc->ch_ids = (char *)no_os_calloc(ids_size + 1, sizeof(*desc->ch_ids));
+	if (!desc->ch_ids) {
+		no_os_free(desc->lookup);
+		desc->lookup = NULL;
+		return -ENOMEM;
+	}
+
+	of = 0;
+	for (i = 0; i < desc->nb_devs; i++) {
+		iio_lookup_add(desc, desc->devs, desc->devs[i].dev_id, i);
+		device = desc->devs[i].dev_descriptor;
+		iio_lookup_add_attrs(desc, device->attributes);
+		iio_lookup_add_attrs(desc, device->debug_attributes);
+		iio_lookup_add_attrs(desc, device->buffer_attributes);
+		for (j = 0; j < device->num_ch; j++) {
+			ch = &device->channels[j];
+			_print_ch_id(desc->ch_ids + of, ch);
+			iio_lookup_add(desc, iio_ch_scope(&desc->devs[i], ch->ch_out),
+				       desc->ch_ids + of, j);
+			of += strlen(desc->ch_ids + of) + 1;
+			iio_lookup_add_attrs(desc, ch->attributes);
+		}
+	}
+	for (i = 0; i < desc->nb_trigs; i++) {
+		iio_lookup_add(desc, desc->trigs, desc->trigs[i].id, i);
+		iio_lookup_add_attrs(desc, desc->trigs[i].descriptor->attributes);
+	}
+
+	return 0;
+}
+
 /**
- * @brief Get channel ID from a list of channels.
+ * @brief Get channel from a list of channels.
+ * @param desc - IIO descriptor.
  * @param channel - Channel name.
- * @param desc - Device descriptor
+ * @param dev - Device the channel belongs to.
  * @param ch_out - If "true" is output channel, if "false" is input channel.
- * @return Channel ID, or negative value if attribute is not found.
+ * @return Channel pointer, or NULL if channel is not found.
  */
-static inline struct iio_channel *iio_get_channel(const char *channel,
-		struct iio_device *desc, bool ch_out)
+static inline struct iio_channel *iio_get_channel(struct iio_desc *desc,
+		const char *channel, struct iio_dev_priv *dev, bool ch_out)
 {
-	int16_t i = 0;
-	char	ch_id[MAX_CHN_ID];
+	int32_t i;
 
-	while (i < desc->num_ch) {
-		_print_ch_id(ch_id, &desc->channels[i]);
-		if (!strcmp(channel, ch_id) &&
-		    (desc->channels[i].ch_out == ch_out))
-			return &desc->channels[i];
-		i++;
-	}
+	i = iio_lookup(desc, iio_ch_scope(dev, ch_out), channel);
+	if (i < 0)
+		return NULL;
 
-	return NULL;
+	return &dev->dev_descriptor->channels[i];
 }
 
 /**
@@ -327,14 +587,13 @@ static inline struct iio_channel *iio_get_channel(const char *channel,
 static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 		const char *device_name)
 {
-	uint32_t i;
+	int32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		if (strcmp(desc->devs[i].dev_id, device_name) == 0)
-			return &desc->devs[i];
-	}
+	i = iio_lookup(desc, desc->devs, device_name);
+	if (i < 0)
+		return NULL;
 
-	return NULL;
+	return &desc->devs[i];
 }
 
 /**
@@ -346,14 +605,13 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 		const char *trigger_id)
 {
-	uint32_t i;
+	int32_t i;
 
-	for (i = 0; i < desc->nb_trigs; i++) {
-		if (strcmp(desc->trigs[i].id, trigger_id) == 0)
-			return &desc->trigs[i];
-	}
+	i = iio_lookup(desc, desc->trigs, trigger_id);
+	if (i < 0)
+		return NULL;
 
-	return NULL;
+	return &desc->trigs[i];
 }
 
 /**
@@ -367,16 +625,18 @@ static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 				 uint32_t buffers_count)
 {
 	struct iio_desc *desc = ctx->instance;
+	struct iio_dev_priv *dev;
 
-	if(!get_iio_device(desc, device))
+	dev = get_iio_device(desc, device);
+	if (!dev)
 		return -ENODEV;
 
-	/* Our implementation uses a circular buffer to send/receive data so
-	 * only 1 is a valid value.
-	 */
-	if (buffers_count != 1)
+	/* The blocks are allocated when the device is opened */
+	if (!buffers_count || buffers_count > IIO_MAX_BUFFERS_COUNT)
 		return -EINVAL;
 
+	dev->buffer.buffers_count = buffers_count;
+
 	return 0;
 }
 
@@ -473,6 +733,7 @@ static int iio_write_all_attr(struct attr_fun_params *params,
 
 /**
  * @brief Read/write attribute.
+ * @param desc - IIO descriptor.
  * @param params - Structure describing parameters for store and show functions
  * @param attributes - Array of attributes.
  * @param attr_name - Attribute name to be modified
@@ -480,21 +741,16 @@ static int iio_write_all_attr(struct attr_fun_params *params,
  * 		attribute.
  * @return Length of chars written/read or negative value in case of error.
  */
-static int iio_rd_wr_attribute(struct attr_fun_params *params,
+static int iio_rd_wr_attribute(struct iio_desc *desc,
+			       struct attr_fun_params *params,
 			       struct iio_attribute *attributes,
 			       const char *attr_name,
 			       bool is_write)
 {
-	int16_t i = 0;
-
-	/* Search attribute */
-	while (attributes[i].name) {
-		if (!strcmp(attr_name, attributes[i].name))
-			break;
-		i++;
-	}
+	int32_t i;
 
-	if (!attributes[i].name)
+	i = iio_lookup(desc, attributes, attr_name);
+	if (i < 0)
 		return -ENOENT;
 
 	if (is_write) {
@@ -513,6 +769,35 @@ static int iio_rd_wr_attribute(struct attr_fun_params *params,
 	}
 }
 
+/* Copy a formatted value to buf, with the truncation and the return value of
+ * snprintf()
+ */
+static int iio_format_copy(char *buf, uint32_t len, const char *str,
+			   uint32_t n)
+{
+	uint32_t cnt;
+
+	if (len) {
+		cnt = no_os_min(n, len - 1);
+		memcpy(buf, str, cnt);
+		buf[cnt] = '\0';
+	}
+
+	return n;
+}
+
+/* Format "<integer>.<fract>", with fract zero padded to digits */
+static uint32_t iio_format_fixed(char *str, int32_t integer, uint32_t fract,
+				 uint32_t digits)
+{
+	uint32_t n;
+
+	n = no_os_int32_to_str(str, integer);
+	str[n++] = '.';
+
+	return n + no_os_uint32_to_str(str + n, fract, digits);
+}
+
 /* Read a device register. The register address to read is set on
  * in desc->active_reg_addr in the function set_demo_reg_attr
  */
@@ -520,6 +805,7 @@ static int32_t debug_reg_read(struct iio_dev_priv *dev, char *buf, uint32_t len)
 {
 	uint32_t		value;
 	int32_t			ret;
+	char			str[IIO_VAL_STR_MAX];
 
 	value = 0;
 	ret = dev->dev_descriptor->debug_reg_read(dev->dev_instance,
@@ -528,7 +814,8 @@ static int32_t debug_reg_read(struct iio_dev_priv *dev, char *buf, uint32_t len)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	return snprintf(buf, len, "%"PRIu32"", value);
+	return iio_format_copy(buf, len, str,
+			       no_os_uint32_to_str(str, value, 0));
 }
 
 /* Flow of reading and writing registers. This is how iio works for
@@ -545,12 +832,23 @@ static int32_t debug_reg_read(struct iio_dev_priv *dev, char *buf, uint32_t len)
 static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 			       uint32_t len)
 {
-	uint32_t		nb_filled;
+	uint32_t		nb_filled = 0;
 	uint32_t		addr;
 	uint32_t		value;
+	uint32_t		n;
+	const char		*p;
 	int32_t			ret;
 
-	nb_filled = sscanf(buf, "0x%"PRIx32" 0x%"PRIx32"", &addr, &value);
+	/* Same as sscanf(buf, "0x%x 0x%x", &addr, &value) */
+	if (buf[0] == '0' && buf[1] == 'x') {
+		n = no_os_str_parse_uint32(buf + 2, 16, &addr);
+		p = buf + 2 + n;
+		while (n && isspace((unsigned char)*p))
+			p++;
+		if (n && p[0] == '0' && p[1] == 'x' &&
+		    no_os_str_parse_uint32(p + 2, 16, &value))
+			nb_filled = 2;
+	}
 	if (nb_filled == 2) {
 		/* Write register */
 		ret = dev->dev_descriptor->debug_reg_write(dev->dev_instance,
@@ -558,7 +856,8 @@ static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 	} else {
-		nb_filled = sscanf(buf, "%"PRIu32, &addr);
+		if (no_os_str_parse_uint32(buf, 10, &addr))
+			nb_filled = 1;
 		if (nb_filled == 1) {
 			dev->active_reg_addr = addr;
 			return len;
@@ -570,46 +869,62 @@ static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 	return len;
 }
 
-static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
+/* Split "<integer>.<fraction>" and parse the integer part. The fraction is
+ * left in *fract for the caller to parse.
+ */
+static int32_t __iio_str_parse(char *buf, int32_t *integer, char **fract,
 			       bool scale_db)
 {
-	char *p;
+	char *p = buf;
 
-	p = strtok(buf, ".");
-	if (p == NULL)
+	while (*p == '.')
+		p++;
+	if (*p == '\0')
 		return -EINVAL;
 
-	*integer = strtol(p, NULL, 0);
-
-	if (scale_db) {
-		p = strtok(NULL, "db");
-		if (p == NULL)
-			p = strtok(NULL, " db");
-	} else
-		p = strtok(NULL, "\n");
+	no_os_str_parse_int32(p, 0, integer);
 
+	p = strchr(p, '.');
 	if (p == NULL)
 		return -EINVAL;
 
-	*_fract = strtol(p, NULL, 10);
+	p++;
+	if (scale_db)
+		p += strspn(p, "db");
+	else
+		p += strspn(p, "\n");
+	if (*p == '\0')
+		return -EINVAL;
+
+	*fract = p;
 
 	return 0;
 }
 
-static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
+/*
+ * Parse a fixed point value with the given number of fractional digits. As in
+ * Linux, the sign of a value between -1 and 0 is carried by the fractional
+ * part, since the integer part reads as 0.
+ */
+static int32_t __iio_fixpoint_parse(char *buf, uint32_t digits, bool scale_db,
+				    int32_t *integer, int32_t *_fract)
 {
-	int32_t temp = fract;
+	char *fract;
+	char *p;
+	int32_t ret;
 
-	while ((subunits != 0) || (temp != 0)) {
-		temp /= 10;
-		subunits /= 10;
-		if (!temp)
-			break;
-		if (subunits <= 1)
-			fract /= 10;
-	}
+	ret = __iio_str_parse(buf, integer, &fract, scale_db);
+	if (ret < 0)
+		return ret;
 
-	return fract * subunits;
+	no_os_str_parse_fract(fract, digits, _fract);
+
+	p = buf + strspn(buf, ".");
+	p += strspn(p, " \t\n\v\f\r");
+	if (*integer == 0 && *p == '-')
+		*_fract = -*_fract;
+
+	return 0;
 }
 
 int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
@@ -617,39 +932,37 @@ int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
 {
 	int32_t ret = 0;
 	int32_t integer, _fract = 0;
-	char ch;
+	char *fract;
 
 	switch (fmt) {
 	case IIO_VAL_INT:
-		integer = strtol(buf, NULL, 0);
+		no_os_str_parse_int32(buf, 0, &integer);
 		break;
 	case IIO_VAL_INT_PLUS_MICRO_DB:
-		ret = __iio_str_parse(buf, &integer, &_fract, true);
+		ret = __iio_fixpoint_parse(buf, 6, true, &integer, &_fract);
 		if (ret < 0)
 			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
 		break;
 	case IIO_VAL_INT_PLUS_MICRO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		ret = __iio_fixpoint_parse(buf, 6, false, &integer, &_fract);
 		if (ret < 0)
 			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
 		break;
 	case IIO_VAL_INT_PLUS_NANO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		ret = __iio_fixpoint_parse(buf, 9, false, &integer, &_fract);
 		if (ret < 0)
 			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000000);
 		break;
 	case IIO_VAL_FRACTIONAL:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		ret = __iio_str_parse(buf, &integer, &fract, false);
 		if (ret < 0)
 			return ret;
+		no_os_str_parse_int32(fract, 10, &_fract);
 		break;
 	case IIO_VAL_CHAR:
-		if (sscanf(buf, "%c", &ch) != 1)
+		if (buf[0] == '\0')
 			return -EINVAL;
-		integer = ch;
+		integer = buf[0];
 		break;
 	default:
 		return -EINVAL;
@@ -668,44 +981,47 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 {
 	int64_t tmp;
 	int32_t integer, fractional;
-	bool dB = false;
+	char str[IIO_VAL_STR_MAX];
+	uint32_t n;
 	int32_t i = 0;
 	uint32_t l = 0;
 
 	switch (fmt) {
 	case IIO_VAL_INT:
-		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+		n = no_os_int32_to_str(str, vals[0]);
+		break;
 	case IIO_VAL_INT_PLUS_MICRO_DB:
-		dB = true;
-	/* intentional fall through */
+		n = iio_format_fixed(str, vals[0], vals[1], 6);
+		memcpy(str + n, " dB", 4);
+		n += 3;
+		break;
 	case IIO_VAL_INT_PLUS_MICRO:
-		return snprintf(buf, len, "%"PRIi32".%06"PRIu32"%s", vals[0],
-				(uint32_t)vals[1], dB ? " dB" : "");
+		n = iio_format_fixed(str, vals[0], vals[1], 6);
+		break;
 	case IIO_VAL_INT_PLUS_NANO:
-		return snprintf(buf, len, "%"PRIi32".%09"PRIu32"", vals[0],
-				(uint32_t)vals[1]);
+		n = iio_format_fixed(str, vals[0], vals[1], 9);
+		break;
 	case IIO_VAL_FRACTIONAL:
-		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
-		fractional = vals[1];
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
-
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
 	case IIO_VAL_FRACTIONAL_LOG2:
-		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
+		if (fmt == IIO_VAL_FRACTIONAL)
+			tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL,
+					    vals[1]);
+		else
+			tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL,
+						vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000,
+						     &fractional);
 
+		n = 0;
 		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
+			str[n++] = '-';
+		n += iio_format_fixed(str + n, integer, abs(fractional), 9);
+		break;
 	case IIO_VAL_INT_MULTIPLE: {
 		while (i < size) {
-			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
+			n = no_os_int32_to_str(str, vals[i]);
+			str[n++] = ' ';
+			l += iio_format_copy(&buf[l], len - l, str, n);
 			if (l >= len)
 				break;
 			i++;
@@ -713,10 +1029,14 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 		return l;
 	}
 	case IIO_VAL_CHAR:
-		return snprintf(buf, len, "%c", (char)vals[0]);
+		str[0] = (char)vals[0];
+		n = 1;
+		break;
 	default:
 		return 0;
 	}
+
+	return iio_format_copy(buf, len, str, n);
 }
 
 static struct iio_attribute *get_attributes(enum iio_attr_type type,
@@ -762,6 +1082,75 @@ static struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
 	return NULL;
 }
 
+/**
+ * @brief Get the names of a device, channel and attribute from their indexes
+ * in the xml. Used by the binary protocol.
+ * @param ctx - IIO instance and conn instance
+ * @param dev_idx - Device index. Triggers follow the devices.
+ * @param type - Attribute type. Updated with the channel direction for
+ * channel attributes.
+ * @param ch_idx - Channel index. Negative if not used.
+ * @param attr_idx - Attribute index. Negative if not used.
+ * @param device - Where to store the device id.
+ * @param channel - Where to store the channel id.
+ * @param attr - Where to store the attribute name.
+ * @return 0 or negative value in case of failure.
+ */
+static int iio_get_names(struct iiod_ctx *ctx, uint32_t dev_idx,
+			 enum iio_attr_type *type, int32_t ch_idx,
+			 int32_t attr_idx, char *device, char *channel,
+			 char *attr)
+{
+	struct iio_desc *desc = ctx->instance;
+	struct iio_attribute *attributes;
+	struct iio_channel *ch = NULL;
+	struct iio_dev_priv *dev = NULL;
+	struct iio_trig_priv *trig;
+	int32_t i;
+
+	if (dev_idx >= desc->nb_devs + desc->nb_trigs)
+		return -ENODEV;
+
+	if (dev_idx >= desc->nb_devs) {
+		trig = &desc->trigs[dev_idx - desc->nb_devs];
+		strcpy(device, trig->id);
+		if (attr_idx < 0)
+			return 0;
+		attributes = get_trig_attributes(*type, trig);
+	} else {
+		dev = &desc->devs[dev_idx];
+		strcpy(device, dev->dev_id);
+		if (ch_idx >= 0) {
+			if (ch_idx >= dev->dev_descriptor->num_ch)
+				return -ENOENT;
+			ch = &dev->dev_descriptor->channels[ch_idx];
+			_print_ch_id(channel, ch);
+			*type = ch->ch_out ? IIO_ATTR_TYPE_CH_OUT :
+				IIO_ATTR_TYPE_CH_IN;
+		}
+		if (attr_idx < 0)
+			return 0;
+		attributes = get_attributes(*type, dev, ch);
+	}
+
+	for (i = 0; attributes && attributes[i].name; i++)
+		if (i == attr_idx) {
+			strncpy(attr, attributes[i].name, MAX_ATTR_NAME - 1);
+			return 0;
+		}
+
+	/* direct_reg_access follows the debug attributes in the xml */
+	if (*type == IIO_ATTR_TYPE_DEBUG && i == attr_idx &&
+	    dev_idx < desc->nb_devs &&
+	    (dev->dev_descriptor->debug_reg_read ||
+	     dev->dev_descriptor->debug_reg_write)) {
+		strcpy(attr, REG_ACCESS_ATTRIBUTE);
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
 /**
  * @brief Read global attribute of a device.
  * @param ctx - IIO instance and conn instance
@@ -795,7 +1184,7 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
+			ch = iio_get_channel(ctx->instance, attr->channel, dev,
 					     ch_out);
 			if (!ch)
 				return -ENOENT;
@@ -815,7 +1204,8 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 0);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -830,7 +1220,8 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 0);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -871,7 +1262,7 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
+			ch = iio_get_channel(ctx->instance, attr->channel, dev,
 					     ch_out);
 			if (!ch)
 				return -ENOENT;
@@ -892,7 +1283,8 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
 			return iio_write_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 1);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -907,7 +1299,8 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 1);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -1124,6 +1517,23 @@ static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 	return cnt;
 }
 
+/**
+ * @brief Check if one of the channels in a mask is an output channel.
+ * @param dev - Device descriptor.
+ * @param mask - Channels mask.
+ * @return true if an output channel is in mask, false otherwise.
+ */
+static bool iio_mask_has_output(struct iio_device *dev, uint32_t mask)
+{
+	uint32_t i;
+
+	for (i = 0; i < dev->num_ch; i++)
+		if ((mask & NO_OS_BIT(i)) && dev->channels[i].ch_out)
+			return true;
+
+	return false;
+}
+
 /**
  * @brief  Open device.
  * @param ctx - IIO instance and conn instance
@@ -1142,6 +1552,9 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
+	uint32_t nb_scans;
+	uint32_t nb_blocks;
+	bool lock_free;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev)
@@ -1163,12 +1576,37 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		bytes_per_scan(dev->dev_descriptor->channels, mask);
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
+	if (!dev->buffer.public.size)
+		return -EINVAL;
+	lock_free = dev->buffer.lock_free && !cyclic;
+	/* Blocks are filled by the device itself, while earlier ones are sent */
+	nb_blocks = 1;
+	if (dev->buffer.buffers_count > 1 && !cyclic && !lock_free &&
+	    dev->trig_idx == NO_TRIGGER &&
+	    !iio_mask_has_output(dev->dev_descriptor, mask)) {
+		nb_blocks = dev->buffer.buffers_count;
+		if (nb_blocks & (nb_blocks - 1))
+			nb_blocks = NO_OS_BIT(no_os_find_last_set_bit(nb_blocks) + 1);
+	}
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
 		if (dev->buffer.raw_buf_len < dev->buffer.public.size)
 			/* Need a bigger buffer or to allocate */
 			return -ENOMEM;
 		buf_size = dev->buffer.raw_buf_len - (dev->buffer.raw_buf_len %
 						      dev->buffer.public.size);
+		if (lock_free) {
+			/* The ring holds a power of 2 number of scans */
+			nb_scans = dev->buffer.raw_buf_len /
+				   dev->buffer.public.bytes_per_scan;
+			nb_scans = NO_OS_BIT(no_os_find_last_set_bit(nb_scans));
+			if (nb_scans < samples)
+				return -ENOMEM;
+			buf_size = nb_scans * dev->buffer.public.bytes_per_scan;
+		}
+		/* Use as many of the requested blocks as raw_buf can hold */
+		while (nb_blocks > 1 &&
+		       dev->buffer.raw_buf_len / nb_blocks < dev->buffer.public.size)
+			nb_blocks >>= 1;
 		buf = dev->buffer.raw_buf;
 	} else {
 		if (dev->buffer.allocated) {
@@ -1176,14 +1614,32 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
+		if (dev->buffer.public.size > UINT32_MAX / nb_blocks)
+			return -ENOMEM;
+		buf_size = dev->buffer.public.size * nb_blocks;
+		if (lock_free) {
+			nb_scans = samples;
+			if (nb_scans > NO_OS_BIT(30))
+				return -ENOMEM;
+			if (nb_scans & (nb_scans - 1))
+				nb_scans = NO_OS_BIT(
+						   no_os_find_last_set_bit(nb_scans) + 1);
+			buf_size = nb_scans * dev->buffer.public.bytes_per_scan;
+		}
+		buf = (int8_t *)no_os_calloc(buf_size, sizeof(*buf));
 		if (!buf)
 			return -ENOMEM;
 		dev->buffer.allocated = 1;
 	}
 
 	ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
+	if (!NO_OS_IS_ERR_VALUE(ret) && lock_free)
+		ret = no_os_spsc_ring_cfg(&dev->buffer.ring, buf,
+					  dev->buffer.public.bytes_per_scan,
+					  buf_size / dev->buffer.public.bytes_per_scan);
+	if (!NO_OS_IS_ERR_VALUE(ret) && nb_blocks > 1)
+		ret = no_os_spsc_ring_cfg(&dev->buffer.blocks, buf,
+					  dev->buffer.public.size, nb_blocks);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
 		if (dev->buffer.allocated) {
 			no_os_free(dev->buffer.cb.buff);
@@ -1192,6 +1648,10 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 
 		return ret;
 	}
+	dev->buffer.public.ring = lock_free ? &dev->buffer.ring : NULL;
+	dev->buffer.public.blocks = nb_blocks > 1 ? &dev->buffer.blocks : NULL;
+	dev->buffer.public.block_pending = false;
+	dev->buffer.block_offset = 0;
 
 	if (dev->dev_descriptor->pre_enable) {
 		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
@@ -1257,6 +1717,36 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	return ret;
 }
 
+/**
+ * @brief Fill a block of a lock-free buffer using read_dev. The block is
+ * read in two parts when it wraps around the end of the ring.
+ * @param dev - Device whose buffer is filled.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_ring_read_dev(struct iio_dev_priv *dev)
+{
+	struct no_os_spsc_ring *ring = dev->buffer.public.ring;
+	uint32_t samples = dev->buffer.public.samples;
+	uint32_t nb;
+	void *buff;
+	int32_t ret;
+
+	if (no_os_spsc_ring_avail(ring) < samples)
+		return -ENOSPC;
+
+	while (samples) {
+		nb = no_os_spsc_ring_reserve(ring, samples, &buff);
+		ret = dev->dev_descriptor->read_dev(dev->dev_instance, buff, nb);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		no_os_spsc_ring_commit(ring, nb);
+		samples -= nb;
+	}
+
+	return 0;
+}
+
 static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 			   enum iio_buffer_direction dir)
 {
@@ -1278,6 +1768,9 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 		void *buff;
 		struct iio_buffer *buffer = &dev->buffer.public;
 
+		if (buffer->ring && dir == IIO_DIRECTION_INPUT)
+			return iio_ring_read_dev(dev);
+
 		ret = iio_buffer_get_block(buffer, &buff);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
@@ -1304,9 +1797,82 @@ static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
 
 static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
 {
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	/*
+	 * Send the blocks filled while the previous ones were sent, or wait
+	 * for the one the device is filling.
+	 */
+	if (dev->buffer.public.blocks &&
+	    (dev->buffer.public.block_pending ||
+	     no_os_spsc_ring_used(dev->buffer.public.blocks)))
+		return 0;
+
+	/*
+	 * Like the circular buffer, drop the data that was not read. The
+	 * drained ring then starts the new block at its beginning.
+	 */
+	if (dev->buffer.public.ring && dev->trig_idx == NO_TRIGGER)
+		no_os_spsc_ring_flush(dev->buffer.public.ring);
+
 	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
 }
 
+/**
+ * @brief Get the part of the oldest block of a multi-block buffer that was
+ * not sent yet. When all the blocks were sent and the device is idle, the
+ * next one is acquired, for requests larger than the buffer.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param dev - Device whose buffer is read.
+ * @param addr - Set to the start of the data.
+ * @param bytes - Maximum number of bytes needed.
+ * @return Number of bytes at addr or negative value in case of error.
+ */
+static int iio_blocks_peek(struct iiod_ctx *ctx, const char *device,
+			   struct iio_dev_priv *dev, void **addr,
+			   uint32_t bytes)
+{
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	int32_t ret;
+
+	if (!no_os_spsc_ring_peek(buffer->public.blocks, 1, addr)) {
+		if (buffer->public.block_pending)
+			return -EAGAIN;
+
+		ret = iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (!no_os_spsc_ring_peek(buffer->public.blocks, 1, addr))
+			return -EAGAIN;
+	}
+
+	*addr = (int8_t *)*addr + buffer->block_offset;
+
+	return no_os_min(bytes, buffer->public.size - buffer->block_offset);
+}
+
+/**
+ * @brief Mark bytes returned by iio_blocks_peek() as sent. The block is
+ * given back to the device once all of it was sent.
+ * @param buffer - Buffer of the device.
+ * @param bytes - Number of bytes sent.
+ */
+static void iio_blocks_release(struct iio_buffer_priv *buffer, uint32_t bytes)
+{
+	buffer->block_offset += bytes;
+	if (buffer->block_offset < buffer->public.size)
+		return;
+
+	buffer->block_offset = 0;
+	no_os_spsc_ring_release(buffer->public.blocks, 1);
+}
+
 /**
  * @brief Read chunk of data from RAM to pbuf. Call
  * "iio_transfer_dev_to_mem()" first.
@@ -1322,11 +1888,44 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	struct iio_dev_priv	*dev;
 	int32_t			ret;
 	uint32_t		size;
+	void			*addr;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	if (dev->buffer.public.blocks) {
+		ret = iio_blocks_peek(ctx, device, dev, &addr, bytes);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		memcpy(buf, addr, ret);
+		iio_blocks_release(&dev->buffer, ret);
+
+		return ret;
+	}
+
+	if (dev->buffer.public.ring) {
+		/* Only whole scans are stored in the ring */
+		bytes /= dev->buffer.public.bytes_per_scan;
+		if (!bytes)
+			return -EINVAL;
+
+		/* Acquire the rest of a request larger than the ring */
+		if (!no_os_spsc_ring_used(dev->buffer.public.ring) &&
+		    dev->trig_idx == NO_TRIGGER) {
+			ret = iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+
+		bytes = no_os_spsc_ring_read(dev->buffer.public.ring, buf, bytes);
+		if (!bytes)
+			return -EAGAIN;
+
+		return bytes * dev->buffer.public.bytes_per_scan;
+	}
+
 	ret = no_os_cb_size(&dev->buffer.cb, &size);
 #ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
 #warning Buffer overrun error checking is disabled.
@@ -1350,6 +1949,113 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	return bytes;
 }
 
+/**
+ * @brief Get a contiguous region of the device buffer to be sent without
+ * copying it. The read index is updated by iio_read_buffer_done().
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param buf - Set to the start of the region.
+ * @param bytes - Maximum number of bytes to be sent.
+ * @return Length of the region or negative value in case of error.
+ */
+static int iio_read_buffer_zc(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size = 0;
+	void			*addr;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	if (dev->buffer.public.blocks) {
+		ret = iio_blocks_peek(ctx, device, dev, &addr, bytes);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		*buf = addr;
+
+		return ret;
+	}
+
+	if (dev->buffer.public.ring) {
+		size = bytes / dev->buffer.public.bytes_per_scan;
+		if (!size)
+			return -EINVAL;
+
+		/* Acquire the rest of a request larger than the ring */
+		if (!no_os_spsc_ring_used(dev->buffer.public.ring) &&
+		    dev->trig_idx == NO_TRIGGER) {
+			ret = iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+
+		size = no_os_spsc_ring_peek(dev->buffer.public.ring, size, &addr);
+		if (!size)
+			return -EAGAIN;
+
+		*buf = addr;
+
+		return size * dev->buffer.public.bytes_per_scan;
+	}
+
+	ret = no_os_cb_prepare_async_read(&dev->buffer.cb, bytes, &addr, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret == -NO_OS_EOVERRUN)
+		ret = 0;
+#endif
+	if (ret == -NO_OS_EOVERRUN) {
+		/* Drop the region, the overrun has to be reported */
+		dev->buffer.cb.read.async_size = 0;
+		no_os_cb_end_async_read(&dev->buffer.cb);
+		return ret;
+	}
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (!size)
+		return -EAGAIN;
+
+	*buf = addr;
+
+	return size;
+}
+
+/**
+ * @brief Release a region returned by iio_read_buffer_zc().
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param bytes - Number of bytes consumed from the region.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_read_buffer_done(struct iiod_ctx *ctx, const char *device,
+				uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	if (dev->buffer.public.blocks) {
+		iio_blocks_release(&dev->buffer, bytes);
+		return 0;
+	}
+
+	if (dev->buffer.public.ring) {
+		no_os_spsc_ring_release(dev->buffer.public.ring,
+					bytes / dev->buffer.public.bytes_per_scan);
+		return 0;
+	}
+
+	dev->buffer.cb.read.async_size = no_os_min(bytes,
+					 dev->buffer.cb.read.async_size);
+
+	return no_os_cb_end_async_read(&dev->buffer.cb);
+}
 
 /**
  * @brief Write chunk of data into RAM.
@@ -1371,6 +2077,10 @@ static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	/* Lock-free and multi-block buffers are only used by input devices */
+	if (dev->buffer.public.ring || dev->buffer.public.blocks)
+		return -ENOTSUP;
+
 	ret = no_os_cb_size(&dev->buffer.cb, &size);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
@@ -1391,6 +2101,43 @@ int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
 	if (!buffer)
 		return -EINVAL;
 
+	if (buffer->blocks) {
+		if (buffer->dir != IIO_DIRECTION_INPUT)
+			return -ENOTSUP;
+
+		/* Only one block is filled at a time */
+		if (buffer->block_pending)
+			return -EBUSY;
+
+		/* Don't overwrite the blocks that were not sent yet */
+		if (!no_os_spsc_ring_reserve(buffer->blocks, 1, addr))
+			return -EAGAIN;
+
+		buffer->block_pending = true;
+
+		return 0;
+	}
+
+	if (buffer->ring) {
+		if (buffer->dir != IIO_DIRECTION_INPUT)
+			return -ENOTSUP;
+
+		/*
+		 * The whole block has to be contiguous, but the ring size is a
+		 * power of 2 and not a multiple of the block. Blocks are
+		 * acquired from the context that reads the buffer, so a
+		 * drained ring can be realigned to start the block at the
+		 * beginning of the storage.
+		 */
+		if (!no_os_spsc_ring_used(buffer->ring))
+			no_os_spsc_ring_reset(buffer->ring);
+		if (no_os_spsc_ring_reserve(buffer->ring, buffer->samples,
+					    addr) < buffer->samples)
+			return -EAGAIN;
+
+		return 0;
+	}
+
 	if (buffer->dir == IIO_DIRECTION_INPUT)
 		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
 
@@ -1402,6 +2149,26 @@ int iio_buffer_block_done(struct iio_buffer *buffer)
 	if (!buffer)
 		return -EINVAL;
 
+	if (buffer->blocks) {
+		if (!buffer->block_pending)
+			return -EINVAL;
+
+		/* Publish the block before the device is seen as idle */
+		no_os_spsc_ring_commit(buffer->blocks, 1);
+		buffer->block_pending = false;
+
+		return 0;
+	}
+
+	if (buffer->ring) {
+		if (buffer->dir != IIO_DIRECTION_INPUT)
+			return -ENOTSUP;
+
+		no_os_spsc_ring_commit(buffer->ring, buffer->samples);
+
+		return 0;
+	}
+
 	if (buffer->dir == IIO_DIRECTION_INPUT)
 		return no_os_cb_end_async_write(buffer->buf);
 
@@ -1414,9 +2181,56 @@ int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
 	if (!buffer)
 		return -EINVAL;
 
+	/* A full ring drops the new scan */
+	if (buffer->ring)
+		return no_os_spsc_ring_write(buffer->ring, data, 1) ? 0 : -ENOSPC;
+
 	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
 }
 
+/* Unpack the enabled channels of a raw scan and push them */
+int iio_buffer_push_raw_scan(struct iio_buffer *buffer,
+			     const struct no_os_sample_fmt *fmt,
+			     const uint8_t *raw, uint32_t nb_channels)
+{
+	int32_t samples[IIO_RAW_SCAN_MAX_CHANNELS];
+	union {
+		int32_t s32[IIO_RAW_SCAN_MAX_CHANNELS];
+		int16_t s16[IIO_RAW_SCAN_MAX_CHANNELS];
+	} scan;
+	uint32_t storage, mask, i, n;
+	int ret;
+
+	if (!buffer || !nb_channels || nb_channels > IIO_RAW_SCAN_MAX_CHANNELS)
+		return -EINVAL;
+
+	mask = buffer->active_mask;
+	n = no_os_hweight32(mask);
+	if (!n || (mask >> 1) >> (nb_channels - 1) ||
+	    buffer->bytes_per_scan % n)
+		return -EINVAL;
+
+	storage = buffer->bytes_per_scan / n;
+	if (storage != sizeof(int16_t) && storage != sizeof(int32_t))
+		return -EINVAL;
+
+	ret = no_os_sample_unpack32(fmt, raw, samples, nb_channels);
+	if (ret)
+		return ret;
+
+	for (i = 0, n = 0; i < nb_channels; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		if (storage == sizeof(int32_t))
+			scan.s32[n++] = samples[i];
+		else
+			scan.s16[n++] = samples[i];
+	}
+
+	return iio_buffer_push_scan(buffer, &scan);
+}
+
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 {
@@ -1425,6 +2239,9 @@ int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 
 	int ret;
 
+	if (buffer->ring)
+		return no_os_spsc_ring_read(buffer->ring, data, 1) ? 0 : -EAGAIN;
+
 	ret = no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
 
 	if (buffer->cyclic_info.is_cyclic) {
@@ -1450,8 +2267,9 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 			return ret;
 
 		data.conn = sock;
-		data.buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
+		data.buf = iio_conn_buf_alloc();
 		data.len = IIOD_CONN_BUFFER_SIZE;
+		data.buffered_recv = true;
 
 		if (!data.buf) {
 			ret = -ENOMEM;
@@ -1465,6 +2283,8 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 		ret = _push_conn(desc, id);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto remove_conn;
+
+		desc->conn_socks[id] = sock;
 	} while (true);
 
 	return 0;
@@ -1472,7 +2292,7 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 remove_conn:
 	iiod_conn_remove(desc->iiod, id, &data);
 free_buf:
-	no_os_free(data.buf);
+	iio_conn_buf_free(data.buf);
 close_socket:
 	socket_remove(sock);
 
@@ -1480,6 +2300,128 @@ close_socket:
 }
 #endif
 
+/**
+ * @brief Advance the state machine of a connection and put it back at the end
+ * of the connections FIFO. Connections closed by the peer are removed.
+ * @param desc - IIo descriptor
+ * @param conn_id - Connection popped from the connections FIFO
+ * @return Result of iiod_conn_step.
+ */
+static int32_t iio_step_conn(struct iio_desc *desc, uint32_t conn_id)
+{
+	struct iiod_conn_data data;
+	int32_t ret;
+
+	ret = iiod_conn_step(desc->iiod, conn_id);
+	if (ret == -ENOTCONN) {
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+		iiod_conn_remove(desc->iiod, conn_id, &data);
+		socket_remove(data.conn);
+		iio_conn_buf_free(data.buf);
+		desc->conn_socks[conn_id] = NULL;
+#endif
+	} else {
+		_push_conn(desc, conn_id);
+	}
+
+	return ret;
+}
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+/**
+ * @brief Find the network connections that can make progress.
+ *
+ * Connections that are not waiting for a command are always ready. Idle
+ * connections are only ready when their socket is readable, so idle clients
+ * don't take turns from busy ones. If every connection is idle, wait at most
+ * poll_timeout_ms for a client to send data or for a new client.
+ * @param desc - IIo descriptor
+ * @param ready - Set for each connection that should be stepped
+ * @return 1 if there are new clients to accept, 0 if not, negative error code
+ * otherwise.
+ */
+static int32_t iio_poll_conns(struct iio_desc *desc, bool *ready)
+{
+	struct tcp_socket_desc *socks[IIOD_MAX_CONNECTIONS + 1];
+	uint8_t readable[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t ids[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t i, nb, timeout;
+	int32_t ret;
+
+	socks[0] = desc->server;
+	nb = 1;
+	timeout = desc->poll_timeout_ms;
+	for (i = 0; i < IIOD_MAX_CONNECTIONS; i++) {
+		ready[i] = false;
+		if (!desc->conn_socks[i])
+			continue;
+
+		if (!iiod_conn_is_idle(desc->iiod, i)) {
+			ready[i] = true;
+			timeout = 0;
+			continue;
+		}
+
+		ids[nb] = i;
+		socks[nb++] = desc->conn_socks[i];
+	}
+
+	ret = socket_poll(socks, readable, nb, timeout);
+	if (ret == -ENOSYS)
+		desc->poll_supported = false;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	for (i = 1; i < nb; i++)
+		if (readable[i])
+			ready[ids[i]] = true;
+
+	return readable[0];
+}
+
+/**
+ * @brief Service the network connections in round-robin order. Each ready
+ * connection is stepped once, the others keep their place in the FIFO.
+ * @param desc - IIo descriptor
+ * @return Result of the last iiod_conn_step, -EAGAIN if no connection was
+ * ready or negative error code otherwise.
+ */
+static int32_t iio_step_network(struct iio_desc *desc)
+{
+	bool ready[IIOD_MAX_CONNECTIONS];
+	uint32_t conn_id;
+	int32_t ret, nb;
+
+#if defined(NO_OS_LWIP_NETWORKING)
+	no_os_lwip_step(desc->server->net->net, desc->server->net->net);
+#endif
+
+	ret = iio_poll_conns(desc, ready);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (ret) {
+		ret = accept_network_clients(desc);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
+			return ret;
+	}
+
+	ret = -EAGAIN;
+	nb = _nb_active_conns(desc);
+	while (nb--) {
+		if (_pop_conn(desc, &conn_id))
+			break;
+
+		if (conn_id < IIOD_MAX_CONNECTIONS && ready[conn_id])
+			ret = iio_step_conn(desc, conn_id);
+		else
+			_push_conn(desc, conn_id);
+	}
+
+	return ret;
+}
+#endif
+
 /**
  * @brief Execute an iio step
  * @param desc - IIo descriptor
@@ -1487,7 +2429,6 @@ close_socket:
  */
 int iio_step(struct iio_desc *desc)
 {
-	struct iiod_conn_data data;
 	uint32_t conn_id;
 	int32_t ret;
 
@@ -1495,6 +2436,13 @@ int iio_step(struct iio_desc *desc)
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 	if (desc->server) {
+		if (desc->poll_supported) {
+			ret = iio_step_network(desc);
+			if (desc->poll_supported)
+				return ret;
+			/* Fall back to stepping the connections in turn */
+		}
+
 		ret = accept_network_clients(desc);
 		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
 			return ret;
@@ -1508,18 +2456,7 @@ int iio_step(struct iio_desc *desc)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	ret = iiod_conn_step(desc->iiod, conn_id);
-	if (ret == -ENOTCONN) {
-#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-		iiod_conn_remove(desc->iiod, conn_id, &data);
-		socket_remove(data.conn);
-		no_os_free(data.buf);
-#endif
-	} else {
-		_push_conn(desc, conn_id);
-	}
-
-	return ret;
+	return iio_step_conn(desc, conn_id);
 }
 
 /**
@@ -1818,6 +2755,9 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 			ldev->buffer.raw_buf = ndev->raw_buf;
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
+			ldev->buffer.lock_free = ndev->lock_free;
+			ldev->buffer.buffers_count = ndev->buffers_count ?
+						     ndev->buffers_count : 1;
 			ldev->buffer.initalized = 1;
 		} else {
 			ldev->buffer.initalized = 0;
@@ -1895,6 +2835,10 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_trigs;
 
+	ret = iio_init_lookup(ldesc);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto free_xml;
+
 	/* device operations */
 	ops = &ldesc->iiod_ops;
 	ops->read_attr = iio_read_attr;
@@ -1902,6 +2846,8 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->get_trigger = iio_get_trigger;
 	ops->set_trigger = iio_set_trigger;
 	ops->read_buffer = iio_read_buffer;
+	ops->read_buffer_zc = iio_read_buffer_zc;
+	ops->read_buffer_done = iio_read_buffer_done;
 	ops->write_buffer = iio_write_buffer;
 	ops->refill_buffer = iio_refill_buffer;
 	ops->push_buffer = iio_push_buffer;
@@ -1910,6 +2856,7 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->send = iio_send;
 	ops->recv = iio_recv;
 	ops->set_buffers_count = iio_set_buffers_count;
+	ops->get_names = iio_get_names;
 
 	iiod_param.instance = ldesc;
 	iiod_param.ops = ops;
@@ -1918,7 +2865,7 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_xml;
+		goto free_lookup;
 
 	ret = no_os_cb_init(&ldesc->conns,
 			    sizeof(uint32_t) * (IIOD_MAX_CONNECTIONS + 1));
@@ -1954,6 +2901,8 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 		ret = socket_listen(ldesc->server, MAX_BACKLOG);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto free_pylink;
+		ldesc->poll_timeout_ms = init_param->poll_timeout_ms;
+		ldesc->poll_supported = true;
 	}
 #endif
 	else if (init_param->phy_type == USE_LOCAL_BACKEND) {
@@ -1986,6 +2935,9 @@ free_conns:
 	no_os_cb_remove(ldesc->conns);
 free_iiod:
 	iiod_remove(ldesc->iiod);
+free_lookup:
+	no_os_free(ldesc->lookup);
+	no_os_free(ldesc->ch_ids);
 free_xml:
 	no_os_free(ldesc->xml_desc);
 free_trigs:
@@ -2015,7 +2967,7 @@ int iio_remove(struct iio_desc *desc)
 	for (int i = 0; i < IIOD_MAX_CONNECTIONS; i++) {
 		ret = iiod_conn_remove(desc->iiod, i, &data);
 		if (!ret) {
-			no_os_free(data.buf);
+			iio_conn_buf_free(data.buf);
 			socket_remove(data.conn);
 		}
 	}
@@ -2023,6 +2975,8 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	no_os_free(desc->lookup);
+	no_os_free(desc->ch_ids);
 	no_os_free(desc->devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
@@ -47,6 +47,7 @@
 
 #include "iio_types.h"
 #include "no_os_uart.h"
+#include "no_os_sample.h"
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 #include "tcp_socket.h"
 #endif
@@ -75,6 +76,25 @@ struct iio_device_init {
 	int8_t *raw_buf;
 	/* Length of raw_buf */
 	uint32_t raw_buf_len;
+	/**
+	 * If set, scans are stored in a single producer, single consumer
+	 * lock-free ring holding a power of 2 number of scans. The producer
+	 * (e.g. an interrupt handler calling iio_buffer_push_scan) and the
+	 * connection reading the data need no locking. When the ring is full
+	 * new scans are dropped. Only for input devices and not used for
+	 * cyclic buffers.
+	 */
+	bool lock_free;
+	/*
+	 * Number of blocks of the requested size stored in the buffer of an
+	 * input device, rounded up to a power of 2. With more than one, the
+	 * device can fill the next blocks with iio_buffer_get_block() and
+	 * iio_buffer_block_done() (e.g. from a DMA completion interrupt) while
+	 * READBUF sends the previous ones. 0 is the same as 1. Can be changed
+	 * by clients with the BUFFERS_COUNT command. Not used for triggered,
+	 * cyclic or lock-free buffers.
+	 */
+	uint32_t buffers_count;
 	/* If set, trigger will be linked to this device */
 	char *trigger_id;
 };
@@ -115,6 +135,13 @@ struct iio_init_param {
 		struct tcp_socket_init_param *tcp_socket_init_param;
 #endif
 	};
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	/*
+	 * Maximum time in milliseconds iio_step waits for network events when
+	 * all the connections are idle. 0 to never wait.
+	 */
+	uint32_t poll_timeout_ms;
+#endif
 	struct iio_local_backend *local_backend;
 	struct iio_ctx_attr *ctx_attrs;
 	uint32_t nb_ctx_attr;
@@ -147,7 +174,10 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 		     int32_t size, int32_t *vals);
 
 /* DMA buffer functions. */
-/* Get buffer addr where to write iio_buffer.size bytes */
+/*
+ * Get buffer addr where to write iio_buffer.size bytes. Returns -EAGAIN when
+ * all the blocks of a multi-block buffer wait to be sent.
+ */
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr);
 /* To be called to mark last iio_buffer_read as done */
 int iio_buffer_block_done(struct iio_buffer *buffer);
@@ -157,5 +187,22 @@ int iio_buffer_block_done(struct iio_buffer *buffer);
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
+/*
+ * Unpack the samples of the enabled channels out of raw, one fmt sample for
+ * each of the first nb_channels scan indexes, and push them as a scan of 16 or
+ * 32 bit samples.
+ */
+int iio_buffer_push_raw_scan(struct iio_buffer *buffer,
+			     const struct no_os_sample_fmt *fmt,
+			     const uint8_t *raw, uint32_t nb_channels);
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+#ifdef NO_OS_ALLOC_POOL
+#include "no_os_pool.h"
+
+/* Get the arena network connection buffers are allocated from */
+struct no_os_arena *iio_get_conn_arena(void);
+#endif
+#endif
 
 #endif /* IIO_H_ */
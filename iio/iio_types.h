@@ -46,6 +46,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -224,6 +225,15 @@ struct iio_buffer {
 	enum iio_buffer_direction dir;
 	/* Buffer where data is stored */
 	struct no_os_circular_buffer *buf;
+	/* Set instead of buf when the device uses a lock-free buffer */
+	struct no_os_spsc_ring *ring;
+	/*
+	 * Set instead of buf when an input buffer holds several blocks. Each
+	 * element of the ring is a block of size bytes.
+	 */
+	struct no_os_spsc_ring *blocks;
+	/* Set from iio_buffer_get_block until iio_buffer_block_done */
+	volatile bool block_pending;
 	/* Stores cyclic buffer specific information */
 	struct iio_cyclic_buffer_info cyclic_info;
 };
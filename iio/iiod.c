@@ -40,7 +40,6 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 #include <assert.h>
 
 #include "iiod.h"
@@ -75,7 +74,8 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_BINARY]	= IIOD_STR("BINARY")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -93,7 +93,16 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
 	IIOD_CMD_HELP,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY
+};
+
+/* Attribute types of the binary READ and WRITE ops, in op order */
+static const enum iio_attr_type bin_attr_types[] = {
+	IIO_ATTR_TYPE_DEVICE,
+	IIO_ATTR_TYPE_DEBUG,
+	IIO_ATTR_TYPE_BUFFER,
+	IIO_ATTR_TYPE_CH_IN
 };
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
@@ -122,10 +131,10 @@ static int32_t parse_cmd(const char *token, struct comand_desc *res)
 
 static int32_t parse_num(const char *token, uint32_t *res, uint32_t base)
 {
-	char *end_ptr;
+	uint32_t n;
 
-	*res = strtoul(token, &end_ptr, base);
-	if (*res == 0 && *end_ptr != '\0')
+	n = no_os_str_parse_uint32(token, base, res);
+	if (*res == 0 && token[n] != '\0')
 		return -EINVAL;
 
 	return 0;
@@ -246,6 +255,7 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
 	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
 		return parse_num(token, &res->timeout, 10);
@@ -323,6 +333,14 @@ static int dummy_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 	return -EINVAL;
 }
 
+static int dummy_get_names(struct iiod_ctx *ctx, uint32_t dev_idx,
+			   enum iio_attr_type *type, int32_t ch_idx,
+			   int32_t attr_idx, char *device, char *channel,
+			   char *attr)
+{
+	return -EINVAL;
+}
+
 int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 {
 	if (!new_ops->recv || !new_ops->send)
@@ -339,9 +357,15 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 	ops->write_attr = SET_DUMMY_IF_NULL(new_ops->write_attr, dummy_rw_attr);
 	ops->get_trigger = SET_DUMMY_IF_NULL(new_ops->get_trigger, dummy_rd_data);
 	ops->set_trigger = SET_DUMMY_IF_NULL(new_ops->set_trigger, dummy_wr_data);
+	ops->get_names = SET_DUMMY_IF_NULL(new_ops->get_names, dummy_get_names);
 	ops->set_timeout = SET_DUMMY_IF_NULL(new_ops->set_timeout, dummy_set_timeout);
 	ops->set_buffers_count = SET_DUMMY_IF_NULL(new_ops->set_buffers_count,
 				 dummy_set_buffers_count);
+	/* Zero-copy reads are used only if both ops are provided */
+	if (new_ops->read_buffer_zc && new_ops->read_buffer_done) {
+		ops->read_buffer_zc = new_ops->read_buffer_zc;
+		ops->read_buffer_done = new_ops->read_buffer_done;
+	}
 	ops->refill_buffer = SET_DUMMY_IF_NULL(new_ops->refill_buffer,
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
@@ -392,7 +416,8 @@ static void conn_clean_state(struct iiod_conn_priv *conn)
 	conn->res.buf.buf = NULL;
 	conn->res.buf.idx = 0;
 	conn->parser_idx = 0;
-	conn->state = IIOD_READING_LINE;
+	conn->state = conn->binary ? IIOD_READING_BIN_HEADER :
+		      IIOD_READING_LINE;
 }
 
 int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
@@ -411,12 +436,13 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 			conn->used = 1;
 			conn->conn = data->conn;
 			/*
-			 * TODO in future:
-			 * think of using other buffer (e.g. ciruclar_buffer)
-			 * to somehow implement zero copy
+			 * Not used by READBUF when the application provides
+			 * read_buffer_zc, data is then sent from the device
+			 * buffer directly.
 			 */
 			conn->payload_buf = data->buf;
 			conn->payload_buf_len = data->len;
+			conn->buffered_recv = data->buffered_recv;
 			*new_conn_id = i;
 
 			return 0;
@@ -436,6 +462,7 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 	data->conn = conn->conn;
 	data->len = conn->payload_buf_len;
 	data->buf = conn->payload_buf;
+	data->buffered_recv = conn->buffered_recv;
 	conn->used = 0;
 
 	return 0;
@@ -466,6 +493,26 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 	return -EINVAL;
 }
 
+/*
+ * Receive data on a connection. Bytes left in rx_buf by iiod_read_line are
+ * returned first.
+ */
+static int32_t iiod_recv(struct iiod_desc *desc, struct iiod_conn_priv *conn,
+			 uint8_t *buf, uint32_t len)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (conn->rx_idx < conn->rx_len) {
+		len = no_os_min(len, conn->rx_len - conn->rx_idx);
+		memcpy(buf, conn->rx_buf + conn->rx_idx, len);
+		conn->rx_idx += len;
+
+		return len;
+	}
+
+	return desc->ops.recv(&ctx, buf, len);
+}
+
 /*
  * Unload data from buf without blocking.
  * When done will return 0, if there is still data to be sent it will return
@@ -485,7 +532,7 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 		if (flags & IIOD_WR)
 			ret = desc->ops.send(&ctx, tmp_buf, len);
 		else
-			ret = desc->ops.recv(&ctx, tmp_buf, len);
+			ret = iiod_recv(desc, conn, tmp_buf, len);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
@@ -506,11 +553,57 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 	return 0;
 }
 
+/*
+ * Send data straight from the device buffer, without copying it in
+ * payload_buf. The region is released only after the connection accepted it.
+ */
+static int32_t do_read_buff_zc(struct iiod_desc *desc,
+			       struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+
+	if (conn->nb_buf.len == 0) {
+		ret = desc->ops.read_buffer_zc(&ctx, conn->cmd_data.device,
+					       &conn->nb_buf.buf,
+					       conn->cmd_data.bytes_count);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		conn->nb_buf.len = ret;
+		conn->nb_buf.idx = 0;
+	}
+
+	ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+	if (ret == -EAGAIN)
+		return ret;
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		/* Give back the region, keeping what was already sent */
+		desc->ops.read_buffer_done(&ctx, conn->cmd_data.device,
+					   conn->nb_buf.idx);
+		return ret;
+	}
+
+	ret = desc->ops.read_buffer_done(&ctx, conn->cmd_data.device,
+					 conn->nb_buf.len);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->cmd_data.bytes_count -= conn->nb_buf.len;
+	conn->nb_buf.len = 0;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
+	return 0;
+}
+
 static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 {
 	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
 	int32_t ret, len;
 
+	if (desc->ops.read_buffer_zc)
+		return do_read_buff_zc(desc, conn);
+
 	if (conn->nb_buf.len == 0) {
 		conn->nb_buf.buf = conn->payload_buf;
 		len = no_os_min(conn->payload_buf_len,
@@ -651,7 +744,7 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			break;
 		}
 		conn->res.val = data->bytes_count;
-		ret = snprintf(conn->buf_mask, 10, "%08"PRIx32, conn->mask);
+		ret = no_os_uint32_to_hex_str(conn->buf_mask, conn->mask, 8);
 		conn->res.buf.buf = conn->buf_mask;
 		conn->res.buf.len = ret;
 		break;
@@ -659,6 +752,80 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.val = data->bytes_count;
 		conn->res.write_val = 1;
 		break;
+	case IIOD_CMD_BINARY:
+		conn->res.write_val = 1;
+		if (desc->ops.get_names == dummy_get_names) {
+			conn->res.val = -ENOSYS;
+			break;
+		}
+		/* Next command will be read as a binary header */
+		conn->res.val = 0;
+		conn->binary = true;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Fill cmd_data with the values in the binary header. No I/O */
+static int32_t iiod_bin_parse_header(struct iiod_conn_priv *conn)
+{
+	struct comand_desc *data = &conn->cmd_data;
+	uint8_t op = conn->bin_hdr[2];
+	int32_t code = (int32_t)no_os_get_unaligned_le32(conn->bin_hdr + 4);
+
+	switch (op) {
+	case IIOD_OP_PRINT:
+		data->cmd = IIOD_CMD_PRINT;
+		break;
+	case IIOD_OP_TIMEOUT:
+		data->cmd = IIOD_CMD_TIMEOUT;
+		data->timeout = code;
+		break;
+	case IIOD_OP_READ_ATTR:
+	case IIOD_OP_READ_DBG_ATTR:
+	case IIOD_OP_READ_BUF_ATTR:
+	case IIOD_OP_READ_CHN_ATTR:
+		data->cmd = IIOD_CMD_READ;
+		data->type = bin_attr_types[op - IIOD_OP_READ_ATTR];
+		break;
+	case IIOD_OP_WRITE_ATTR:
+	case IIOD_OP_WRITE_DBG_ATTR:
+	case IIOD_OP_WRITE_BUF_ATTR:
+	case IIOD_OP_WRITE_CHN_ATTR:
+		data->cmd = IIOD_CMD_WRITE;
+		data->type = bin_attr_types[op - IIOD_OP_WRITE_ATTR];
+		break;
+	case IIOD_OP_GETTRIG:
+		data->cmd = IIOD_CMD_GETTRIG;
+		break;
+	case IIOD_OP_SETTRIG:
+		data->cmd = IIOD_CMD_SETTRIG;
+		break;
+	case IIOD_OP_OPEN:
+		data->cmd = IIOD_CMD_OPEN;
+		data->sample_count = code;
+		break;
+	case IIOD_OP_CLOSE:
+		data->cmd = IIOD_CMD_CLOSE;
+		break;
+	case IIOD_OP_READBUF:
+	case IIOD_OP_WRITEBUF:
+		if (code < 0)
+			return -EINVAL;
+		data->cmd = op == IIOD_OP_READBUF ? IIOD_CMD_READBUF :
+			    IIOD_CMD_WRITEBUF;
+		data->bytes_count = code;
+		break;
+	case IIOD_OP_SET_BUFFERS_COUNT:
+		data->cmd = IIOD_CMD_SET;
+		data->count = code;
+		break;
+	case IIOD_OP_EXIT:
+		data->cmd = IIOD_CMD_EXIT;
+		break;
 	default:
 		return -EINVAL;
 	}
@@ -666,30 +833,122 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	return 0;
 }
 
+/* Translate the indexes of a binary command in names. No I/O */
+static int32_t iiod_bin_get_names(struct iiod_desc *desc,
+				  struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct comand_desc *data = &conn->cmd_data;
+	int32_t code = (int32_t)no_os_get_unaligned_le32(conn->bin_hdr + 4);
+	uint32_t dev = conn->bin_hdr[3];
+	int32_t ch_idx = -1;
+	int32_t ret;
+
+	switch (data->cmd) {
+	case IIOD_CMD_PRINT:
+	case IIOD_CMD_TIMEOUT:
+	case IIOD_CMD_EXIT:
+		return 0;
+	case IIOD_CMD_READ:
+	case IIOD_CMD_WRITE:
+		if (code < 0)
+			return -EINVAL;
+		if (data->type == IIO_ATTR_TYPE_CH_IN) {
+			ch_idx = (uint32_t)code >> 16;
+			code &= 0xFFFF;
+		}
+
+		return desc->ops.get_names(&ctx, dev, &data->type, ch_idx, code,
+					   data->device, data->channel,
+					   data->attr);
+	case IIOD_CMD_SETTRIG:
+		/* data->trigger stays empty to remove the trigger */
+		if (code >= 0) {
+			ret = desc->ops.get_names(&ctx, code, &data->type, -1,
+						  -1, data->trigger, NULL,
+						  NULL);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return desc->ops.get_names(&ctx, dev, &data->type, -1, -1,
+				   data->device, NULL, NULL);
+}
+
+/* Execute a binary command and select the state sending its result. No I/O */
+static int32_t iiod_bin_run_cmd(struct iiod_desc *desc,
+				struct iiod_conn_priv *conn)
+{
+	int32_t ret;
+
+	ret = iiod_bin_get_names(desc, conn);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		/* The data following WRITEBUF can't be skipped */
+		if (conn->cmd_data.cmd == IIOD_CMD_WRITEBUF)
+			return -ENOTCONN;
+
+		conn->res.val = ret;
+		conn->state = IIOD_WRITING_BIN_RESULT;
+
+		return 0;
+	}
+
+	ret = iiod_run_cmd(desc, conn);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (conn->cmd_data.cmd == IIOD_CMD_READBUF)
+		/* Buffer data follows the header, the mask is not sent */
+		memset(&conn->res.buf, 0, sizeof(conn->res.buf));
+
+	if (conn->cmd_data.cmd == IIOD_CMD_WRITEBUF) {
+		/* The result is sent after the data is received */
+		memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+		conn->state = IIOD_RW_BUF;
+	} else {
+		conn->state = IIOD_WRITING_BIN_RESULT;
+	}
+
+	return 0;
+}
+
+/*
+ * Read a line in parser_buf. Data is received in rx_buf, in bulk if
+ * buffered_recv is set, and the bytes following the line are kept there for
+ * the next command.
+ */
 static int32_t iiod_read_line(struct iiod_desc *desc,
 			      struct iiod_conn_priv *conn)
 {
-	struct iiod_ctx ctx = {
-		.instance = desc->app_instance,
-		.conn = conn->conn
-	};
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
 	int32_t ret;
-	char *ch;
+	char ch;
 
 	while (conn->parser_idx < IIOD_PARSER_MAX_BUF_SIZE - 1) {
-		ch = conn->parser_buf + conn->parser_idx;
-		ret = desc->ops.recv(&ctx,(uint8_t *)ch, 1);
-		if (ret == -EAGAIN || ret == 0)
-			return -EAGAIN;
+		if (conn->rx_idx == conn->rx_len) {
+			ret = desc->ops.recv(&ctx, conn->rx_buf,
+					     conn->buffered_recv ?
+					     sizeof(conn->rx_buf) : 1);
+			if (ret == -EAGAIN || ret == 0)
+				return -EAGAIN;
 
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto end;
+			if (NO_OS_IS_ERR_VALUE(ret))
+				goto end;
 
-		if (conn->parser_idx == 0 && (*ch == '\n' || *ch == '\r'))
+			conn->rx_idx = 0;
+			conn->rx_len = ret;
+		}
+
+		ch = conn->rx_buf[conn->rx_idx++];
+		if (conn->parser_idx == 0 && (ch == '\n' || ch == '\r'))
 			continue ;
 
-		++conn->parser_idx;
-		if (*ch == '\n') {
+		conn->parser_buf[conn->parser_idx++] = ch;
+		if (ch == '\n') {
 			conn->parser_buf[conn->parser_idx] = '\0';
 			ret = 0;
 			goto end;
@@ -744,6 +1003,9 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 		return 0;
 	case IIOD_RUNNING_CMD:
+		if (conn->binary)
+			return iiod_bin_run_cmd(desc, conn);
+
 		/* Execute or call necessary ops depending on cmd. No I/O */
 		ret = iiod_run_cmd(desc, conn);
 		if (NO_OS_IS_ERR_VALUE(ret))
@@ -757,8 +1019,8 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		if (conn->res.write_val) {
 			if (conn->nb_buf.len == 0) {
 				conn->nb_buf.buf = conn->parser_buf;
-				ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
-					      conn->res.val);
+				ret = no_os_int32_to_str(conn->nb_buf.buf,
+							 conn->res.val);
 				conn->nb_buf.len = ret;
 				conn->nb_buf.idx = 0;
 			}
@@ -805,11 +1067,21 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 							    conn->cmd_data.device);
 				if (NO_OS_IS_ERR_VALUE(ret)) {
 					conn->res.val = ret;
-					conn->state = IIOD_LINE_DONE;
+					conn->state = conn->binary ?
+						      IIOD_WRITING_BIN_RESULT :
+						      IIOD_LINE_DONE;
 
 					return 0;
 				}
 				memset(&conn->res.buf, 0, sizeof(conn->res.buf));
+				if (conn->binary) {
+					/* Number of bytes requested in header */
+					conn->res.val = no_os_get_unaligned_le32(
+								conn->bin_hdr + 4);
+					conn->state = IIOD_WRITING_BIN_RESULT;
+
+					return 0;
+				}
 				conn->res.val = conn->cmd_data.bytes_count;
 				conn->cmd_data.cmd = IIOD_CMD_PRINT;
 				conn->state = IIOD_WRITING_CMD_RESULT;
@@ -862,7 +1134,94 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 			conn->is_cyclic_buffer = false;
 		}
 		return 0;
+	case IIOD_READING_BIN_HEADER:
+		if (conn->nb_buf.len == 0) {
+			conn->nb_buf.buf = (char *)conn->bin_hdr;
+			conn->nb_buf.len = IIOD_BIN_HDR_SIZE;
+			conn->nb_buf.idx = 0;
+		}
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+		ret = iiod_bin_parse_header(conn);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			if (conn->bin_hdr[2] == IIOD_OP_WRITEBUF)
+				return -ENOTCONN;
+
+			conn->res.val = ret;
+			conn->state = IIOD_WRITING_BIN_RESULT;
+		} else if (conn->cmd_data.cmd == IIOD_CMD_WRITE ||
+			   conn->cmd_data.cmd == IIOD_CMD_OPEN) {
+			conn->state = IIOD_READING_BIN_ARG;
+		} else {
+			conn->state = IIOD_RUNNING_CMD;
+		}
+
+		return 0;
+	case IIOD_READING_BIN_ARG:
+		if (conn->nb_buf.len == 0) {
+			conn->nb_buf.buf = (char *)conn->bin_arg;
+			conn->nb_buf.len = IIOD_BIN_ARG_SIZE;
+			conn->nb_buf.idx = 0;
+		}
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (conn->cmd_data.cmd == IIOD_CMD_OPEN) {
+			conn->cmd_data.mask = no_os_get_unaligned_le32(conn->bin_arg);
+			conn->cmd_data.cyclic =
+				no_os_get_unaligned_le32(conn->bin_arg + 4) & 1;
+			memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+			conn->state = IIOD_RUNNING_CMD;
+
+			return 0;
+		}
+
+		/* 64 bits attribute value length. It must fit in payload_buf */
+		conn->cmd_data.bytes_count = no_os_get_unaligned_le32(conn->bin_arg);
+		if (no_os_get_unaligned_le32(conn->bin_arg + 4) ||
+		    conn->cmd_data.bytes_count >= conn->payload_buf_len)
+			return -ENOTCONN;
+
+		conn->nb_buf.buf = conn->payload_buf;
+		conn->nb_buf.len = conn->cmd_data.bytes_count;
+		conn->nb_buf.idx = 0;
+		conn->state = IIOD_READING_WRITE_DATA;
+
+		return 0;
+	case IIOD_WRITING_BIN_RESULT:
+		if (conn->nb_buf.len == 0) {
+			conn->bin_hdr[2] = IIOD_OP_RESPONSE;
+			no_os_put_unaligned_le32(conn->res.val, conn->bin_hdr + 4);
+			conn->nb_buf.buf = (char *)conn->bin_hdr;
+			conn->nb_buf.len = IIOD_BIN_HDR_SIZE;
+			conn->nb_buf.idx = 0;
+		}
+		/* Non-blocking. Will enter here until header is sent */
+		if (conn->nb_buf.idx < conn->nb_buf.len) {
+			ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+		if (conn->res.buf.buf &&
+		    conn->res.buf.idx < conn->res.buf.len) {
+			ret = rw_iiod_buff(desc, conn, &conn->res.buf, IIOD_WR);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+
+		if (conn->cmd_data.cmd == IIOD_CMD_READBUF &&
+		    !NO_OS_IS_ERR_VALUE((int32_t)conn->res.val)) {
+			memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+			conn->state = IIOD_RW_BUF;
+		} else {
+			conn->state = IIOD_LINE_DONE;
+		}
 
+		return 0;
 	default:
 		/* Should never get here */
 		return -EINVAL;
@@ -892,3 +1251,19 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 
 	return ret;
 }
+
+bool iiod_conn_is_idle(struct iiod_desc *desc, uint32_t conn_id)
+{
+	struct iiod_conn_priv *conn;
+
+	if (!desc || conn_id >= IIOD_MAX_CONNECTIONS ||
+	    !desc->conns[conn_id].used)
+		return false;
+
+	conn = &desc->conns[conn_id];
+	if (conn->state != IIOD_READING_LINE &&
+	    conn->state != IIOD_READING_BIN_HEADER)
+		return false;
+
+	return conn->rx_idx >= conn->rx_len;
+}
@@ -86,6 +86,12 @@ struct iiod_conn_data {
 	char *buf;
 	/* Size of the provided buffer. It must fit the max attribute size */
 	uint32_t len;
+	/*
+	 * Set if recv returns the bytes available without waiting for len
+	 * bytes (e.g. sockets). Command lines are then received in bulk
+	 * instead of one byte at a time.
+	 */
+	bool buffered_recv;
 };
 
 /* Functions should return a negative error code on failure */
@@ -118,6 +124,20 @@ struct iiod_ops {
 	/* Read data from opened buffer */
 	int (*read_buffer)(struct iiod_ctx *ctx, const char *device, char *buf,
 			   uint32_t bytes);
+	/*
+	 * Optional zero-copy alternative to read_buffer.
+	 * Set buf to a contiguous region of the opened buffer holding at most
+	 * bytes and return its length. The region is sent directly on the
+	 * connection and must stay valid until read_buffer_done is called.
+	 */
+	int (*read_buffer_zc)(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes);
+	/*
+	 * Release the region returned by read_buffer_zc. Only the first bytes
+	 * of the region were consumed by the connection.
+	 */
+	int (*read_buffer_done)(struct iiod_ctx *ctx, const char *device,
+				uint32_t bytes);
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
 
@@ -146,6 +166,19 @@ struct iiod_ops {
 	int (*set_trigger)(struct iiod_ctx *ctx, const char *device,
 			   const char *trigger, uint32_t len);
 
+	/*
+	 * Used by the binary protocol to translate the xml indexes of a device
+	 * (or trigger), channel and attribute in the names used by the other
+	 * ops. ch_idx and attr_idx are negative when not used. For channel
+	 * attributes, type is updated with the direction of the channel.
+	 * device, channel and attr have MAX_DEV_ID, MAX_CHN_ID and
+	 * MAX_ATTR_NAME bytes.
+	 */
+	int (*get_names)(struct iiod_ctx *ctx, uint32_t dev_idx,
+			 enum iio_attr_type *type, int32_t ch_idx,
+			 int32_t attr_idx, char *device, char *channel,
+			 char *attr);
+
 	/* I don't know what this should be used for :) */
 	int (*set_timeout)(struct iiod_ctx *ctx, uint32_t timeout);
 
@@ -190,5 +223,10 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data);
 /* Advance in the state machine of a connection. Will not block */
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id);
+/*
+ * Check if a connection is waiting for a new command and has no received data
+ * left. Such a connection can only make progress after new data arrives.
+ */
+bool iiod_conn_is_idle(struct iiod_desc *desc, uint32_t conn_id);
 
 #endif //IIOD_H
@@ -44,6 +44,7 @@
 #define IIOD_ENDL			0x2
 #define IIOD_RD				0x4
 #define IIOD_PARSER_MAX_BUF_SIZE	128
+#define IIOD_RX_BUF_SIZE		IIOD_PARSER_MAX_BUF_SIZE
 
 #define IIOD_STR(cmd) {(cmd), sizeof(cmd) - 1}
 
@@ -75,9 +76,64 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY
 };
 
+/*
+ * Binary protocol, selected by sending the BINARY text command (answered with
+ * "0\n" before switching). Every command and every response starts with an
+ * 8 bytes little endian header:
+ *   client_id (16 bits) | op (8 bits) | dev (8 bits) | code (32 bits, signed)
+ * Responses have op set to IIOD_OP_RESPONSE, echo client_id and dev and carry
+ * the result (or a negative error code) in code, followed by response data if
+ * any. client_id is not interpreted and allows the client to multiplex
+ * several streams (e.g. buffer and attribute accesses) on a connection.
+ * Devices, channels and attributes are referenced by their index in the xml:
+ *   dev  - device index (triggers follow the devices).
+ *   code - attribute index or, for channel attributes,
+ *	    (channel index << 16) | attribute index.
+ * For debug attributes, the index following the last debug attribute is
+ * direct_reg_access.
+ */
+enum iiod_bin_op {
+	/* Response to a command */
+	IIOD_OP_RESPONSE,
+	/* Response data: xml (code is the xml length) */
+	IIOD_OP_PRINT,
+	/* code: timeout */
+	IIOD_OP_TIMEOUT,
+	/* Response data: attribute value (code is its length) */
+	IIOD_OP_READ_ATTR,
+	IIOD_OP_READ_DBG_ATTR,
+	IIOD_OP_READ_BUF_ATTR,
+	IIOD_OP_READ_CHN_ATTR,
+	/* Payload: value length (64 bits) followed by the value */
+	IIOD_OP_WRITE_ATTR,
+	IIOD_OP_WRITE_DBG_ATTR,
+	IIOD_OP_WRITE_BUF_ATTR,
+	IIOD_OP_WRITE_CHN_ATTR,
+	/* Response data: trigger name (code is its length) */
+	IIOD_OP_GETTRIG,
+	/* code: device index of the trigger, -1 to remove the trigger */
+	IIOD_OP_SETTRIG,
+	/* code: samples. Payload: mask (32 bits), flags (32 bits, bit 0 cyclic) */
+	IIOD_OP_OPEN,
+	IIOD_OP_CLOSE,
+	/* code: bytes. Response data: buffer data (code is its length) */
+	IIOD_OP_READBUF,
+	/* code: bytes. Payload: buffer data */
+	IIOD_OP_WRITEBUF,
+	/* code: buffers count */
+	IIOD_OP_SET_BUFFERS_COUNT,
+	IIOD_OP_EXIT,
+	IIOD_NB_OPCODES
+};
+
+/* Size of the binary header and of the fixed size payloads */
+#define IIOD_BIN_HDR_SIZE		8
+#define IIOD_BIN_ARG_SIZE		8
+
 /*
  * Structure to be filled after a command is parsed.
  * Depending of cmd some fields are set or not
@@ -140,8 +196,29 @@ struct iiod_conn_priv {
 		IIOD_LINE_DONE,
 		/* Pushing  cyclic buffer until IIO device is closed  */
 		IIOD_PUSH_CYCLIC_BUFFER,
+		/* Reading the header of a binary command */
+		IIOD_READING_BIN_HEADER,
+		/* Reading the fixed size payload of a binary command */
+		IIOD_READING_BIN_ARG,
+		/* Write the header and data of a binary response */
+		IIOD_WRITING_BIN_RESULT,
 	} state;
 
+	/* Set after the BINARY command was executed */
+	bool binary;
+	/* Header of the current binary command, reused for the response */
+	uint8_t bin_hdr[IIOD_BIN_HDR_SIZE];
+	/* Fixed size payload of the current binary command */
+	uint8_t bin_arg[IIOD_BIN_ARG_SIZE];
+
+	/* Received bytes not yet consumed (next lines or WRITE payload) */
+	uint8_t rx_buf[IIOD_RX_BUF_SIZE];
+	/* Index of the first unconsumed byte in rx_buf */
+	uint32_t rx_idx;
+	/* Number of valid bytes in rx_buf */
+	uint32_t rx_len;
+	/* Set if recv can be called with more than one byte for a line */
+	bool buffered_recv;
 	/* Buffer to store received line */
 	char parser_buf[IIOD_PARSER_MAX_BUF_SIZE];
 	/* Index in parser_buf. For nonblocking operation */
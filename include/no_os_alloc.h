@@ -52,4 +52,11 @@ void *no_os_calloc(size_t nitems, size_t size);
  * no_os_malloc */
 void no_os_free(void *ptr);
 
+#ifdef NO_OS_ALLOC_POOL
+#include "no_os_pool.h"
+
+/* Get the arena serving the allocations above */
+struct no_os_arena *no_os_alloc_get_arena(void);
+#endif
+
 #endif // _NO_OS_ALLOC_H_
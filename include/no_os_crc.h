@@ -43,4 +43,73 @@
 #include "no_os_crc16.h"
 #include "no_os_crc24.h"
 
+#include <stdbool.h>
+
+#define NO_OS_CRC_TABLE_SIZE	256
+
+/**
+ * @enum no_os_crc_slice
+ * @brief Number of bytes folded per table lookup round.
+ */
+enum no_os_crc_slice {
+	/** Classic byte at a time lookup, 1KiB table */
+	NO_OS_CRC_SLICE_BY_1 = 1,
+	/** 4 bytes per round, 4KiB table */
+	NO_OS_CRC_SLICE_BY_4 = 4,
+	/** 8 bytes per round, 8KiB table */
+	NO_OS_CRC_SLICE_BY_8 = 8,
+};
+
+/**
+ * @struct no_os_crc_param
+ * @brief CRC algorithm description, using the usual width/poly/init/reflect/
+ * xorout model. As an example, the CRC-32 used by Ethernet is
+ * { 32, 0x04C11DB7, 0xFFFFFFFF, true, 0xFFFFFFFF }.
+ */
+struct no_os_crc_param {
+	/** CRC width in bits, 1 to 32 */
+	uint8_t width;
+	/** Msb-first polynomial, without the x^width term */
+	uint32_t poly;
+	/** Initial register value, not reflected */
+	uint32_t init;
+	/** Data is processed lsb first and the result is reflected */
+	bool reflect;
+	/** Value XOR-ed to the register at the end of the computation */
+	uint32_t xor_out;
+};
+
+/**
+ * @struct no_os_crc_desc
+ * @brief CRC engine descriptor.
+ */
+struct no_os_crc_desc {
+	/** CRC algorithm */
+	struct no_os_crc_param param;
+	/** Number of lookup tables */
+	enum no_os_crc_slice slice;
+	/** slice lookup tables, table k accounts for k extra zero bytes */
+	uint32_t *table;
+};
+
+/* Generate the slice lookup tables of a CRC algorithm. */
+int no_os_crc_populate(uint32_t *table, const struct no_os_crc_param *param,
+		       enum no_os_crc_slice slice);
+/* Allocate the descriptor and generate its lookup tables. */
+int no_os_crc_init(struct no_os_crc_desc **desc,
+		   const struct no_os_crc_param *param,
+		   enum no_os_crc_slice slice);
+/* Free the resources allocated by no_os_crc_init(). */
+int no_os_crc_remove(struct no_os_crc_desc *desc);
+/* Get the register value a new computation starts from. */
+uint32_t no_os_crc_start(const struct no_os_crc_desc *desc);
+/* Fold a buffer into the register. */
+uint32_t no_os_crc_update(const struct no_os_crc_desc *desc, uint32_t reg,
+			  const uint8_t *pdata, size_t nbytes);
+/* Convert the register value to the CRC. */
+uint32_t no_os_crc_finish(const struct no_os_crc_desc *desc, uint32_t reg);
+/* Compute the CRC of a buffer in one go. */
+uint32_t no_os_crc_compute(const struct no_os_crc_desc *desc,
+			   const uint8_t *pdata, size_t nbytes);
+
 #endif // _NO_OS_CRC_H_
@@ -47,6 +47,8 @@
 #define NO_OS_DECLARE_CRC8_TABLE(_table) \
 	static uint8_t _table[NO_OS_CRC8_TABLE_SIZE]
 
+extern const uint8_t no_os_crc8_msb_07_table[NO_OS_CRC8_TABLE_SIZE];
+
 void no_os_crc8_populate_msb(uint8_t * table, const uint8_t polynomial);
 uint8_t no_os_crc8(const uint8_t * table, const uint8_t *pdata, size_t nbytes,
 		   uint8_t crc);
@@ -43,11 +43,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
-#include "no_os_list.h"
 #include "no_os_irq.h"
 #include "no_os_mutex.h"
 
+/* Default number of transfers that can be queued on a channel */
+#ifndef NO_OS_DMA_SG_RING_SIZE
+#define NO_OS_DMA_SG_RING_SIZE	32
+#endif
+
 /**
  * @enum no_os_dma_xfer_type
  * @brief Supported transfer directions
@@ -115,8 +120,19 @@ struct no_os_dma_ch {
 	uint32_t id;
 	/** Whether or not there is a transfer in progress on this channel */
 	bool free;
-	/** List of transfers for this channel */
-	struct no_os_list_desc *sg_list;
+	/** Ring of the transfers queued on this channel */
+	struct no_os_dma_xfer_desc **sg_ring;
+	/** Number of entries in the ring */
+	uint32_t sg_ring_size;
+	/** Index of the current transfer in the ring */
+	uint32_t sg_head;
+	/** Number of transfers in the ring, including the current one */
+	uint32_t sg_count;
+	/**
+	 * The transfers are queued again as they complete, until the channel
+	 * is aborted
+	 */
+	bool cyclic;
 	/** Channel specific interrupt line number */
 	uint32_t irq_num;
 	/** IRQ parameter for the default inter transfer handler */
@@ -187,6 +203,11 @@ struct no_os_dma_init_param {
 	 * order to use the default one.
 	 */
 	void (*sg_handler)(void *);
+	/**
+	 * Maximum number of transfers queued on a channel. 0 for
+	 * NO_OS_DMA_SG_RING_SIZE
+	 */
+	uint32_t sg_ring_size;
 	/**
 	 * Optional custom parameter for the scatter gather callback. Only takes
 	 * effect if the handler is also provided.
@@ -207,6 +228,15 @@ int no_os_dma_config_xfer(struct no_os_dma_desc *,
 			  uint32_t,
 			  struct no_os_dma_ch *);
 
+/**
+ * Acquire a channel and add the transfers to it's SG list. The transfers
+ * are repeated until the channel is aborted.
+ */
+int no_os_dma_config_xfer_cyclic(struct no_os_dma_desc *,
+				 struct no_os_dma_xfer_desc *,
+				 uint32_t,
+				 struct no_os_dma_ch *);
+
 /** Prevent a channel from being acquired, even if it's free. */
 int no_os_dma_chan_lock(struct no_os_dma_ch *);
 
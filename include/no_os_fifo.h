@@ -52,6 +52,10 @@
 /**
  * @struct no_os_fifo_element
  * @brief Structure holding the fifo element parameters.
+ *
+ * Each element is a single allocation holding a copy of the inserted data.
+ * Code that can bound the buffered data should use no_os_spsc_ring instead,
+ * which never allocates and can be filled from interrupt handlers.
  */
 struct no_os_fifo_element {
 	/** next FIFO element */
@@ -60,6 +64,8 @@ struct no_os_fifo_element {
 	char *data;
 	/** FIFO length */
 	uint32_t len;
+	/** Last FIFO element, only valid in the head element */
+	struct no_os_fifo_element *last;
 };
 
 /******************************************************************************/
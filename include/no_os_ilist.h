@@ -0,0 +1,231 @@
+/***************************************************************************//**
+ *   @file   no_os_ilist.h
+ *   @brief  Intrusive doubly linked list.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_ILIST_H_
+#define _NO_OS_ILIST_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @struct no_os_ilist_node
+ * @brief Link node embedded in the listed structure.
+ *
+ * Unlike no_os_list, which allocates an element per insert, the caller embeds
+ * the node in its own structure, so none of the operations below allocate
+ * and all of them except the lookups are O(1). They are usable from
+ * interrupt context; serializing concurrent accesses is up to the caller.
+ *
+ * A list head is a node pointing to itself when the list is empty:
+ * @code{.c}
+ * struct my_event {
+ *	uint32_t id;
+ *	struct no_os_ilist_node node;
+ * };
+ *
+ * static struct no_os_ilist_node events = NO_OS_ILIST_HEAD_INIT(events);
+ *
+ * no_os_ilist_add_last(&events, &ev->node);
+ * ...
+ * node = no_os_ilist_get_first(&events);
+ * if (node)
+ *	ev = no_os_ilist_entry(node, struct my_event, node);
+ * @endcode
+ */
+struct no_os_ilist_node {
+	/** Next node, or the head for the last node */
+	struct no_os_ilist_node *next;
+	/** Previous node, or the head for the first node */
+	struct no_os_ilist_node *prev;
+};
+
+/** Static initializer of an empty list head */
+#define NO_OS_ILIST_HEAD_INIT(_head)	{ &(_head), &(_head) }
+
+/** Get the structure a node is embedded in */
+#define no_os_ilist_entry(_node, _type, _member) \
+	((_type *)((char *)(_node) - offsetof(_type, _member)))
+
+/** Iterate over the nodes of a list */
+#define no_os_ilist_for_each(_pos, _head) \
+	for ((_pos) = (_head)->next; (_pos) != (_head); (_pos) = (_pos)->next)
+
+/** Iterate over the nodes of a list, the current node may be deleted */
+#define no_os_ilist_for_each_safe(_pos, _tmp, _head) \
+	for ((_pos) = (_head)->next, (_tmp) = (_pos)->next; (_pos) != (_head); \
+	     (_pos) = (_tmp), (_tmp) = (_pos)->next)
+
+/**
+ * @brief Initialize a list head, or a node so that it reads as unlinked.
+ * @param head - The list head or node.
+ * @return None.
+ */
+static inline void no_os_ilist_init(struct no_os_ilist_node *head)
+{
+	head->next = head;
+	head->prev = head;
+}
+
+/**
+ * @brief Check whether a list is empty.
+ * @param head - The list head.
+ * @return true if the list has no node.
+ */
+static inline bool no_os_ilist_empty(const struct no_os_ilist_node *head)
+{
+	return head->next == head;
+}
+
+/**
+ * @brief Insert a node after another one.
+ * @param pos - Node, or head, to insert after.
+ * @param node - Node to insert.
+ * @return None.
+ */
+static inline void no_os_ilist_insert_after(struct no_os_ilist_node *pos,
+		struct no_os_ilist_node *node)
+{
+	node->prev = pos;
+	node->next = pos->next;
+	pos->next->prev = node;
+	pos->next = node;
+}
+
+/**
+ * @brief Insert a node before another one.
+ * @param pos - Node, or head, to insert before.
+ * @param node - Node to insert.
+ * @return None.
+ */
+static inline void no_os_ilist_insert_before(struct no_os_ilist_node *pos,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert_after(pos->prev, node);
+}
+
+/**
+ * @brief Add a node at the beginning of a list.
+ * @param head - The list head.
+ * @param node - Node to add.
+ * @return None.
+ */
+static inline void no_os_ilist_add_first(struct no_os_ilist_node *head,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert_after(head, node);
+}
+
+/**
+ * @brief Add a node at the end of a list.
+ * @param head - The list head.
+ * @param node - Node to add.
+ * @return None.
+ */
+static inline void no_os_ilist_add_last(struct no_os_ilist_node *head,
+					struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert_after(head->prev, node);
+}
+
+/**
+ * @brief Unlink a node from its list. The node reads as unlinked afterwards,
+ * so deleting it twice is harmless.
+ * @param node - Node to delete.
+ * @return None.
+ */
+static inline void no_os_ilist_del(struct no_os_ilist_node *node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	no_os_ilist_init(node);
+}
+
+/**
+ * @brief Get the first node of a list.
+ * @param head - The list head.
+ * @return The first node, or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_first(
+	const struct no_os_ilist_node *head)
+{
+	return no_os_ilist_empty(head) ? NULL : head->next;
+}
+
+/**
+ * @brief Get the last node of a list.
+ * @param head - The list head.
+ * @return The last node, or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_last(
+	const struct no_os_ilist_node *head)
+{
+	return no_os_ilist_empty(head) ? NULL : head->prev;
+}
+
+/**
+ * @brief Unlink and return the first node of a list.
+ * @param head - The list head.
+ * @return The first node, or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_get_first(
+	struct no_os_ilist_node *head)
+{
+	struct no_os_ilist_node *node = no_os_ilist_first(head);
+
+	if (node)
+		no_os_ilist_del(node);
+
+	return node;
+}
+
+/**
+ * @brief Unlink and return the last node of a list.
+ * @param head - The list head.
+ * @return The last node, or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_get_last(
+	struct no_os_ilist_node *head)
+{
+	struct no_os_ilist_node *node = no_os_ilist_last(head);
+
+	if (node)
+		no_os_ilist_del(node);
+
+	return node;
+}
+
+#endif // _NO_OS_ILIST_H_
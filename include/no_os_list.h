@@ -85,6 +85,12 @@
  *	// 3 will be printed
  *	no_os_list_remove(stack);
  *    @endcode
+ *
+ *   Every insert allocates a list element. Code that must not allocate, e.g.
+ *   in interrupt context, can embed nodes from no_os_ilist.h in its own
+ *   structures instead. no_os_pqueue.h provides the priority list adapter
+ *   functions on top of a preallocated binary heap, with O(log n) push and
+ *   pop.
 *******************************************************************************/
 
 #ifndef _NO_OS_LIST_H_
@@ -227,6 +233,8 @@ enum no_os_adapter_type {
 	 *  - \e Top_next: Read lowest element
 	 *  - \e Back: Read the biggest element
 	 *  - \e Swap: Edit the lowest element
+	 * Push keeps the list sorted and takes O(n). no_os_pqueue_init()
+	 * provides the same functions on a heap, with O(log n) push and pop.
 	 */
 	NO_OS_LIST_PRIORITY_LIST
 };
@@ -324,4 +332,11 @@ int32_t no_os_list_get_find(struct no_os_list_desc *list_desc, void **data,
 			    void *cmp_data);
 /** @}*/
 
+#ifdef NO_OS_ALLOC_POOL
+#include "no_os_pool.h"
+
+/* Get the arena list elements are allocated from */
+struct no_os_arena *no_os_list_get_arena(void);
+#endif
+
 #endif // _NO_OS_LIST_H_
@@ -0,0 +1,141 @@
+/***************************************************************************//**
+ *   @file   no_os_pool.h
+ *   @brief  Fixed block memory pools and size class arenas.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_POOL_H_
+#define _NO_OS_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** Alignment of every block handed out by a pool */
+#define NO_OS_POOL_ALIGN	8
+
+/** Actual size of a block able to hold _size bytes */
+#define NO_OS_POOL_BLOCK_SIZE(_size) \
+	(((((_size) < sizeof(void *)) ? sizeof(void *) : (_size)) + \
+	  NO_OS_POOL_ALIGN - 1) & ~((size_t)NO_OS_POOL_ALIGN - 1))
+
+/** Declare the static storage of a pool of _nb blocks of _size bytes */
+#define NO_OS_DECLARE_POOL_MEM(_mem, _size, _nb) \
+	static uint8_t _mem[NO_OS_POOL_BLOCK_SIZE(_size) * (_nb)] \
+	__attribute__((aligned(NO_OS_POOL_ALIGN)))
+
+/** Static initializer of a pool using storage from NO_OS_DECLARE_POOL_MEM */
+#define NO_OS_POOL_INIT(_mem, _size, _nb) { \
+	.start = _mem, \
+	.end = _mem + sizeof(_mem), \
+	.block_size = NO_OS_POOL_BLOCK_SIZE(_size), \
+	.nb_blocks = _nb, \
+}
+
+/**
+ * @struct no_os_pool
+ * @brief Pool of fixed size blocks carved out of a caller provided buffer.
+ * Allocation and release are O(1): released blocks are kept on a free list
+ * threaded through the blocks themselves and never used blocks are handed out
+ * in order, so no initialization pass over the buffer is needed.
+ */
+struct no_os_pool {
+	/** First byte of the pool storage */
+	uint8_t *start;
+	/** First byte after the pool storage */
+	uint8_t *end;
+	/** Block size, see NO_OS_POOL_BLOCK_SIZE */
+	size_t block_size;
+	/** Number of blocks */
+	uint32_t nb_blocks;
+	/** Released blocks */
+	void *free_list;
+	/** Number of blocks handed out at least once */
+	uint32_t nb_touched;
+	/** Number of blocks currently in use */
+	uint32_t used;
+	/** Maximum number of blocks in use at the same time */
+	uint32_t high_water;
+	/** Number of allocations refused because the pool was empty */
+	uint32_t failed;
+};
+
+/**
+ * @struct no_os_arena
+ * @brief Set of pools of increasing block size serving variable size requests.
+ * Each subsystem can own an arena so that it cannot starve the others. The
+ * pools are updated in no_os_critical sections, which are short and never
+ * block, so arenas may be used from interrupt handlers. generic.mk builds the
+ * critical sections of the platform along with no_os_pool.c, and the build
+ * fails on a target that has none.
+ */
+struct no_os_arena {
+	/** Arena name, for statistics */
+	const char *name;
+	/** Pools, sorted by increasing block size */
+	struct no_os_pool *pools;
+	/** Number of pools */
+	uint32_t nb_pools;
+	/** Serve requests no pool can take from the heap */
+	bool heap_fallback;
+	/** Bytes currently in use in the pools, at block granularity */
+	size_t used_bytes;
+	/** Maximum of used_bytes */
+	size_t high_water_bytes;
+	/** Number of requests served from the heap */
+	uint32_t heap_allocs;
+	/** Number of requests that could not be served or invalid releases */
+	uint32_t failed;
+};
+
+/* Set up a pool on top of a caller provided buffer. */
+int no_os_pool_init(struct no_os_pool *pool, void *mem, size_t size,
+		    size_t block_size);
+/* Get a block from the pool. */
+void *no_os_pool_alloc(struct no_os_pool *pool);
+/* Give a block back to the pool. */
+int no_os_pool_free(struct no_os_pool *pool, void *ptr);
+/* Check whether a pointer was handed out by the pool. */
+bool no_os_pool_owns(const struct no_os_pool *pool, const void *ptr);
+
+/* Validate the arena pools. */
+int no_os_arena_init(struct no_os_arena *arena);
+/* Allocate size bytes from the smallest pool that fits. */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size);
+/* Allocate nitems * size bytes and set them to 0. */
+void *no_os_arena_calloc(struct no_os_arena *arena, size_t nitems, size_t size);
+/* Release memory allocated from the arena. */
+void no_os_arena_free(struct no_os_arena *arena, void *ptr);
+
+#endif // _NO_OS_POOL_H_
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ *   @file   no_os_pqueue.h
+ *   @brief  Binary heap priority queue with the no_os_list adapter interface.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_PQUEUE_H_
+#define _NO_OS_PQUEUE_H_
+
+#include <stdint.h>
+#include "no_os_list.h"
+
+/*
+ * The returned descriptor exposes the NO_OS_LIST_PRIORITY_LIST adapter
+ * functions (push, pop, top_next, back and swap) with the same semantics,
+ * elements comparing equal included: they are popped in insertion order.
+ * Storage for capacity elements is allocated once by no_os_pqueue_init(), so
+ * push and pop never allocate and take O(log n); back is O(n).
+ * no_os_pqueue_read_find() and no_os_pqueue_get_find() look an element up by
+ * key, like no_os_list_read_find() and no_os_list_get_find(). The search
+ * skips the subtrees ordered after the key, and removing the match takes
+ * O(log n).
+ */
+int32_t no_os_pqueue_init(struct no_os_list_desc **list_desc,
+			  uint32_t capacity, f_cmp comparator);
+int32_t no_os_pqueue_remove(struct no_os_list_desc *list_desc);
+int32_t no_os_pqueue_get_size(struct no_os_list_desc *list_desc,
+			      uint32_t *out_size);
+int32_t no_os_pqueue_read_find(struct no_os_list_desc *list_desc, void **data,
+			       void *cmp_data);
+int32_t no_os_pqueue_get_find(struct no_os_list_desc *list_desc, void **data,
+			      void *cmp_data);
+
+#endif // _NO_OS_PQUEUE_H_
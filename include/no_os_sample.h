@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ *   @file   no_os_sample.h
+ *   @brief  Header file of the sample format conversion utilities.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SAMPLE_H_
+#define _NO_OS_SAMPLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @struct no_os_sample_fmt
+ * @brief Layout of the samples in a raw (device side) buffer, following the
+ * IIO scan type conventions.
+ *
+ * When storagebits is a multiple of 8, samples are byte aligned words of 1 to
+ * 4 bytes in the is_big_endian byte order. Otherwise the buffer is a dense msb
+ * first bitstream, as shifted out by most converters: sample n starts at bit
+ * n * storagebits of the buffer and is_big_endian is ignored.
+ */
+struct no_os_sample_fmt {
+	/** Number of valid bits of a sample, 1 to 32 */
+	uint8_t		realbits;
+	/** Realbits + padding, 1 to 32 */
+	uint8_t		storagebits;
+	/** Shift right by this before masking out realbits */
+	uint8_t		shift;
+	/** True if the valid bits are in two's complement */
+	bool		is_signed;
+	/** True if byte aligned words are big endian */
+	bool		is_big_endian;
+};
+
+/* Number of bytes taken by nb_samples samples in a raw buffer. */
+uint32_t no_os_sample_raw_size(const struct no_os_sample_fmt *fmt,
+			       uint32_t nb_samples);
+
+/*
+ * Extract the valid bits of nb_samples raw samples. Signed samples are sign
+ * extended, unsigned ones zero extended. The 16 bit variants need realbits to
+ * be at most 16.
+ */
+int no_os_sample_unpack32(const struct no_os_sample_fmt *fmt,
+			  const uint8_t *src, int32_t *dst,
+			  uint32_t nb_samples);
+int no_os_sample_unpack16(const struct no_os_sample_fmt *fmt,
+			  const uint8_t *src, int16_t *dst,
+			  uint32_t nb_samples);
+
+/*
+ * Inverse of the above: the low realbits of each value are shifted in place
+ * and the padding bits are cleared.
+ */
+int no_os_sample_pack32(const struct no_os_sample_fmt *fmt,
+			const int32_t *src, uint8_t *dst, uint32_t nb_samples);
+int no_os_sample_pack16(const struct no_os_sample_fmt *fmt,
+			const int16_t *src, uint8_t *dst, uint32_t nb_samples);
+
+/* Sign extend, in place, samples whose sign bit is bit (bits - 1). */
+void no_os_sample_sign_extend32(int32_t *buf, uint32_t nb_samples,
+				uint8_t bits);
+
+/* Reverse the byte order of nb_words 16, 32 or 64 bit words, in place. */
+void no_os_sample_swap16(void *buf, uint32_t nb_words);
+void no_os_sample_swap32(void *buf, uint32_t nb_words);
+void no_os_sample_swap64(void *buf, uint32_t nb_words);
+
+#endif // _NO_OS_SAMPLE_H_
@@ -45,6 +45,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -108,6 +109,28 @@ struct no_os_spi_msg {
 	uint32_t		cs_delay_last;
 };
 
+/**
+ * @struct no_os_spi_xfer
+ * @brief A list of messages queued on a SPI bus by no_os_spi_xfer_submit().
+ * The structure is owned by the SPI layer until the callback is invoked.
+ */
+struct no_os_spi_xfer {
+	/** Messages to be sent at once */
+	struct no_os_spi_msg	*msgs;
+	/** Number of messages */
+	uint32_t		len;
+	/** Called once the messages were transferred. May be NULL. */
+	void			(*callback)(struct no_os_spi_xfer *xfer, void *ctx);
+	/** Parameter for the callback */
+	void			*ctx;
+	/** Result of the transfer, valid once the callback is invoked */
+	int32_t			status;
+	/** Device on which the messages are sent. Set on submit. */
+	struct no_os_spi_desc	*desc;
+	/** Next transfer queued on the bus. Used by the SPI layer. */
+	struct no_os_spi_xfer	*next;
+};
+
 /**
  * @struct no_os_platform_spi_delays
  * @brief Delays resulted from components in the SPI signal path. The values is ns.
@@ -168,6 +191,25 @@ struct no_os_spibus_desc {
 	const struct no_os_spi_platform_ops *platform_ops;
 	/** SPI bus extra */
 	void		*extra;
+	/** Transfers queued on the bus, the first one is in progress */
+	struct no_os_spi_xfer	*xfer_head;
+	/** Last transfer queued on the bus */
+	struct no_os_spi_xfer	*xfer_tail;
+	/**
+	 * Set while the queued transfers are processed. The queue then owns
+	 * the bus. The queue links and this flag are only changed inside a
+	 * no_os_critical section, as they are shared with the completion
+	 * interrupts.
+	 */
+	volatile bool	xfer_busy;
+	/** Given once the queue drains, to wake up the callers waiting for it */
+	void		*xfer_sem;
+	/** Number of callers blocked on xfer_sem */
+	uint32_t	xfer_waiters;
+	/** Callback of the no_os_spi_transfer_dma_async() in progress */
+	void		(*dma_callback)(void *);
+	/** Parameter for dma_callback */
+	void		*dma_ctx;
 };
 
 /**
@@ -218,6 +260,12 @@ struct no_os_spi_platform_ops {
 	 */
 	int32_t (*dma_transfer_async)(struct no_os_spi_desc *, struct no_os_spi_msg *,
 				      uint32_t, void (*)(void *), void *);
+	/** Iterate over the spi_msg array and send all messages in the
+	 * background. Returns immediately and invokes a callback once all the
+	 * messages have been transfered, with the result of the transfer.
+	 */
+	int32_t (*transfer_async)(struct no_os_spi_desc *, struct no_os_spi_msg *,
+				  uint32_t, void (*)(void *, int32_t), void *);
 	/** SPI remove function pointer */
 	int32_t (*remove)(struct no_os_spi_desc *);
 };
@@ -238,11 +286,42 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 				 uint8_t *data,
 				 uint16_t bytes_number);
 
+/* Lock the SPI bus for a sequence of transfers */
+int32_t no_os_spi_bus_lock(struct no_os_spi_desc *desc);
+
+/* Unlock the SPI bus */
+int32_t no_os_spi_bus_unlock(struct no_os_spi_desc *desc);
+
+/* Write and read data to/from SPI, with the bus already locked. */
+int32_t __no_os_spi_write_and_read(struct no_os_spi_desc *desc,
+				   uint8_t *data,
+				   uint16_t bytes_number);
+
+/* Send all messages at once, with the bus already locked. */
+int32_t __no_os_spi_transfer(struct no_os_spi_desc *desc,
+			     struct no_os_spi_msg *msgs,
+			     uint32_t len);
+
 /* Iterate over the spi_msg array and send all messages at once */
 int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 			   struct no_os_spi_msg *msgs,
 			   uint32_t len);
 
+/* Transfer a list of messages using DMA, with the bus already locked. */
+int32_t __no_os_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
+				      struct no_os_spi_msg *msgs,
+				      uint32_t len);
+
+/*
+ * Start a DMA transfer of a list of messages, with the bus already locked until
+ * the callback is invoked.
+ */
+int32_t __no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+				       struct no_os_spi_msg *msgs,
+				       uint32_t len,
+				       void (*callback)(void *),
+				       void *ctx);
+
 /* Transfer a list of messages using DMA. Wait until all transfers are done */
 int32_t no_os_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
 				    struct no_os_spi_msg *msgs,
@@ -257,6 +336,13 @@ int32_t no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
 				     void (*callback)(void *),
 				     void *ctx);
 
+/* Queue a list of messages on the bus and invoke a callback once sent */
+int32_t no_os_spi_xfer_submit(struct no_os_spi_desc *desc,
+			      struct no_os_spi_xfer *xfer);
+
+/* Wait until all the transfers queued on the bus are done */
+int32_t no_os_spi_xfer_wait(struct no_os_spi_desc *desc);
+
 /* Initialize SPI bus descriptor*/
 int32_t no_os_spibus_init(const struct no_os_spi_init_param *param);
 
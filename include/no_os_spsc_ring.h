@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.h
+ *   @brief  Lock-free single producer, single consumer ring buffer header
+********************************************************************************
+ *   @copyright
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_SPSC_RING_H_
+#define _NO_OS_SPSC_RING_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+	!defined(__STDC_NO_ATOMICS__) && !defined(__cplusplus)
+#include <stdatomic.h>
+#define NO_OS_SPSC_C11_ATOMICS
+#define NO_OS_SPSC_ATOMIC	_Atomic
+#else
+/* Ordering is then enforced with full barriers, see no_os_spsc_ring.c */
+#define NO_OS_SPSC_ATOMIC	volatile
+#endif
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct no_os_spsc_ring
+ * @brief Ring buffer shared by exactly one producer and one consumer.
+ *
+ * The producer only writes head and the consumer only writes tail, so both
+ * sides can run concurrently (e.g. an interrupt handler and the main loop, or
+ * two cores) without locks. head and tail are free running element counters;
+ * the number of elements is a power of 2 so positions are found by masking.
+ */
+struct no_os_spsc_ring {
+	/** Storage for mask + 1 elements */
+	uint8_t			*buff;
+	/** Size of an element in bytes */
+	uint32_t		elem_size;
+	/** Number of elements - 1 */
+	uint32_t		mask;
+	/** Number of elements written. Only updated by the producer */
+	NO_OS_SPSC_ATOMIC uint32_t	head;
+	/** Number of elements read. Only updated by the consumer */
+	NO_OS_SPSC_ATOMIC uint32_t	tail;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Allocate a ring of at least nb_elems elements (rounded up to a power of 2) */
+int32_t no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t elem_size,
+			     uint32_t nb_elems);
+/* Configure a ring over buff without memory allocation */
+int32_t no_os_spsc_ring_cfg(struct no_os_spsc_ring *ring, void *buff,
+			    uint32_t elem_size, uint32_t nb_elems);
+/* Free the resources allocated by no_os_spsc_ring_init */
+void no_os_spsc_ring_remove(struct no_os_spsc_ring *ring);
+
+/* Number of elements that can be read. Consumer side */
+uint32_t no_os_spsc_ring_used(struct no_os_spsc_ring *ring);
+/* Number of elements that can be written. Producer side */
+uint32_t no_os_spsc_ring_avail(struct no_os_spsc_ring *ring);
+/* Total number of elements */
+uint32_t no_os_spsc_ring_capacity(struct no_os_spsc_ring *ring);
+
+/* Copy at most nb elements in the ring. Return the number of elements copied */
+uint32_t no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *data,
+			       uint32_t nb);
+/* Copy at most nb elements from the ring. Return the number of elements read */
+uint32_t no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *data,
+			      uint32_t nb);
+
+/* Get a contiguous free region of at most nb elements. Producer side */
+uint32_t no_os_spsc_ring_reserve(struct no_os_spsc_ring *ring, uint32_t nb,
+				 void **addr);
+/* Publish nb elements written in the region returned by reserve */
+void no_os_spsc_ring_commit(struct no_os_spsc_ring *ring, uint32_t nb);
+/* Get a contiguous region of at most nb readable elements. Consumer side */
+uint32_t no_os_spsc_ring_peek(struct no_os_spsc_ring *ring, uint32_t nb,
+			      void **addr);
+/* Free nb elements of the region returned by peek */
+void no_os_spsc_ring_release(struct no_os_spsc_ring *ring, uint32_t nb);
+/* Drop all the readable elements. Consumer side */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring);
+/* Empty the ring and restart at the first element. Both sides must be idle */
+void no_os_spsc_ring_reset(struct no_os_spsc_ring *ring);
+
+#endif //_NO_OS_SPSC_RING_H_
@@ -41,6 +41,12 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "no_os_spsc_ring.h"
+
+/* Bytes buffered by the RX software FIFO, rounded up to a power of 2 */
+#ifndef NO_OS_TDM_RX_FIFO_SIZE
+#define NO_OS_TDM_RX_FIFO_SIZE	256
+#endif
 
 /**
  * @struct no_os_tdm_platform_ops
@@ -101,7 +107,7 @@ struct no_os_tdm_desc {
 	/** Platform operation function pointers */
 	const struct no_os_tdm_platform_ops *platform_ops;
 	/** Software FIFO. */
-	struct lf256fifo *rx_fifo;
+	struct no_os_spsc_ring *rx_fifo;
 	/**  TDM extra parameters (device specific) */
 	void *extra;
 };
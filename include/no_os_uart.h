@@ -45,7 +45,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -53,6 +53,11 @@
 
 #define UART_MAX_NUMBER 10
 
+/* Bytes buffered by asynchronous RX, rounded up to a power of 2 */
+#ifndef NO_OS_UART_RX_FIFO_SIZE
+#define NO_OS_UART_RX_FIFO_SIZE	256
+#endif
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -145,7 +150,7 @@ struct no_os_uart_desc {
 	/** UART Interrupt ID */
 	uint32_t	irq_id;
 	/** Software FIFO. */
-	struct lf256fifo *rx_fifo;
+	struct no_os_spsc_ring *rx_fifo;
 	/** UART Baud Rate */
 	uint32_t 	baud_rate;
 	const struct no_os_uart_platform_ops *platform_ops;
@@ -180,6 +180,20 @@ int64_t no_os_div_s64(int64_t dividend, int32_t divisor);
 int32_t no_os_str_to_int32(const char *str);
 /* Converts from string to uint32_t */
 uint32_t no_os_str_to_uint32(const char *str);
+/* Converts from uint32_t to a zero padded decimal string */
+uint32_t no_os_uint32_to_str(char *str, uint32_t value, uint32_t width);
+/* Converts from int32_t to a decimal string */
+uint32_t no_os_int32_to_str(char *str, int32_t value);
+/* Converts from uint32_t to a zero padded lowercase hexadecimal string */
+uint32_t no_os_uint32_to_hex_str(char *str, uint32_t value, uint32_t width);
+/* Parses an int32_t from the beginning of a string, like strtol() */
+uint32_t no_os_str_parse_int32(const char *str, uint32_t base, int32_t *value);
+/* Parses an uint32_t from the beginning of a string, like strtoul() */
+uint32_t no_os_str_parse_uint32(const char *str, uint32_t base,
+				uint32_t *value);
+/* Parses the digits after the decimal point as a fixed number of subunits */
+uint32_t no_os_str_parse_fract(const char *str, uint32_t digits,
+			       int32_t *value);
 
 void no_os_put_unaligned_be16(uint16_t val, uint8_t *buf);
 uint16_t no_os_get_unaligned_be16(uint8_t *buf);
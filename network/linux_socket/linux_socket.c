@@ -59,11 +59,51 @@
 #include <netdb.h>
 #include <string.h>
 #include <fcntl.h>
+#include <sys/epoll.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of events retrieved by one socket_poll call */
+#define LINUX_SOCKET_MAX_EVENTS	32
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/* All the opened and accepted sockets are watched for input on this instance */
+static int linux_epoll_fd = -1;
 
 /******************************************************************************/
 /*************************** FUnctions Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Watch a socket for input events. Closed sockets are removed from the
+ * epoll instance by the kernel.
+ * @param sock_id - Socket id
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_socket_watch(uint32_t sock_id)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLRDHUP,
+		.data.fd = sock_id
+	};
+
+	if (linux_epoll_fd < 0) {
+		linux_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (linux_epoll_fd < 0)
+			return -errno;
+	}
+
+	if (epoll_ctl(linux_epoll_fd, EPOLL_CTL_ADD, sock_id, &ev) < 0)
+		return -errno;
+
+	return 0;
+}
+
 /** @brief See \ref network_interface.socket_open */
 static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 				 enum socket_protocol prot, uint32_t buff_size)
@@ -79,6 +119,12 @@ static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 	flags = fcntl(*sock_id, F_GETFL);
 	fcntl(*sock_id, F_SETFL, flags | O_NONBLOCK);
 
+	err = linux_socket_watch(*sock_id);
+	if (err) {
+		close(*sock_id);
+		return err;
+	}
+
 	return 0;
 }
 
@@ -253,6 +299,7 @@ static int32_t linux_socket_listen(void *desc, uint32_t sock_id,
 static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 				   uint32_t *client_socket_id)
 {
+	int nodelay = 1;
 	int32_t ret;
 
 	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
@@ -262,9 +309,49 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 
 	*client_socket_id = ret;
 
+	/* Replies are sent in small chunks, don't wait for the peer's ACK */
+	setsockopt(*client_socket_id, IPPROTO_TCP, TCP_NODELAY, &nodelay,
+		   sizeof(nodelay));
+
+	ret = linux_socket_watch(*client_socket_id);
+	if (ret) {
+		close(*client_socket_id);
+		return ret;
+	}
+
 	return 0;
 }
 
+/** @brief See \ref network_interface.socket_poll */
+static int32_t linux_socket_poll(void *desc, uint32_t *sock_ids,
+				 uint8_t *ready, uint32_t nb,
+				 uint32_t timeout_ms)
+{
+	struct epoll_event events[LINUX_SOCKET_MAX_EVENTS];
+	int32_t cnt = 0;
+	uint32_t j;
+	int i, n;
+
+	memset(ready, 0, nb);
+	if (linux_epoll_fd < 0)
+		return -EINVAL;
+
+	n = epoll_wait(linux_epoll_fd, events, LINUX_SOCKET_MAX_EVENTS,
+		       no_os_min(timeout_ms, (uint32_t)INT32_MAX));
+	if (n < 0)
+		return errno == EINTR ? 0 : -errno;
+
+	for (i = 0; i < n; i++)
+		for (j = 0; j < nb; j++)
+			if ((uint32_t)events[i].data.fd == sock_ids[j] &&
+			    !ready[j]) {
+				ready[j] = 1;
+				cnt++;
+			}
+
+	return cnt;
+}
+
 struct network_interface linux_net = {
 	.socket_open = (int32_t (*)(void *, uint32_t *, enum socket_protocol,
 				    uint32_t)) linux_socket_open,
@@ -277,7 +364,8 @@ struct network_interface linux_net = {
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address* from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_poll = linux_socket_poll
 };
 
 #endif
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <stdbool.h>
 
 #include "lwip/opt.h"
 #include "lwip/sys.h"
@@ -777,6 +778,63 @@ static int32_t lwip_socket_accept(void *net, uint32_t sock_id,
 	return -EAGAIN;
 }
 
+/**
+ * @brief Check if a socket has pending input (data, a new connection or a
+ * closed connection).
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock - socket to check.
+ * @return true if socket_recv or socket_accept would not return -EAGAIN.
+ */
+static bool _sock_readable(struct lwip_network_desc *desc,
+			   struct lwip_socket_desc *sock)
+{
+	uint32_t i;
+
+	switch (sock->state) {
+	case SOCKET_CONNECTED:
+		return sock->p != NULL;
+	case SOCKET_ACCEPTING:
+		for (i = 0; i < NO_OS_MAX_SOCKETS; i++)
+			if (desc->sockets[i].state == SOCKET_WAITING_ACCEPT)
+				return true;
+
+		return false;
+	default:
+		/* Let the caller get the error from recv or accept */
+		return true;
+	}
+}
+
+/**
+ * @brief Check which sockets are readable. lwip only makes progress in
+ * no_os_lwip_step(), so this never waits.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_ids - indexes of the sockets to check.
+ * @param ready - set to 1 for each readable socket.
+ * @param nb - number of sockets.
+ * @param timeout_ms - unused.
+ * @return number of readable sockets, negative error code otherwise
+ */
+static int32_t lwip_socket_poll(void *net, uint32_t *sock_ids, uint8_t *ready,
+				uint32_t nb, uint32_t timeout_ms)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+	int32_t cnt = 0;
+	uint32_t i;
+
+	for (i = 0; i < nb; i++) {
+		sock = _get_sock(desc, sock_ids[i]);
+		if (!sock)
+			return -EINVAL;
+
+		ready[i] = _sock_readable(desc, sock);
+		cnt += ready[i];
+	}
+
+	return cnt;
+}
+
 /**
  * @brief Not implemented.
  * @param net - Not used.
@@ -854,6 +912,7 @@ struct network_interface lwip_socket_ops = {
 	.socket_bind = lwip_socket_bind,
 	.socket_listen = lwip_socket_listen,
 	.socket_accept = lwip_socket_accept,
+	.socket_poll = lwip_socket_poll,
 };
 
 /**
@@ -875,6 +934,7 @@ static void lwip_config_if(struct lwip_network_desc *desc)
 	net->socket_bind = lwip_socket_bind;
 	net->socket_listen = lwip_socket_listen;
 	net->socket_accept = lwip_socket_accept;
+	net->socket_poll = lwip_socket_poll;
 
 	net->net = desc;
 }
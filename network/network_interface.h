@@ -218,6 +218,24 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Wait until at least one of the sockets is readable.
+	 *
+	 * Optional. A socket is readable when socket_recv or socket_accept
+	 * would not return -EAGAIN: data or a new connection is pending, the
+	 * peer closed the connection or an error occurred.
+	 * @param net - Network interface
+	 * @param sock_ids - Sockets to check
+	 * @param ready - Set to 1 for each readable socket, 0 otherwise
+	 * @param nb - Number of sockets
+	 * @param timeout_ms - Maximum time to wait. 0 to return immediately
+	 * @return
+	 *  - Number of readable sockets : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_poll)(void *net, uint32_t *sock_ids, uint8_t *ready,
+			       uint32_t nb, uint32_t timeout_ms);
 };
 
 #endif
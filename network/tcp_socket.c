@@ -461,3 +461,56 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief See \ref network_interface.socket_poll
+ *
+ * All the sockets must use the same network interface. Secure sockets with
+ * decrypted data pending in the TLS layer are readable without waiting.
+ * @param socks - Sockets to check
+ * @param ready - Set to 1 for each readable socket, 0 otherwise
+ * @param nb - Number of sockets, at most SOCKET_POLL_MAX_SOCKETS
+ * @param timeout_ms - Maximum time to wait. 0 to return immediately
+ * @return Number of readable sockets, -ENOSYS if the network interface can't
+ * poll or a negative error code otherwise.
+ */
+int32_t socket_poll(struct tcp_socket_desc **socks, uint8_t *ready,
+		    uint32_t nb, uint32_t timeout_ms)
+{
+	uint32_t ids[SOCKET_POLL_MAX_SOCKETS];
+	struct network_interface *net;
+	int32_t ret;
+	uint32_t i;
+
+	if (!socks || !ready || !nb || nb > SOCKET_POLL_MAX_SOCKETS)
+		return -EINVAL;
+
+	net = socks[0]->net;
+	if (!net->socket_poll)
+		return -ENOSYS;
+
+	for (i = 0; i < nb; i++) {
+		if (socks[i]->net != net)
+			return -EINVAL;
+		ids[i] = socks[i]->id;
+#ifndef DISABLE_SECURE_SOCKET
+		if (socks[i]->secure &&
+		    mbedtls_ssl_get_bytes_avail(&socks[i]->secure->ssl))
+			timeout_ms = 0;
+#endif
+	}
+
+	ret = net->socket_poll(net->net, ids, ready, nb, timeout_ms);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+#ifndef DISABLE_SECURE_SOCKET
+	for (i = 0; i < nb; i++)
+		if (!ready[i] && socks[i]->secure &&
+		    mbedtls_ssl_get_bytes_avail(&socks[i]->secure->ssl)) {
+			ready[i] = 1;
+			ret++;
+		}
+#endif
+
+	return ret;
+}
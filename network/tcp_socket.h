@@ -55,6 +55,8 @@
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 #define MAX_BACKLOG 0xFFFFFFFF
+/* Maximum number of sockets checked by one socket_poll call */
+#define SOCKET_POLL_MAX_SOCKETS	16
 
 /* Socket descriptor */
 struct tcp_socket_desc {
@@ -170,4 +172,8 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Wait until at least one of the sockets is readable */
+int32_t socket_poll(struct tcp_socket_desc **socks, uint8_t *ready,
+		    uint32_t nb, uint32_t timeout_ms);
+
 #endif
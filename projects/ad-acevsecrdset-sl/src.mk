@@ -70,7 +70,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_list.h      \
 		$(INCLUDE)/no_os_timer.h      \
 		$(INCLUDE)/no_os_uart.h      \
-		$(INCLUDE)/no_os_lf256fifo.h \
+		$(INCLUDE)/no_os_spsc_ring.h \
 		$(INCLUDE)/no_os_util.h \
 		$(INCLUDE)/no_os_dma.h \
 		$(INCLUDE)/no_os_units.h \
@@ -83,7 +83,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 
 SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(DRIVERS)/api/no_os_i2c.c  \
-		$(NO-OS)/util/no_os_lf256fifo.c \
+		$(NO-OS)/util/no_os_spsc_ring.c \
 		$(DRIVERS)/api/no_os_irq.c  \
 		$(DRIVERS)/api/no_os_spi.c  \
 		$(DRIVERS)/api/no_os_timer.c  \
@@ -23,6 +23,7 @@ SRCS += $(PLATFORM_DRIVERS)/xilinx_spi.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
+	$(NO-OS)/util/no_os_crc8.c \
 	$(NO-OS)/util/no_os_mutex.c
 
 INCS += $(DRIVERS)/afe/ad4110/ad4110.h
@@ -39,6 +40,7 @@ INCS += $(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_alloc.h \
+	$(INCLUDE)/no_os_crc8.h \
 	$(INCLUDE)/no_os_mutex.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_list.h
@@ -50,13 +50,11 @@ LIBRARIES += iio
 SRCS += $(DRIVERS)/afe/ad413x/iio_ad413x.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(NO-OS)/iio/iio_app/iio_app.c \
-	$(NO-OS)/util/no_os_fifo.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(DRIVERS)/api/no_os_uart.c
 INCS += $(DRIVERS)/afe/ad413x/iio_ad413x.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
 	$(NO-OS)/iio/iio_app/iio_app.h \
-	$(INCLUDE)/no_os_fifo.h \
-	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_uart.h
 endif
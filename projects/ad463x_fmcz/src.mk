@@ -31,11 +31,10 @@ ifeq (y,$(strip $(IIOD)))
 LIBRARIES += iio
 SRC_DIRS += $(NO-OS)/iio/iio_app
 SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(DRIVERS)/adc/ad463x/iio_ad463x.c \
-	$(NO-OS)/util/no_os_fifo.c \
 	$(NO-OS)/util/no_os_list.c
 endif
 INCS += $(PROJECT)/src/parameters.h
@@ -57,13 +56,13 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_alloc.h \
 	$(INCLUDE)/no_os_mutex.h
 ifeq (y,$(strip $(IIOD)))
 INCS += $(DRIVERS)/adc/ad463x/iio_ad463x.h \
-	$(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
 	$(INCLUDE)/no_os_list.h
 endif
@@ -30,10 +30,9 @@ ifeq (y,$(strip $(IIOD)))
 LIBRARIES += iio
 SRC_DIRS += $(NO-OS)/iio/iio_app
 SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c \
 	$(DRIVERS)/api/no_os_irq.c \
-	$(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(NO-OS)/util/no_os_list.c	
 endif
@@ -53,12 +52,12 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
 	$(INCLUDE)/no_os_pwm.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_alloc.h \
 	$(INCLUDE)/no_os_mutex.h
 ifeq (y,$(strip $(IIOD)))
-INCS += $(INCLUDE)/no_os_fifo.h \
+INCS += $(INCLUDE)/no_os_spsc_ring.h \
 	$(INCLUDE)/no_os_list.h
 endif
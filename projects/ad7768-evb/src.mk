@@ -11,7 +11,7 @@
 
 # Add to SRCS source files to be build in the project
 SRCS += $(PROJECT)/src/ad7768_evb.c
-SRCS += $(NO-OS)/util/no_os_fifo.c
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c
 SRCS += $(NO-OS)/util/no_os_util.c
 SRCS += $(NO-OS)/util/no_os_list.c
 SRCS += $(NO-OS)/util/no_os_alloc.c \
@@ -27,10 +27,9 @@ INCS += $(INCLUDE)/no_os_spi.h
 INCS += $(INCLUDE)/no_os_timer.h
 INCS += $(INCLUDE)/no_os_i2c.h
 INCS += $(INCLUDE)/no_os_uart.h
-INCS += $(INCLUDE)/no_os_lf256fifo.h
+INCS += $(INCLUDE)/no_os_spsc_ring.h
 INCS +=	$(INCLUDE)/no_os_irq.h
 INCS += $(INCLUDE)/no_os_list.h
-INCS += $(INCLUDE)/no_os_fifo.h
 INCS += $(INCLUDE)/no_os_alloc.h
 INCS += $(PROJECT)/src/parameters.h \
 	$(INCLUDE)/no_os_mutex.h \
@@ -59,18 +58,14 @@ ifeq (y,$(strip $(IIOD)))
 LIBRARIES += iio
 SRC_DIRS += $(NO-OS)/iio/iio_app
 
-INCS +=	$(INCLUDE)/no_os_fifo.h \
-	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
+INCS +=	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_list.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h
-SRCS += $(NO-OS)/util/no_os_fifo.c \
-	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
+SRCS += $(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c
 endif
@@ -39,14 +39,13 @@ CFLAGS += -DNO_OS_NETWORKING \
 		-DDISABLE_SECURE_SOCKET
 SRCS += $(NO-OS)/network/linux_socket/linux_socket.c \
 		$(NO-OS)/network/tcp_socket.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
 	$(PLATFORM_DRIVERS)/linux_uart.c
 else
-SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
-	$(NO-OS)/util/no_os_lf256fifo.c
+SRCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c
 endif
 
-SRCS += $(NO-OS)/util/no_os_fifo.c \
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c \
+	$(NO-OS)/util/no_os_sample.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(DRIVERS)/rf-transceiver/ad9361/iio_ad9361.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
@@ -68,8 +67,8 @@ INCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.h \
 ifeq (linux,$(strip $(PLATFORM)))
 CFLAGS += -DPLATFORM_MB
 INCS +=	$(PLATFORM_DRIVERS)/linux_spi.h \
+	$(PLATFORM_DRIVERS)/linux_axi_io.h \
 	$(PLATFORM_DRIVERS)/linux_gpio.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
 	$(PLATFORM_DRIVERS)/linux_uart.h
 endif
 INCS +=	$(INCLUDE)/no_os_axi_io.h \
@@ -90,9 +89,9 @@ INCS += $(NO-OS)/network/tcp_socket.h \
 	$(NO-OS)/network/noos_mbedtls_config.h
 endif
 
-INCS += $(INCLUDE)/no_os_fifo.h \
+INCS += $(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_sample.h \
 	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(DRIVERS)/rf-transceiver/ad9361/iio_ad9361.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
@@ -21,13 +21,13 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 	$(DRIVERS)/platform/$(PLATFORM)/$(PLATFORM)_timer.c \
 	$(DRIVERS)/platform/$(PLATFORM)/$(PLATFORM)_rtc.c \
 	$(DRIVERS)/platform/$(PLATFORM)/$(PLATFORM)_delay.c \
-	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(DRIVERS)/platform/$(PLATFORM)/$(PLATFORM)_uart.c
 
 INCS += $(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_uart.h \
-	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
 	$(INCLUDE)/no_os_alloc.h \
 	$(INCLUDE)/no_os_mutex.h \
 	$(DRIVERS)/platform/$(PLATFORM)/$(PLATFORM)_spi.h \
@@ -17,12 +17,14 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c	\
 	$(DRIVERS)/power/adp1050/iio_adp1050.c	\
 	$(NO-OS)/iio/iio.c	\
 	$(NO-OS)/iio/iiod.c	\
-	$(NO-OS)/util/no_os_fifo.c
+	$(NO-OS)/util/no_os_spsc_ring.c \
+	$(NO-OS)/util/no_os_sample.c
 
 INCS += $(NO-OS)/iio/iio_app/iio_app.h	\
 	$(DRIVERS)/power/adp1050/iio_adp1050.h	\
 	$(NO-OS)/iio/iio.h	\
 	$(NO-OS)/iio/iiod.h	\
 	$(NO-OS)/iio/iio_types.h	\
-	$(NO-OS)/include/no_os_fifo.h
+	$(NO-OS)/include/no_os_spsc_ring.h \
+	$(NO-OS)/include/no_os_sample.h
 endif
@@ -40,6 +40,7 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <stdbool.h>
 #include <stdio.h>
 #include "adi_hal.h"
 #include "parameters.h"
@@ -47,6 +48,7 @@
 #include "no_os_gpio.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
+#include "no_os_util.h"
 #ifndef ALTERA_PLATFORM
 #include "xilinx_spi.h"
 #include "xilinx_gpio.h"
@@ -55,6 +57,12 @@
 #include "altera_gpio.h"
 #endif
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Number of register accesses sent with a single no_os_spi_transfer() call */
+#define ADIHAL_SPI_BATCH	32
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -184,21 +192,56 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 		return ADIHAL_OK;
 }
 
-adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
-				 uint16_t *addr, uint8_t *data, uint32_t count)
+/*
+ * Access a list of registers, one CS cycle each, sending up to
+ * ADIHAL_SPI_BATCH of them at once, so that platforms which batch SPI
+ * messages don't pay the per transfer overhead for every register.
+ */
+static adiHalErr_t ADIHAL_spiAccessBytes(void *devHalInfo, uint16_t *addr,
+		uint8_t *data, uint32_t count, bool read)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	struct no_os_spi_msg msgs[ADIHAL_SPI_BATCH];
+	uint8_t buf[ADIHAL_SPI_BATCH][3];
+	uint32_t i, j, n;
+	int32_t status;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
+	for (i = 0; i < count; i += n) {
+		n = no_os_min(count - i, (uint32_t)ADIHAL_SPI_BATCH);
+
+		for (j = 0; j < n; j++) {
+			buf[j][0] = (addr[i + j] >> 8) & 0x7F;
+			if (read)
+				buf[j][0] |= 0x80;
+			buf[j][1] = addr[i + j] & 0xFF;
+			buf[j][2] = read ? 0x00 : data[i + j];
+
+			msgs[j] = (struct no_os_spi_msg) {
+				.tx_buff = buf[j],
+				.rx_buff = buf[j],
+				.bytes_number = 3,
+				.cs_change = 1,
+			};
+		}
+
+		status = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs, n);
+		if (status != 0)
+			return ADIHAL_SPI_FAIL;
+
+		if (read)
+			for (j = 0; j < n; j++)
+				data[i + j] = buf[j][2];
 	}
 
 	return ADIHAL_OK;
 }
 
+adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
+				 uint16_t *addr, uint8_t *data, uint32_t count)
+{
+	return ADIHAL_spiAccessBytes(devHalInfo, addr, data, count, false);
+}
+
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 			       uint16_t addr, uint8_t *readdata)
 {
@@ -223,16 +266,7 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return ADIHAL_spiAccessBytes(devHalInfo, addr, readdata, count, true);
 }
 
 adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
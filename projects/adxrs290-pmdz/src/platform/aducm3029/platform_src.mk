@@ -3,7 +3,11 @@ DISABLE_SECURE_SOCKET ?= y
 SRC_DIRS += $(NO-OS)/network
 
 SRCS	 += $(NO-OS)/util/no_os_circular_buffer.c
+SRCS	 += $(NO-OS)/util/no_os_spsc_ring.c
+SRCS	 += $(NO-OS)/util/no_os_sample.c
 INCS	 += $(INCLUDE)/no_os_circular_buffer.h
+INCS	 += $(INCLUDE)/no_os_spsc_ring.h
+INCS	 += $(INCLUDE)/no_os_sample.h
 endif
 SRC_DIRS += $(PLATFORM_DRIVERS)
 SRC_DIRS += $(INCLUDE)
@@ -22,7 +22,8 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 	$(INCLUDE)/no_os_timer.h		\
 	$(INCLUDE)/no_os_irq.h			\
 	$(INCLUDE)/no_os_uart.h			\
-	$(INCLUDE)/no_os_lf256fifo.h		\
+	$(INCLUDE)/no_os_spsc_ring.h		\
+	$(INCLUDE)/no_os_sample.h		\
 	$(INCLUDE)/no_os_units.h		\
 	$(INCLUDE)/no_os_util.h			\
 	$(INCLUDE)/no_os_list.h			\
@@ -31,7 +32,8 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 	$(INCLUDE)/no_os_mutex.h
 
 
-SRCS += $(NO-OS)/util/no_os_lf256fifo.c		\
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c		\
+	$(NO-OS)/util/no_os_sample.c		\
 	$(DRIVERS)/api/no_os_gpio.c		\
 	$(DRIVERS)/api/no_os_irq.c		\
 	$(DRIVERS)/api/no_os_spi.c		\
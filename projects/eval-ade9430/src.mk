@@ -13,7 +13,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 	$(INCLUDE)/no_os_list.h      \
 	$(INCLUDE)/no_os_timer.h      \
 	$(INCLUDE)/no_os_uart.h      \
-	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_sample.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_units.h \
 	$(INCLUDE)/no_os_alloc.h \
@@ -41,7 +42,8 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/meter/ade9430/ade9430.c \
 	$(DRIVERS)/rtc/pcf85263/pcf85263.c \
 	$(DRIVERS)/api/no_os_i2c.c  \
-	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
+	$(NO-OS)/util/no_os_sample.c \
 	$(DRIVERS)/api/no_os_gpio.c  \
 	$(DRIVERS)/api/no_os_irq.c  \
 	$(DRIVERS)/api/no_os_spi.c  \
@@ -18,11 +18,10 @@ SRCS += $(DRIVERS)/accel/adxl367/iio_adxl367.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
-	$(NO-OS)/util/no_os_fifo.c
+	$(NO-OS)/util/no_os_spsc_ring.c
 
 INCS +=	$(DRIVERS)/accel/adxl367/iio_adxl367.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_irq.h \
-	$(INCLUDE)/no_os_fifo.h \
-	$(INCLUDE)/no_os_lf256fifo.h
+	$(INCLUDE)/no_os_spsc_ring.h
 endif
@@ -10,11 +10,14 @@ SRCS += $(NO-OS)/util/no_os_circular_buffer.c \
 	$(DRIVERS)/api/no_os_timer.c
 	
 INCS += $(INCLUDE)/no_os_circular_buffer.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_sample.h \
 	$(INCLUDE)/no_os_timer.h           \
 	$(PLATFORM_DRIVERS)/aducm3029_timer.h  \
 	$(PLATFORM_DRIVERS)/aducm3029_rtc.h
 
-SRCS += $(NO-OS)/util/no_os_lf256fifo.c  \
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c  \
+	$(NO-OS)/util/no_os_sample.c  \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_timer.c
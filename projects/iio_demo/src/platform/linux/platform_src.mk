@@ -13,7 +13,11 @@ INCS += $(NO-OS)/network/linux_socket/linux_socket.h \
 	
 
 SRCS += $(NO-OS)/util/no_os_circular_buffer.c
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c
+SRCS += $(NO-OS)/util/no_os_sample.c
 INCS += $(INCLUDE)/no_os_circular_buffer.h
+INCS += $(INCLUDE)/no_os_spsc_ring.h
+INCS += $(INCLUDE)/no_os_sample.h
 
 SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
 	$(DRIVERS)/platform/linux/linux_delay.c
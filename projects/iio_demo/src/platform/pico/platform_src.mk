@@ -6,7 +6,7 @@ SRCS += $(PLATFORM_DRIVERS)/pico_uart.c  \
         $(PLATFORM_DRIVERS)/pico_irq.c   \
         $(PLATFORM_DRIVERS)/pico_timer.c
 
-SRCS += $(NO-OS)/util/no_os_lf256fifo.c \
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c \
         $(DRIVERS)/api/no_os_irq.c      \
         $(DRIVERS)/api/no_os_timer.c
 
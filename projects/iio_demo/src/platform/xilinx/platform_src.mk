@@ -11,11 +11,14 @@ SRCS += $(NO-OS)/util/no_os_circular_buffer.c \
 	$(PLATFORM_DRIVERS)/xilinx_timer.c
 
 INCS += $(INCLUDE)/no_os_circular_buffer.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_sample.h \
 	$(INCLUDE)/no_os_timer.h           \
 	$(PLATFORM_DRIVERS)/xilinx_timer.h  \
 	$(PLATFORM_DRIVERS)/rtc_extra.h
 
-SRCS += $(NO-OS)/util/no_os_lf256fifo.c  \
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c  \
+	$(NO-OS)/util/no_os_sample.c  \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c
 
@@ -13,16 +13,15 @@ INCS += $(PROJECT)/src/platform/$(PLATFORM)/parameters.h
 SRCS += $(PROJECT)/src/platform/$(PLATFORM)/parameters.c 
 
 SRCS += $(DRIVERS)/api/no_os_uart.c     \
-    $(NO-OS)/util/no_os_fifo.c      \
+    $(NO-OS)/util/no_os_spsc_ring.c \
     $(NO-OS)/util/no_os_list.c      \
     $(NO-OS)/util/no_os_util.c      \
     $(NO-OS)/util/no_os_alloc.c     
 
 INCS += $(INCLUDE)/no_os_delay.h     \
     $(INCLUDE)/no_os_error.h     \
-    $(INCLUDE)/no_os_fifo.h      \
+    $(INCLUDE)/no_os_spsc_ring.h \
     $(INCLUDE)/no_os_irq.h       \
-    $(INCLUDE)/no_os_lf256fifo.h \
     $(INCLUDE)/no_os_list.h      \
     $(INCLUDE)/no_os_timer.h     \
     $(INCLUDE)/no_os_uart.h      \
@@ -25,14 +25,14 @@ INCS += $(INCLUDE)/no_os_delay.h        \
         $(INCLUDE)/no_os_dma.h         \
         $(INCLUDE)/no_os_uart.h         \
         $(INCLUDE)/no_os_timer.h        \
-        $(INCLUDE)/no_os_lf256fifo.h    \
+        $(INCLUDE)/no_os_spsc_ring.h    \
         $(INCLUDE)/no_os_util.h         \
         $(INCLUDE)/no_os_units.h        \
         $(INCLUDE)/no_os_alloc.h        \
         $(INCLUDE)/no_os_mutex.h
 
 SRCS += $(DRIVERS)/api/no_os_gpio.c     \
-        $(NO-OS)/util/no_os_lf256fifo.c \
+        $(NO-OS)/util/no_os_spsc_ring.c \
         $(DRIVERS)/api/no_os_irq.c      \
         $(DRIVERS)/api/no_os_timer.c    \
         $(DRIVERS)/api/no_os_spi.c      \
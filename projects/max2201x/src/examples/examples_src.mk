@@ -17,12 +17,14 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c	\
 	$(DRIVERS)/dac/max2201x/iio_max2201x.c	\
 	$(NO-OS)/iio/iio.c	\
 	$(NO-OS)/iio/iiod.c	\
-	$(NO-OS)/util/no_os_fifo.c
+	$(NO-OS)/util/no_os_spsc_ring.c \
+	$(NO-OS)/util/no_os_sample.c
 
 INCS += $(NO-OS)/iio/iio_app/iio_app.h	\
 	$(DRIVERS)/dac/max2201x/iio_max2201x.h	\
 	$(NO-OS)/iio/iio.h	\
 	$(NO-OS)/iio/iiod.h	\
 	$(NO-OS)/iio/iio_types.h	\
-	$(NO-OS)/include/no_os_fifo.h
+	$(NO-OS)/include/no_os_spsc_ring.h \
+	$(NO-OS)/include/no_os_sample.h
 endif
@@ -0,0 +1,103 @@
+/***************************************************************************//**
+ *   @file   bench.c
+ *   @brief  Timing helpers shared by the benchmarks.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*
+ * Included by the benchmarks, next to unity.h. Each conversion is timed
+ * BENCH_ROUNDS times in a row, keeping the best of BENCH_REPEAT runs.
+ * Results are only reported, run "ceedling test:all" in tests/bench and look
+ * for the test output; they are not compared against a threshold.
+ */
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS		400
+#endif
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT		5
+#endif
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/*
+ * Best time per item out of BENCH_REPEAT runs, to filter out preemption.
+ * run processes nb_items items per call.
+ */
+static double bench_ns(void (*run)(void), uint32_t nb_items)
+{
+	double ns, best = 0;
+	clock_t start;
+	int i, j;
+
+	for (i = 0; i < BENCH_REPEAT; i++) {
+		start = clock();
+		for (j = 0; j < BENCH_ROUNDS; j++)
+			run();
+		ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC /
+		     ((double)BENCH_ROUNDS * nb_items);
+		if (!i || ns < best)
+			best = ns;
+	}
+
+	return best;
+}
+
+/* Report the time per item of the legacy code and of its replacement. */
+static void bench_report(const char *name, const char *item,
+			 uint32_t nb_items, void (*legacy)(void),
+			 void (*run)(void))
+{
+	char msg[128];
+
+	snprintf(msg, sizeof(msg), "%s: %.2f ns/%s before, %.2f after",
+		 name, bench_ns(legacy, nb_items), item,
+		 bench_ns(run, nb_items));
+	TEST_MESSAGE(msg);
+}
@@ -0,0 +1,195 @@
+/***************************************************************************//**
+ *   @file   test_iio_value_bench.c
+ *   @brief  Benchmark of the IIO attribute value formatting and parsing.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_sample.h"
+#include "mock_iiod.h"
+#include "mock_no_os_uart.h"
+#include "iio_value_legacy.c"
+#include "bench.c"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Each conversion is timed on BENCH_NB_VALUES values, see bench.c */
+#define BENCH_NB_VALUES		256
+#define BENCH_STR_SIZE		32
+
+static int32_t vals[BENCH_NB_VALUES][2];
+static char strs[BENCH_NB_VALUES][BENCH_STR_SIZE];
+static char expected[BENCH_NB_VALUES][BENCH_STR_SIZE];
+static char out[BENCH_NB_VALUES][BENCH_STR_SIZE];
+static int32_t expected_vals[BENCH_NB_VALUES][2];
+static int32_t out_vals[BENCH_NB_VALUES][2];
+static enum iio_val bench_fmt;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void run_legacy_format(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < BENCH_NB_VALUES; i++)
+		legacy_format_value(expected[i], BENCH_STR_SIZE, bench_fmt, 2,
+				    vals[i]);
+}
+
+static void run_format(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < BENCH_NB_VALUES; i++)
+		iio_format_value(out[i], BENCH_STR_SIZE, bench_fmt, 2, vals[i]);
+}
+
+/* Both parsers get a copy of the string, the old one tokenizes it in place */
+static void run_legacy_parse(void)
+{
+	char buf[BENCH_STR_SIZE];
+	uint32_t i;
+
+	for (i = 0; i < BENCH_NB_VALUES; i++) {
+		memcpy(buf, strs[i], BENCH_STR_SIZE);
+		legacy_parse_value(buf, bench_fmt, &expected_vals[i][0],
+				   &expected_vals[i][1]);
+	}
+}
+
+static void run_parse(void)
+{
+	char buf[BENCH_STR_SIZE];
+	uint32_t i;
+
+	for (i = 0; i < BENCH_NB_VALUES; i++) {
+		memcpy(buf, strs[i], BENCH_STR_SIZE);
+		iio_parse_value(buf, bench_fmt, &out_vals[i][0],
+				&out_vals[i][1]);
+	}
+}
+
+static void bench_format(const char *name, enum iio_val fmt)
+{
+	bench_fmt = fmt;
+	bench_report(name, "value", BENCH_NB_VALUES, run_legacy_format,
+		     run_format);
+
+	TEST_ASSERT_EQUAL_MEMORY(expected, out, sizeof(out));
+}
+
+static void bench_parse(const char *name, enum iio_val fmt)
+{
+	uint32_t i;
+
+	/* Fractions with 6 digits at most, which both parsers agree on */
+	for (i = 0; i < BENCH_NB_VALUES; i++)
+		snprintf(strs[i], BENCH_STR_SIZE, "%"PRIi32".%"PRIu32"\n",
+			 vals[i][0], (uint32_t)vals[i][1] % 1000000);
+
+	bench_fmt = fmt;
+	bench_report(name, "value", BENCH_NB_VALUES, run_legacy_parse,
+		     run_parse);
+
+	TEST_ASSERT_EQUAL_INT32_ARRAY(expected_vals, out_vals,
+				      2 * BENCH_NB_VALUES);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 0x12345678;
+	uint32_t i;
+
+	for (i = 0; i < BENCH_NB_VALUES; i++) {
+		seed = seed * 1103515245 + 12345;
+		vals[i][0] = (int32_t)seed >> (seed % 24);
+		seed = seed * 1103515245 + 12345;
+		vals[i][1] = (seed >> 8) | 1;
+	}
+	memset(expected, 0, sizeof(expected));
+	memset(out, 0, sizeof(out));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_bench_format_int(void)
+{
+	bench_format("format int", IIO_VAL_INT);
+}
+
+void test_bench_format_int_plus_micro(void)
+{
+	bench_format("format int plus micro", IIO_VAL_INT_PLUS_MICRO);
+}
+
+void test_bench_format_fractional(void)
+{
+	bench_format("format fractional", IIO_VAL_FRACTIONAL);
+}
+
+void test_bench_parse_int(void)
+{
+	bench_parse("parse int", IIO_VAL_INT);
+}
+
+void test_bench_parse_int_plus_micro(void)
+{
+	bench_parse("parse int plus micro", IIO_VAL_INT_PLUS_MICRO);
+}
@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ *   @file   test_no_os_sample_bench.c
+ *   @brief  Benchmark of the sample format conversions.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+
+#include "unity.h"
+#include "no_os_sample.h"
+#include "no_os_util.h"
+#include "bench.c"
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* The conversions are timed on BENCH_NB_SAMPLES samples, see bench.c */
+#define BENCH_NB_SAMPLES	1152
+
+static uint8_t raw[BENCH_NB_SAMPLES * 4];
+static int32_t out[BENCH_NB_SAMPLES];
+static int32_t expected[BENCH_NB_SAMPLES];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Big endian 24 bit samples, converted the way the drivers used to. */
+static void legacy_be24(uint8_t *src, int32_t *dst, uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++, src += 3)
+		dst[i] = no_os_sign_extend32(no_os_get_unaligned_be24(src), 23);
+}
+
+/* The 18 bit copy previously open coded in the ad7606 driver. */
+static void legacy_18b(const uint8_t *psrc, int32_t *dst, uint32_t nb)
+{
+	uint32_t *pdst = (uint32_t *)dst;
+	unsigned int i, j;
+
+	for (i = 0; i < nb / 4 * 9; i += 9) {
+		j = 4 * (i / 9);
+		pdst[j + 0] = ((uint32_t)psrc[i + 0] << 10) |
+			      ((uint32_t)psrc[i + 1] << 2) | (psrc[i + 2] >> 6);
+		pdst[j + 1] = ((uint32_t)(psrc[i + 2] & 0x3f) << 12) |
+			      ((uint32_t)psrc[i + 3] << 4) | (psrc[i + 4] >> 4);
+		pdst[j + 2] = ((uint32_t)(psrc[i + 4] & 0x0f) << 14) |
+			      ((uint32_t)psrc[i + 5] << 6) | (psrc[i + 6] >> 2);
+		pdst[j + 3] = ((uint32_t)(psrc[i + 6] & 0x03) << 16) |
+			      ((uint32_t)psrc[i + 7] << 8) | psrc[i + 8];
+	}
+}
+
+/* Byte at a time swap through a temporary buffer, as no_os_memswap64 did. */
+static void legacy_swap32(uint8_t *p, uint32_t bytes)
+{
+	uint8_t temp[4];
+	uint32_t i, j;
+
+	for (i = 0; i < bytes; i += 4) {
+		memcpy(temp, p, 4);
+		for (j = 4; j > 0; j--)
+			*p++ = temp[j - 1];
+	}
+}
+
+static const struct no_os_sample_fmt be24_fmt = { 24, 24, 0, true, true };
+static const struct no_os_sample_fmt b18_fmt = { 18, 18, 0, false, true };
+static uint8_t swap_buf[sizeof(raw)];
+
+static void run_legacy_be24(void)
+{
+	legacy_be24(raw, expected, BENCH_NB_SAMPLES);
+}
+
+static void run_unpack_be24(void)
+{
+	no_os_sample_unpack32(&be24_fmt, raw, out, BENCH_NB_SAMPLES);
+}
+
+static void run_legacy_18b(void)
+{
+	legacy_18b(raw, expected, BENCH_NB_SAMPLES);
+}
+
+static void run_unpack_18b(void)
+{
+	no_os_sample_unpack32(&b18_fmt, raw, out, BENCH_NB_SAMPLES);
+}
+
+static void run_legacy_swap32(void)
+{
+	legacy_swap32(swap_buf, sizeof(swap_buf));
+}
+
+static void run_swap32(void)
+{
+	no_os_sample_swap32(raw, BENCH_NB_SAMPLES);
+}
+
+static void bench_samples(const char *name, void (*legacy)(void),
+			  void (*sample)(void))
+{
+	bench_report(name, "sample", BENCH_NB_SAMPLES, legacy, sample);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 0x12345678;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(raw); i++) {
+		seed = seed * 1103515245 + 12345;
+		raw[i] = seed >> 16;
+	}
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_bench_unpack_be24(void)
+{
+	bench_samples("be24 to s32", run_legacy_be24, run_unpack_be24);
+
+	TEST_ASSERT_EQUAL_INT32_ARRAY(expected, out, BENCH_NB_SAMPLES);
+}
+
+void test_bench_unpack_18b(void)
+{
+	bench_samples("18 bit bitstream to u32", run_legacy_18b,
+		      run_unpack_18b);
+
+	TEST_ASSERT_EQUAL_INT32_ARRAY(expected, out, BENCH_NB_SAMPLES);
+}
+
+void test_bench_swap32(void)
+{
+	memcpy(swap_buf, raw, sizeof(raw));
+
+	/* An even number of rounds leaves both buffers unchanged */
+	bench_samples("swap32", run_legacy_swap32, run_swap32);
+
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(swap_buf, raw, sizeof(raw));
+}
@@ -0,0 +1,210 @@
+/***************************************************************************//**
+ *   @file   iio_value_legacy.c
+ *   @brief  Previous stdio based IIO attribute value formatting and parsing.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "iio_types.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/*
+ * The stdio based formatting and parsing iio_format_value and
+ * iio_parse_value used before, kept as reference.
+ */
+static int32_t legacy_str_parse(char *buf, int32_t *integer, int32_t *_fract,
+				bool scale_db)
+{
+	char *p;
+
+	p = strtok(buf, ".");
+	if (p == NULL)
+		return -EINVAL;
+
+	*integer = strtol(p, NULL, 0);
+
+	if (scale_db) {
+		p = strtok(NULL, "db");
+		if (p == NULL)
+			p = strtok(NULL, " db");
+	} else
+		p = strtok(NULL, "\n");
+
+	if (p == NULL)
+		return -EINVAL;
+
+	*_fract = strtol(p, NULL, 10);
+
+	return 0;
+}
+
+static int32_t legacy_fract_interpret(int32_t fract, int32_t subunits)
+{
+	int32_t temp = fract;
+
+	while ((subunits != 0) || (temp != 0)) {
+		temp /= 10;
+		subunits /= 10;
+		if (!temp)
+			break;
+		if (subunits <= 1)
+			fract /= 10;
+	}
+
+	return fract * subunits;
+}
+
+static int32_t legacy_parse_value(char *buf, enum iio_val fmt, int32_t *val,
+				  int32_t *val2)
+{
+	int32_t ret = 0;
+	int32_t integer, _fract = 0;
+	char ch;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		integer = strtol(buf, NULL, 0);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		ret = legacy_str_parse(buf, &integer, &_fract, true);
+		if (ret < 0)
+			return ret;
+		_fract = legacy_fract_interpret(_fract, 1000000);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO:
+		ret = legacy_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		_fract = legacy_fract_interpret(_fract, 1000000);
+		break;
+	case IIO_VAL_INT_PLUS_NANO:
+		ret = legacy_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		_fract = legacy_fract_interpret(_fract, 1000000000);
+		break;
+	case IIO_VAL_FRACTIONAL:
+		ret = legacy_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		break;
+	case IIO_VAL_CHAR:
+		if (sscanf(buf, "%c", &ch) != 1)
+			return -EINVAL;
+		integer = ch;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (val)
+		*val = integer;
+	if (val2)
+		*val2 = _fract;
+
+	return ret;
+}
+
+static int legacy_format_value(char *buf, uint32_t len, enum iio_val fmt,
+			       int32_t size, int32_t *vals)
+{
+	int64_t tmp;
+	int32_t integer, fractional;
+	bool dB = false;
+	int32_t i = 0;
+	uint32_t l = 0;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		dB = true;
+	/* intentional fall through */
+	case IIO_VAL_INT_PLUS_MICRO:
+		return snprintf(buf, len, "%"PRIi32".%06"PRIu32"%s", vals[0],
+				(uint32_t)vals[1], dB ? " dB" : "");
+	case IIO_VAL_INT_PLUS_NANO:
+		return snprintf(buf, len, "%"PRIi32".%09"PRIu32"", vals[0],
+				(uint32_t)vals[1]);
+	case IIO_VAL_FRACTIONAL:
+		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+		fractional = vals[1];
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000,
+						     &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_FRACTIONAL_LOG2:
+		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL,
+					vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL,
+						     &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_INT_MULTIPLE: {
+		while (i < size) {
+			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
+			if (l >= len)
+				break;
+			i++;
+		}
+		return l;
+	}
+	case IIO_VAL_CHAR:
+		return snprintf(buf, len, "%c", (char)vals[0]);
+	default:
+		return 0;
+	}
+}
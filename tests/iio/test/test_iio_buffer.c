@@ -0,0 +1,345 @@
+/***************************************************************************//**
+ *   @file   test_iio_buffer.c
+ *   @brief  Unit tests of the multi-block IIO buffers.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "iiod.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_sample.h"
+#include "mock_iiod.h"
+#include "mock_no_os_uart.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_DEV		"iio:device0"
+#define TEST_SAMPLES		8
+#define TEST_BLOCK_SIZE		(TEST_SAMPLES * 2 * sizeof(int16_t))
+#define TEST_BUFFERS_COUNT	4
+
+static struct scan_type test_scan_type = {
+	.sign = 's',
+	.realbits = 16,
+	.storagebits = 16,
+};
+
+static struct iio_channel test_channels[] = {
+	{
+		.name = "voltage0",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 0,
+		.scan_index = 0,
+		.scan_type = &test_scan_type,
+		.indexed = true,
+	},
+	{
+		.name = "voltage1",
+		.ch_type = IIO_VOLTAGE,
+		.channel = 1,
+		.scan_index = 1,
+		.scan_type = &test_scan_type,
+		.indexed = true,
+	},
+};
+
+static int32_t test_submit(struct iio_device_data *dev);
+
+static struct iio_device test_device = {
+	.num_ch = NO_OS_ARRAY_SIZE(test_channels),
+	.channels = test_channels,
+	.submit = test_submit,
+};
+
+static char test_backend_buff[64];
+
+static struct iio_local_backend test_backend = {
+	.local_backend_buff = test_backend_buff,
+	.local_backend_buff_len = sizeof(test_backend_buff),
+};
+
+static struct iio_desc *desc;
+static struct iiod_ops *ops;
+static struct iiod_ctx ctx;
+
+/* State of the simulated DMA transfer */
+static struct iio_buffer *dma_buffer;
+static void *dma_addr;
+static bool dma_running;
+static uint32_t nb_submits;
+static uint8_t next_block_id;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int32_t test_iiod_init(struct iiod_desc **iiod,
+			      struct iiod_init_param *param, int num_calls)
+{
+	ops = param->ops;
+	ctx.instance = param->instance;
+
+	return 0;
+}
+
+/* Start the DMA on a free block and return without waiting for it */
+static int32_t test_submit(struct iio_device_data *dev)
+{
+	int ret;
+
+	nb_submits++;
+	dma_buffer = dev->buffer;
+	ret = iio_buffer_get_block(dma_buffer, &dma_addr);
+	if (ret)
+		return ret;
+
+	dma_running = true;
+
+	return 0;
+}
+
+/*
+ * DMA completion interrupt: the block is filled with its id, then the next
+ * free block is started. The DMA stops when all the blocks wait to be sent.
+ */
+static void test_dma_complete(void)
+{
+	TEST_ASSERT_TRUE(dma_running);
+
+	memset(dma_addr, next_block_id++, TEST_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_block_done(dma_buffer));
+
+	dma_running = !iio_buffer_get_block(dma_buffer, &dma_addr);
+}
+
+/* Send the next block like READBUF and check it holds block_id */
+static void check_read_block(uint8_t block_id)
+{
+	uint8_t expected[TEST_BLOCK_SIZE];
+	char *buf;
+	int ret;
+
+	memset(expected, block_id, sizeof(expected));
+
+	ret = ops->read_buffer_zc(&ctx, TEST_DEV, &buf, TEST_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(TEST_BLOCK_SIZE, ret);
+	TEST_ASSERT_EQUAL_MEMORY(expected, buf, TEST_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(0, ops->read_buffer_done(&ctx, TEST_DEV,
+			      TEST_BLOCK_SIZE));
+}
+
+static void init_iio(uint32_t buffers_count)
+{
+	struct iio_device_init dev_init = {
+		.name = "adc",
+		.dev_descriptor = &test_device,
+		.buffers_count = buffers_count,
+	};
+	struct iio_init_param init_param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &test_backend,
+		.devs = &dev_init,
+		.nb_devs = 1,
+	};
+
+	iiod_init_StubWithCallback(test_iiod_init);
+	iiod_conn_add_IgnoreAndReturn(0);
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&desc, &init_param));
+	TEST_ASSERT_EQUAL_INT(0, ops->open(&ctx, TEST_DEV, TEST_SAMPLES, 0x3,
+					   false));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	desc = NULL;
+	ops = NULL;
+	dma_buffer = NULL;
+	dma_running = false;
+	nb_submits = 0;
+	next_block_id = 0;
+}
+
+void tearDown(void)
+{
+	if (!desc)
+		return;
+
+	dma_running = false;
+	ops->close(&ctx, TEST_DEV);
+	iiod_remove_Ignore();
+	iio_remove(desc);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_single_block_by_default(void)
+{
+	init_iio(0);
+
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	TEST_ASSERT_NULL(dma_buffer->blocks);
+}
+
+void test_buffers_count_range(void)
+{
+	init_iio(1);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ops->set_buffers_count(&ctx, TEST_DEV,
+			      0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, ops->set_buffers_count(&ctx, TEST_DEV,
+			      TEST_BUFFERS_COUNT + 1));
+	TEST_ASSERT_EQUAL_INT(0, ops->set_buffers_count(&ctx, TEST_DEV,
+			      TEST_BUFFERS_COUNT));
+
+	/* Used from the next time the buffer is opened */
+	TEST_ASSERT_EQUAL_INT(0, ops->close(&ctx, TEST_DEV));
+	TEST_ASSERT_EQUAL_INT(0, ops->open(&ctx, TEST_DEV, TEST_SAMPLES, 0x3,
+					   false));
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	TEST_ASSERT_EQUAL_UINT32(TEST_BUFFERS_COUNT,
+				 no_os_spsc_ring_capacity(dma_buffer->blocks));
+}
+
+void test_next_block_filled_while_sending(void)
+{
+	char *buf;
+
+	init_iio(TEST_BUFFERS_COUNT);
+
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_submits);
+
+	/* Nothing to send until the first block is complete */
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, ops->read_buffer_zc(&ctx, TEST_DEV,
+			      &buf, TEST_BLOCK_SIZE));
+	test_dma_complete();
+
+	/* Block 1 is filled while block 0 is sent */
+	TEST_ASSERT_EQUAL_INT(TEST_BLOCK_SIZE,
+			      ops->read_buffer_zc(&ctx, TEST_DEV, &buf,
+						  TEST_BLOCK_SIZE));
+	test_dma_complete();
+	TEST_ASSERT_EQUAL_INT(0, ops->read_buffer_done(&ctx, TEST_DEV,
+			      TEST_BLOCK_SIZE));
+
+	/* The next READBUF doesn't restart the acquisition */
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	check_read_block(1);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_submits);
+	TEST_ASSERT_TRUE(dma_running);
+}
+
+void test_partial_reads(void)
+{
+	char *buf;
+	int ret;
+
+	init_iio(TEST_BUFFERS_COUNT);
+
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	test_dma_complete();
+	test_dma_complete();
+
+	/* A region never spans two blocks */
+	ret = ops->read_buffer_zc(&ctx, TEST_DEV, &buf, TEST_BLOCK_SIZE / 4);
+	TEST_ASSERT_EQUAL_INT(TEST_BLOCK_SIZE / 4, ret);
+	TEST_ASSERT_EQUAL_INT(0, ops->read_buffer_done(&ctx, TEST_DEV, ret));
+	ret = ops->read_buffer_zc(&ctx, TEST_DEV, &buf, 2 * TEST_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT(TEST_BLOCK_SIZE - TEST_BLOCK_SIZE / 4, ret);
+	TEST_ASSERT_EQUAL_UINT32(0, (uint8_t)buf[0]);
+	TEST_ASSERT_EQUAL_INT(0, ops->read_buffer_done(&ctx, TEST_DEV, ret));
+
+	check_read_block(1);
+}
+
+void test_full_buffer_stops_the_device(void)
+{
+	uint32_t i;
+
+	init_iio(TEST_BUFFERS_COUNT);
+
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	for (i = 0; i < TEST_BUFFERS_COUNT; i++)
+		test_dma_complete();
+
+	/* The blocks that were not sent are not overwritten */
+	TEST_ASSERT_TRUE(!dma_running);
+	for (i = 0; i < TEST_BUFFERS_COUNT; i++) {
+		TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+		check_read_block(i);
+	}
+	TEST_ASSERT_EQUAL_UINT32(1, nb_submits);
+
+	/* The idle device is started again once everything was sent */
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_submits);
+	test_dma_complete();
+	check_read_block(TEST_BUFFERS_COUNT);
+}
+
+void test_get_block_checks(void)
+{
+	void *addr;
+
+	init_iio(TEST_BUFFERS_COUNT);
+
+	TEST_ASSERT_EQUAL_INT(0, ops->refill_buffer(&ctx, TEST_DEV));
+
+	/* Only one block is filled at a time */
+	TEST_ASSERT_EQUAL_INT(-EBUSY, iio_buffer_get_block(dma_buffer, &addr));
+	test_dma_complete();
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_block_done(dma_buffer));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_buffer_block_done(dma_buffer));
+	dma_running = false;
+}
@@ -0,0 +1,463 @@
+/***************************************************************************//**
+ *   @file   test_iio_value.c
+ *   @brief  Unit tests of the IIO attribute value formatting and parsing.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_sample.h"
+#include "mock_iiod.h"
+#include "mock_no_os_uart.h"
+#include "iio_value_legacy.c"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_VALUES		20000
+#define TEST_BUF_SIZE		80
+
+static const uint32_t test_lens[] = {
+	0, 1, 2, 5, 9, 12, 17, 24, TEST_BUF_SIZE
+};
+
+static uint32_t seed;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t test_rand(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+/* Random value with a random number of significant bits and sign */
+static int32_t test_rand_i32(void)
+{
+	uint32_t v = test_rand() >> (test_rand() % 32);
+
+	return test_rand() & 1 ? (int32_t)v : -(int32_t)(v >> 1);
+}
+
+/* Format vals with both implementations, for every buffer length */
+static void check_format(enum iio_val fmt, int32_t size, int32_t *vals)
+{
+	char expected[TEST_BUF_SIZE];
+	char actual[TEST_BUF_SIZE];
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(test_lens); i++) {
+		memset(expected, '#', sizeof(expected));
+		memset(actual, '#', sizeof(actual));
+
+		ret = legacy_format_value(expected, test_lens[i], fmt, size,
+					  vals);
+		TEST_ASSERT_EQUAL_INT(ret, iio_format_value(actual,
+					test_lens[i], fmt, size, vals));
+		TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(expected));
+	}
+}
+
+/* Parse str with both implementations, which may modify their buffer */
+static void check_parse(enum iio_val fmt, const char *str)
+{
+	char expected_buf[TEST_BUF_SIZE];
+	char actual_buf[TEST_BUF_SIZE];
+	int32_t expected[2] = { 0 };
+	int32_t actual[2] = { 0 };
+	int32_t ret;
+
+	strcpy(expected_buf, str);
+	strcpy(actual_buf, str);
+
+	ret = legacy_parse_value(expected_buf, fmt, &expected[0], &expected[1]);
+	TEST_ASSERT_EQUAL_INT32_MESSAGE(ret, iio_parse_value(actual_buf, fmt,
+					&actual[0], &actual[1]), str);
+	TEST_ASSERT_EQUAL_INT32_ARRAY_MESSAGE(expected, actual, 2, str);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	seed = 0x2545F491;
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_number_to_str_matches_snprintf(void)
+{
+	char expected[16];
+	char actual[16];
+	uint32_t i, v, width;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		v = test_rand_i32();
+		width = test_rand() % 11;
+
+		snprintf(expected, sizeof(expected), "%0*"PRIu32, (int)width,
+			 v);
+		TEST_ASSERT_EQUAL_UINT32(strlen(expected),
+					 no_os_uint32_to_str(actual, v, width));
+		TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+		snprintf(expected, sizeof(expected), "%"PRIi32, (int32_t)v);
+		TEST_ASSERT_EQUAL_UINT32(strlen(expected),
+					 no_os_int32_to_str(actual, v));
+		TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+		width %= 9;
+		snprintf(expected, sizeof(expected), "%0*"PRIx32, (int)width,
+			 v);
+		TEST_ASSERT_EQUAL_UINT32(strlen(expected),
+					 no_os_uint32_to_hex_str(actual, v,
+							 width));
+		TEST_ASSERT_EQUAL_STRING(expected, actual);
+	}
+
+	TEST_ASSERT_EQUAL_UINT32(11, no_os_int32_to_str(actual, INT32_MIN));
+	TEST_ASSERT_EQUAL_STRING("-2147483648", actual);
+	TEST_ASSERT_EQUAL_UINT32(10, no_os_uint32_to_str(actual, UINT32_MAX,
+				 3));
+	TEST_ASSERT_EQUAL_STRING("4294967295", actual);
+}
+
+void test_str_parse_matches_strtol(void)
+{
+	static const char *const prefixes[] = {
+		"", " ", "\t-", "+", "0", "0x", "-0X", "x", "-"
+	};
+	static const char *const suffixes[] = { "", ".5", " 7", "x", "\n" };
+	static const uint32_t bases[] = { 0, 8, 10, 16 };
+	char str[TEST_BUF_SIZE];
+	char *end;
+	uint32_t i, j, u, n;
+	int32_t s;
+	long l;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		/* Keep in the int32_t range, where strtol() is the same on
+		 * 32 and 64 bit hosts
+		 */
+		snprintf(str, sizeof(str), "%s%"PRIx32"%s",
+			 prefixes[test_rand() % NO_OS_ARRAY_SIZE(prefixes)],
+			 (test_rand() >> 4) >> (test_rand() % 28),
+			 suffixes[test_rand() % NO_OS_ARRAY_SIZE(suffixes)]);
+		if (test_rand() & 1)
+			str[strcspn(str, "abcdef")] = '\0';
+
+		for (j = 0; j < NO_OS_ARRAY_SIZE(bases); j++) {
+			l = strtol(str, &end, bases[j]);
+			n = no_os_str_parse_int32(str, bases[j], &s);
+			TEST_ASSERT_EQUAL_INT32_MESSAGE(l, s, str);
+			TEST_ASSERT_EQUAL_UINT32_MESSAGE(end - str, n, str);
+
+			n = no_os_str_parse_uint32(str, bases[j], &u);
+			TEST_ASSERT_EQUAL_HEX32_MESSAGE((uint32_t)l, u, str);
+			TEST_ASSERT_EQUAL_UINT32_MESSAGE(end - str, n, str);
+		}
+	}
+
+	/* Out of range values saturate like strtol() on 32 bit targets */
+	no_os_str_parse_int32("2147483648", 10, &s);
+	TEST_ASSERT_EQUAL_INT32(INT32_MAX, s);
+	no_os_str_parse_int32("-0x80000001", 0, &s);
+	TEST_ASSERT_EQUAL_INT32(INT32_MIN, s);
+	no_os_str_parse_int32("-2147483648", 0, &s);
+	TEST_ASSERT_EQUAL_INT32(INT32_MIN, s);
+	no_os_str_parse_uint32("0x100000000", 0, &u);
+	TEST_ASSERT_EQUAL_HEX32(UINT32_MAX, u);
+	no_os_str_parse_uint32("-1", 0, &u);
+	TEST_ASSERT_EQUAL_HEX32(UINT32_MAX, u);
+}
+
+void test_str_parse_fract(void)
+{
+	int32_t v;
+
+	TEST_ASSERT_EQUAL_UINT32(1, no_os_str_parse_fract("5", 6, &v));
+	TEST_ASSERT_EQUAL_INT32(500000, v);
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_str_parse_fract("025 dB", 6, &v));
+	TEST_ASSERT_EQUAL_INT32(25000, v);
+	TEST_ASSERT_EQUAL_UINT32(7, no_os_str_parse_fract("1234567", 6, &v));
+	TEST_ASSERT_EQUAL_INT32(123456, v);
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_str_parse_fract(" -5", 9, &v));
+	TEST_ASSERT_EQUAL_INT32(-500000000, v);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_str_parse_fract("x", 6, &v));
+	TEST_ASSERT_EQUAL_INT32(0, v);
+}
+
+void test_format_int(void)
+{
+	int32_t vals[1];
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		vals[0] = test_rand_i32();
+		check_format(IIO_VAL_INT, 1, vals);
+	}
+
+	vals[0] = INT32_MIN;
+	check_format(IIO_VAL_INT, 1, vals);
+	vals[0] = INT32_MAX;
+	check_format(IIO_VAL_INT, 1, vals);
+}
+
+void test_format_int_plus_micro_nano(void)
+{
+	int32_t vals[2];
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		vals[0] = test_rand_i32();
+		vals[1] = test_rand_i32();
+		check_format(IIO_VAL_INT_PLUS_MICRO, 2, vals);
+		check_format(IIO_VAL_INT_PLUS_MICRO_DB, 2, vals);
+		check_format(IIO_VAL_INT_PLUS_NANO, 2, vals);
+	}
+
+	vals[0] = INT32_MIN;
+	vals[1] = -1;
+	check_format(IIO_VAL_INT_PLUS_MICRO_DB, 2, vals);
+	check_format(IIO_VAL_INT_PLUS_NANO, 2, vals);
+}
+
+void test_format_fractional(void)
+{
+	int32_t vals[2];
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		vals[0] = test_rand_i32();
+		do {
+			vals[1] = test_rand_i32();
+		} while (!vals[1]);
+		check_format(IIO_VAL_FRACTIONAL, 2, vals);
+
+		vals[1] = test_rand() % 40;
+		check_format(IIO_VAL_FRACTIONAL_LOG2, 2, vals);
+	}
+
+	/* -0.5 */
+	vals[0] = -1;
+	vals[1] = 2;
+	check_format(IIO_VAL_FRACTIONAL, 2, vals);
+	vals[1] = 1;
+	check_format(IIO_VAL_FRACTIONAL_LOG2, 2, vals);
+}
+
+void test_format_int_multiple_and_char(void)
+{
+	int32_t vals[8];
+	uint32_t i, j;
+
+	for (i = 0; i < TEST_NB_VALUES / 8; i++) {
+		for (j = 0; j < NO_OS_ARRAY_SIZE(vals); j++)
+			vals[j] = test_rand_i32();
+		check_format(IIO_VAL_INT_MULTIPLE, i % 9, vals);
+		check_format(IIO_VAL_CHAR, 1, vals);
+	}
+
+	vals[0] = 0;
+	check_format(IIO_VAL_CHAR, 1, vals);
+	check_format(0, 1, vals);
+}
+
+void test_parse_matches_legacy(void)
+{
+	static const char *const ends[] = { "", "\n", " ", "\r\n" };
+	char str[TEST_BUF_SIZE];
+	const char *end;
+	int32_t integer;
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_VALUES; i++) {
+		integer = test_rand_i32();
+		end = ends[test_rand() % NO_OS_ARRAY_SIZE(ends)];
+
+		snprintf(str, sizeof(str), "%"PRIi32"%s", integer, end);
+		check_parse(IIO_VAL_INT, str);
+		snprintf(str, sizeof(str), "%#"PRIx32, (uint32_t)integer >> 1);
+		check_parse(IIO_VAL_INT, str);
+		snprintf(str, sizeof(str), "%#"PRIo32"%s",
+			 (uint32_t)integer >> 2, end);
+		check_parse(IIO_VAL_INT, str);
+
+		/* The fractional part the old parser got right: no leading
+		 * zeros and no more digits than the precision
+		 */
+		snprintf(str, sizeof(str), "%"PRIi32".%"PRIu32"%s", integer,
+			 test_rand() % 1000000, end);
+		check_parse(IIO_VAL_INT_PLUS_MICRO, str);
+		snprintf(str, sizeof(str), "%"PRIi32".%"PRIu32" dB", integer,
+			 test_rand() % 1000000);
+		check_parse(IIO_VAL_INT_PLUS_MICRO_DB, str);
+		snprintf(str, sizeof(str), "%"PRIi32".%"PRIu32"%s", integer,
+			 test_rand() % 1000000000, end);
+		check_parse(IIO_VAL_INT_PLUS_NANO, str);
+		snprintf(str, sizeof(str), "%"PRIi32".%"PRIi32"%s", integer,
+			 test_rand_i32(), end);
+		check_parse(IIO_VAL_FRACTIONAL, str);
+
+		str[0] = ' ' + test_rand() % 95;
+		str[1] = '\0';
+		check_parse(IIO_VAL_CHAR, str);
+	}
+
+	check_parse(IIO_VAL_INT_PLUS_MICRO, "0x10.5");
+	check_parse(IIO_VAL_INT_PLUS_MICRO, "-3.-25");
+	check_parse(IIO_VAL_INT_PLUS_MICRO, "..7.5");
+	check_parse(IIO_VAL_INT_PLUS_MICRO, "2.abc");
+	check_parse(IIO_VAL_INT_PLUS_MICRO_DB, "-12.5dB");
+	check_parse(IIO_VAL_INT, "garbage");
+}
+
+void test_parse_invalid(void)
+{
+	static const enum iio_val fmts[] = {
+		IIO_VAL_INT_PLUS_MICRO, IIO_VAL_INT_PLUS_MICRO_DB,
+		IIO_VAL_INT_PLUS_NANO, IIO_VAL_FRACTIONAL
+	};
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(fmts); i++) {
+		check_parse(fmts[i], "");
+		check_parse(fmts[i], "...");
+		check_parse(fmts[i], "5");
+		check_parse(fmts[i], "5.");
+		check_parse(fmts[i], "5.\n");
+	}
+	check_parse(IIO_VAL_CHAR, "");
+	check_parse(IIO_VAL_FRACTIONAL_LOG2, "1.5");
+	check_parse(IIO_VAL_INT_MULTIPLE, "1 2");
+}
+
+void test_parse_fraction_digits(void)
+{
+	char str[TEST_BUF_SIZE];
+	int32_t val, val2;
+
+	/* Leading zeros used to be dropped, reading 1.05 as 1.5 */
+	strcpy(str, "1.05");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_MICRO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(1, val);
+	TEST_ASSERT_EQUAL_INT32(50000, val2);
+
+	strcpy(str, "0.000000001\n");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_NANO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(0, val);
+	TEST_ASSERT_EQUAL_INT32(1, val2);
+
+	/* Digits past the precision used to zero the whole fraction */
+	strcpy(str, "3.1415926");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_MICRO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(3, val);
+	TEST_ASSERT_EQUAL_INT32(141592, val2);
+
+	strcpy(str, "-6.020000 dB");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str,
+				IIO_VAL_INT_PLUS_MICRO_DB, &val, &val2));
+	TEST_ASSERT_EQUAL_INT32(-6, val);
+	TEST_ASSERT_EQUAL_INT32(20000, val2);
+}
+
+void test_parse_negative_below_one(void)
+{
+	char str[TEST_BUF_SIZE];
+	int32_t val, val2;
+
+	/* The integer part reads as 0, the sign goes to the fraction */
+	strcpy(str, "-0.5");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_MICRO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(0, val);
+	TEST_ASSERT_EQUAL_INT32(-500000, val2);
+
+	strcpy(str, " -0.000000001\n");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_NANO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(0, val);
+	TEST_ASSERT_EQUAL_INT32(-1, val2);
+
+	strcpy(str, "-0.25 dB");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str,
+				IIO_VAL_INT_PLUS_MICRO_DB, &val, &val2));
+	TEST_ASSERT_EQUAL_INT32(0, val);
+	TEST_ASSERT_EQUAL_INT32(-250000, val2);
+
+	/* Otherwise the integer part carries the sign */
+	strcpy(str, "-1.5");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_MICRO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(-1, val);
+	TEST_ASSERT_EQUAL_INT32(500000, val2);
+
+	strcpy(str, "0.5");
+	TEST_ASSERT_EQUAL_INT32(0, iio_parse_value(str, IIO_VAL_INT_PLUS_MICRO,
+				&val, &val2));
+	TEST_ASSERT_EQUAL_INT32(0, val);
+	TEST_ASSERT_EQUAL_INT32(500000, val2);
+}
@@ -0,0 +1,337 @@
+/***************************************************************************//**
+ *   @file   test_no_os_crc.c
+ *   @brief  Unit tests of the CRC utilities.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_crc.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_sample.h"
+#include <errno.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_BUF_SIZE	96
+
+static const uint8_t check_str[] = "123456789";
+
+struct crc_test_vector {
+	struct no_os_crc_param param;
+	uint32_t check;
+};
+
+/* Check values are the CRC of "123456789", from the CRC catalogue. */
+static const struct crc_test_vector crc_vectors[] = {
+	/* CRC-8/SMBUS, used by most SPI CRC capable parts */
+	{ { 8, 0x07, 0x00, false, 0x00 }, 0xf4 },
+	/* CRC-8/I-432-1 (ATM HEC) */
+	{ { 8, 0x07, 0x00, false, 0x55 }, 0xa1 },
+	/* CRC-16/IBM-3740 */
+	{ { 16, 0x1021, 0xffff, false, 0x0000 }, 0x29b1 },
+	/* CRC-16/ARC */
+	{ { 16, 0x8005, 0x0000, true, 0x0000 }, 0xbb3d },
+	/* CRC-24/OPENPGP */
+	{ { 24, 0x864cfb, 0xb704ce, false, 0x000000 }, 0x21cf02 },
+	/* CRC-32/ISO-HDLC */
+	{ { 32, 0x04c11db7, 0xffffffff, true, 0xffffffff }, 0xcbf43926 },
+	/* CRC-32/BZIP2 */
+	{ { 32, 0x04c11db7, 0xffffffff, false, 0xffffffff }, 0xfc891918 },
+	/* CRC-32/ISCSI */
+	{ { 32, 0x1edc6f41, 0xffffffff, true, 0xffffffff }, 0xe3069283 },
+	/* CRC-12/DECT */
+	{ { 12, 0x80f, 0x000, false, 0x000 }, 0xf5b },
+	/* CRC-5/USB */
+	{ { 5, 0x05, 0x1f, true, 0x1f }, 0x19 },
+};
+
+static const enum no_os_crc_slice crc_slices[] = {
+	NO_OS_CRC_SLICE_BY_1,
+	NO_OS_CRC_SLICE_BY_4,
+	NO_OS_CRC_SLICE_BY_8,
+};
+
+static uint8_t test_buf[TEST_BUF_SIZE];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* The bit-serial CRC-8 previously open coded in the drivers. */
+static uint8_t bit_serial_crc8(const uint8_t *data, uint8_t data_size,
+			       uint8_t init_val)
+{
+	uint8_t i;
+	uint8_t crc = init_val;
+
+	while (data_size) {
+		for (i = 0x80; i != 0; i >>= 1) {
+			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
+				crc <<= 1;
+				crc ^= 0x07;
+			} else {
+				crc <<= 1;
+			}
+		}
+		data++;
+		data_size--;
+	}
+
+	return crc;
+}
+
+static uint32_t reflect(uint32_t val, uint8_t width)
+{
+	uint32_t ret = 0;
+
+	while (width--) {
+		ret = (ret << 1) | (val & 1);
+		val >>= 1;
+	}
+
+	return ret;
+}
+
+/* Straightforward bit at a time implementation of the CRC model. */
+static uint32_t bit_serial_crc(const struct no_os_crc_param *param,
+			       const uint8_t *data, size_t len)
+{
+	uint64_t mask = (1ull << param->width) - 1;
+	uint64_t top = 1ull << (param->width - 1);
+	uint64_t crc = param->init & mask;
+	uint8_t byte;
+	bool msb;
+	int i;
+
+	while (len--) {
+		byte = *data++;
+		if (param->reflect)
+			byte = reflect(byte, 8);
+		for (i = 7; i >= 0; i--) {
+			msb = (crc & top) != 0;
+			crc = (crc << 1) & mask;
+			if (msb != ((byte >> i) & 1))
+				crc ^= param->poly & mask;
+		}
+	}
+
+	if (param->reflect)
+		crc = reflect(crc, param->width);
+
+	return (crc ^ param->xor_out) & mask;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 0x12345678;
+	int i;
+
+	for (i = 0; i < TEST_BUF_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		test_buf[i] = seed >> 16;
+	}
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_crc8_const_table(void)
+{
+	NO_OS_DECLARE_CRC8_TABLE(table);
+
+	no_os_crc8_populate_msb(table, 0x07);
+
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(table, no_os_crc8_msb_07_table,
+				     NO_OS_CRC8_TABLE_SIZE);
+}
+
+void test_crc8_matches_bit_serial(void)
+{
+	uint8_t len, init, expected;
+
+	for (len = 0; len < TEST_BUF_SIZE; len++) {
+		for (init = 0; init < 4; init++) {
+			expected = bit_serial_crc8(test_buf, len, init);
+			TEST_ASSERT_EQUAL_HEX8(expected,
+					       no_os_crc8(no_os_crc8_msb_07_table,
+							  test_buf, len, init));
+		}
+	}
+}
+
+void test_crc_populate_invalid(void)
+{
+	struct no_os_crc_param param = { 0, 0x07, 0, false, 0 };
+	uint32_t table[NO_OS_CRC_TABLE_SIZE];
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_populate(NULL, &param,
+			      NO_OS_CRC_SLICE_BY_1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_populate(table, &param,
+			      NO_OS_CRC_SLICE_BY_1));
+	param.width = 33;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_populate(table, &param,
+			      NO_OS_CRC_SLICE_BY_1));
+	param.width = 8;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_populate(table, &param, 2));
+	TEST_ASSERT_EQUAL_INT(0, no_os_crc_populate(table, &param,
+			      NO_OS_CRC_SLICE_BY_1));
+}
+
+void test_crc_init_invalid(void)
+{
+	struct no_os_crc_param param = { 8, 0x07, 0, false, 0 };
+	struct no_os_crc_desc *desc;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_init(NULL, &param,
+			      NO_OS_CRC_SLICE_BY_1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_init(&desc, NULL,
+			      NO_OS_CRC_SLICE_BY_1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_init(&desc, &param, 3));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_crc_remove(NULL));
+}
+
+void test_crc_check_values(void)
+{
+	const struct crc_test_vector *vector;
+	struct no_os_crc_desc *desc;
+	size_t i, s;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc_vectors); i++) {
+		vector = &crc_vectors[i];
+		for (s = 0; s < NO_OS_ARRAY_SIZE(crc_slices); s++) {
+			TEST_ASSERT_EQUAL_INT(0, no_os_crc_init(&desc,
+								&vector->param,
+								crc_slices[s]));
+			TEST_ASSERT_EQUAL_HEX32(vector->check,
+						no_os_crc_compute(desc, check_str,
+								  9));
+			TEST_ASSERT_EQUAL_INT(0, no_os_crc_remove(desc));
+		}
+	}
+}
+
+void test_crc_matches_bit_serial(void)
+{
+	struct no_os_crc_desc *desc;
+	const struct no_os_crc_param *param;
+	size_t i, s, off, len;
+	uint32_t expected;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc_vectors); i++) {
+		param = &crc_vectors[i].param;
+		for (s = 0; s < NO_OS_ARRAY_SIZE(crc_slices); s++) {
+			TEST_ASSERT_EQUAL_INT(0, no_os_crc_init(&desc, param,
+								crc_slices[s]));
+			/* Cover every alignment and every tail length. */
+			for (off = 0; off < 8; off++) {
+				for (len = 0; len + off <= TEST_BUF_SIZE; len++) {
+					expected = bit_serial_crc(param,
+								  &test_buf[off],
+								  len);
+					TEST_ASSERT_EQUAL_HEX32(expected,
+								no_os_crc_compute(desc,
+										&test_buf[off],
+										len));
+				}
+			}
+			TEST_ASSERT_EQUAL_INT(0, no_os_crc_remove(desc));
+		}
+	}
+}
+
+void test_crc_cascade(void)
+{
+	struct no_os_crc_desc *desc;
+	uint32_t reg;
+	size_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc_vectors); i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_crc_init(&desc,
+							&crc_vectors[i].param,
+							NO_OS_CRC_SLICE_BY_8));
+		reg = no_os_crc_start(desc);
+		reg = no_os_crc_update(desc, reg, test_buf, 13);
+		reg = no_os_crc_update(desc, reg, &test_buf[13], 50);
+		reg = no_os_crc_update(desc, reg, &test_buf[63], 0);
+		TEST_ASSERT_EQUAL_HEX32(no_os_crc_compute(desc, test_buf, 63),
+					no_os_crc_finish(desc, reg));
+		TEST_ASSERT_EQUAL_INT(0, no_os_crc_remove(desc));
+	}
+}
+
+void test_crc_matches_crc16_crc24(void)
+{
+	struct no_os_crc_param crc16 = { 16, 0x1021, 0xffff, false, 0 };
+	struct no_os_crc_param crc24 = { 24, 0x864cfb, 0xb704ce, false, 0 };
+	NO_OS_DECLARE_CRC16_TABLE(table16);
+	NO_OS_DECLARE_CRC24_TABLE(table24);
+	struct no_os_crc_desc *desc16, *desc24;
+	size_t len;
+
+	no_os_crc16_populate_msb(table16, crc16.poly);
+	no_os_crc24_populate_msb(table24, crc24.poly);
+	TEST_ASSERT_EQUAL_INT(0, no_os_crc_init(&desc16, &crc16,
+						NO_OS_CRC_SLICE_BY_4));
+	TEST_ASSERT_EQUAL_INT(0, no_os_crc_init(&desc24, &crc24,
+						NO_OS_CRC_SLICE_BY_8));
+
+	for (len = 0; len < TEST_BUF_SIZE; len++) {
+		TEST_ASSERT_EQUAL_HEX16(no_os_crc16(table16, test_buf, len,
+						    crc16.init),
+					no_os_crc_compute(desc16, test_buf, len));
+		TEST_ASSERT_EQUAL_HEX32(no_os_crc24(table24, test_buf, len,
+						    crc24.init),
+					no_os_crc_compute(desc24, test_buf, len));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_crc_remove(desc16));
+	TEST_ASSERT_EQUAL_INT(0, no_os_crc_remove(desc24));
+}
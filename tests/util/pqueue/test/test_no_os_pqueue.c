@@ -0,0 +1,340 @@
+/***************************************************************************//**
+ *   @file   test_no_os_pqueue.c
+ *   @brief  Unit tests of the binary heap priority queue.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_pqueue.h"
+#include "no_os_list.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_sample.h"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_ELEMS	40
+
+struct test_elem {
+	uint32_t key;
+	uint32_t id;
+};
+
+static struct test_elem elems[TEST_NB_ELEMS];
+static struct no_os_list_desc *pq;
+static struct no_os_list_desc *list;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int32_t test_elem_cmp(void *data1, void *data2)
+{
+	struct test_elem *a = data1;
+	struct test_elem *b = data2;
+
+	if (a->key == b->key)
+		return 0;
+
+	return a->key < b->key ? -1 : 1;
+}
+
+/* Push the same elements on the heap and on the sorted list */
+static void push_both(struct test_elem *elem)
+{
+	TEST_ASSERT_EQUAL_INT32(0, pq->push(pq, elem));
+	TEST_ASSERT_EQUAL_INT32(0, list->push(list, elem));
+}
+
+/* Pop both until empty and check they return the very same elements */
+static void check_same_order(void)
+{
+	void *from_pq, *from_list;
+	uint32_t size;
+
+	while (!list->pop(list, &from_list)) {
+		TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &from_pq));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_get_size(pq, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+	TEST_ASSERT_EQUAL_INT32(-1, pq->pop(pq, &from_pq));
+	TEST_ASSERT_NULL(from_pq);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 0x12345678;
+	int i;
+
+	/* Few distinct keys, so that most elements compare equal */
+	for (i = 0; i < TEST_NB_ELEMS; i++) {
+		seed = seed * 1103515245 + 12345;
+		elems[i].key = (seed >> 16) % 5;
+		elems[i].id = i;
+	}
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_init(&pq, TEST_NB_ELEMS,
+				test_elem_cmp));
+	TEST_ASSERT_EQUAL_INT32(0, no_os_list_init(&list,
+				NO_OS_LIST_PRIORITY_LIST,
+				test_elem_cmp));
+}
+
+void tearDown(void)
+{
+	no_os_pqueue_remove(pq);
+	no_os_list_remove(list);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_pqueue_init_invalid(void)
+{
+	struct no_os_list_desc *desc;
+
+	TEST_ASSERT_EQUAL_INT32(-1, no_os_pqueue_init(NULL, 1, test_elem_cmp));
+	TEST_ASSERT_EQUAL_INT32(-1, no_os_pqueue_init(&desc, 0, test_elem_cmp));
+}
+
+void test_pqueue_ties_match_sorted_list(void)
+{
+	int i;
+
+	for (i = 0; i < TEST_NB_ELEMS; i++)
+		push_both(&elems[i]);
+
+	check_same_order();
+}
+
+void test_pqueue_ties_interleaved(void)
+{
+	void *from_pq, *from_list;
+	int i;
+
+	/* Pop in between the pushes, so that ties span several heap layouts */
+	for (i = 0; i < TEST_NB_ELEMS; i++) {
+		push_both(&elems[i]);
+		if (i % 3 == 2) {
+			TEST_ASSERT_EQUAL_INT32(0, list->pop(list, &from_list));
+			TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &from_pq));
+			TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+		}
+	}
+
+	check_same_order();
+}
+
+void test_pqueue_top_next(void)
+{
+	void *from_pq, *from_list;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT32(-1, pq->top_next(pq, &from_pq));
+	TEST_ASSERT_NULL(from_pq);
+
+	for (i = 0; i < TEST_NB_ELEMS; i++) {
+		push_both(&elems[i]);
+		TEST_ASSERT_EQUAL_INT32(0, list->top_next(list, &from_list));
+		TEST_ASSERT_EQUAL_INT32(0, pq->top_next(pq, &from_pq));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+}
+
+void test_pqueue_back(void)
+{
+	void *from_pq, *from_list;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT32(-1, pq->back(pq, &from_pq));
+	TEST_ASSERT_NULL(from_pq);
+
+	/* The last of the biggest elements, as in the sorted list */
+	for (i = 0; i < TEST_NB_ELEMS; i++) {
+		push_both(&elems[i]);
+		TEST_ASSERT_EQUAL_INT32(0, list->back(list, &from_list));
+		TEST_ASSERT_EQUAL_INT32(0, pq->back(pq, &from_pq));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+
+	while (!list->pop(list, &from_list)) {
+		TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &from_pq));
+		if (list->back(list, &from_list))
+			break;
+		TEST_ASSERT_EQUAL_INT32(0, pq->back(pq, &from_pq));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+}
+
+void test_pqueue_swap_resifts(void)
+{
+	struct test_elem small = { .key = 0 };
+	struct test_elem big = { .key = 10 };
+	struct test_elem *top;
+	void *data;
+	uint32_t size;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT32(-1, pq->swap(pq, &big));
+
+	for (i = 1; i <= 8; i++) {
+		elems[i].key = i;
+		TEST_ASSERT_EQUAL_INT32(0, pq->push(pq, &elems[i]));
+	}
+
+	/* Replacing the lowest element with a bigger one moves it down */
+	TEST_ASSERT_EQUAL_INT32(0, pq->swap(pq, &big));
+	TEST_ASSERT_EQUAL_INT32(0, pq->top_next(pq, &data));
+	TEST_ASSERT_EQUAL_PTR(&elems[2], data);
+	TEST_ASSERT_EQUAL_INT32(0, pq->back(pq, &data));
+	TEST_ASSERT_EQUAL_PTR(&big, data);
+
+	/* A smaller one stays on top */
+	TEST_ASSERT_EQUAL_INT32(0, pq->swap(pq, &small));
+	TEST_ASSERT_EQUAL_INT32(0, pq->top_next(pq, &data));
+	TEST_ASSERT_EQUAL_PTR(&small, data);
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_get_size(pq, &size));
+	TEST_ASSERT_EQUAL_UINT32(8, size);
+
+	TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &data));
+	TEST_ASSERT_EQUAL_PTR(&small, data);
+	for (i = 3; i <= 8; i++) {
+		TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &data));
+		top = data;
+		TEST_ASSERT_EQUAL_UINT32(i, top->key);
+	}
+	TEST_ASSERT_EQUAL_INT32(0, pq->pop(pq, &data));
+	TEST_ASSERT_EQUAL_PTR(&big, data);
+}
+
+void test_pqueue_capacity(void)
+{
+	struct no_os_list_desc *small_pq;
+	void *data;
+	uint32_t size;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_init(&small_pq, 4,
+				test_elem_cmp));
+
+	for (i = 0; i < 4; i++)
+		TEST_ASSERT_EQUAL_INT32(0, small_pq->push(small_pq, &elems[i]));
+
+	/* Full: the push fails and the queue is left untouched */
+	TEST_ASSERT_EQUAL_INT32(-1, small_pq->push(small_pq, &elems[4]));
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_get_size(small_pq, &size));
+	TEST_ASSERT_EQUAL_UINT32(4, size);
+
+	/* Room is available again once an element is popped */
+	TEST_ASSERT_EQUAL_INT32(0, small_pq->pop(small_pq, &data));
+	TEST_ASSERT_EQUAL_INT32(0, small_pq->push(small_pq, &elems[4]));
+	TEST_ASSERT_EQUAL_INT32(-1, small_pq->push(small_pq, &elems[5]));
+
+	for (i = 0; i < 4; i++)
+		TEST_ASSERT_EQUAL_INT32(0, small_pq->pop(small_pq, &data));
+	TEST_ASSERT_EQUAL_INT32(-1, small_pq->pop(small_pq, &data));
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_remove(small_pq));
+}
+
+void test_pqueue_find_matches_sorted_list(void)
+{
+	struct test_elem key;
+	void *from_pq, *from_list;
+	int i;
+
+	for (i = 0; i < TEST_NB_ELEMS; i++)
+		push_both(&elems[i]);
+
+	/* The first element of each key in pop order, as in the sorted list */
+	for (key.key = 0; key.key < 5; key.key++) {
+		TEST_ASSERT_EQUAL_INT32(0, no_os_list_read_find(list, &from_list,
+					&key));
+		TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_read_find(pq, &from_pq,
+					&key));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+
+	key.key = 5;
+	TEST_ASSERT_EQUAL_INT32(-1, no_os_pqueue_read_find(pq, &from_pq, &key));
+	TEST_ASSERT_NULL(from_pq);
+	TEST_ASSERT_EQUAL_INT32(-1, no_os_pqueue_get_find(pq, &from_pq, &key));
+	TEST_ASSERT_NULL(from_pq);
+
+	check_same_order();
+}
+
+void test_pqueue_get_find_keeps_order(void)
+{
+	struct test_elem key;
+	void *from_pq, *from_list;
+	uint32_t list_size, pq_size;
+	int i;
+
+	for (i = 0; i < TEST_NB_ELEMS; i++)
+		push_both(&elems[i]);
+
+	/* Remove from the middle of the heap, the rest still pops in order */
+	for (i = 0; i < TEST_NB_ELEMS / 2; i++) {
+		key.key = (i * 3) % 5;
+		if (no_os_list_get_find(list, &from_list, &key)) {
+			TEST_ASSERT_EQUAL_INT32(-1, no_os_pqueue_get_find(pq,
+						&from_pq, &key));
+			continue;
+		}
+		TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_get_find(pq, &from_pq,
+					&key));
+		TEST_ASSERT_EQUAL_PTR(from_list, from_pq);
+	}
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_list_get_size(list, &list_size));
+	TEST_ASSERT_EQUAL_INT32(0, no_os_pqueue_get_size(pq, &pq_size));
+	TEST_ASSERT_EQUAL_UINT32(list_size, pq_size);
+	check_same_order();
+}
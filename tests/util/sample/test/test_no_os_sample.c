@@ -0,0 +1,350 @@
+/***************************************************************************//**
+ *   @file   test_no_os_sample.c
+ *   @brief  Unit tests of the sample format conversion utilities.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+
+#include "unity.h"
+#include "no_os_sample.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_SAMPLES	67
+#define TEST_BUF_SIZE	(TEST_NB_SAMPLES * 4 + 16)
+
+static uint8_t test_buf[TEST_BUF_SIZE];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Storage word of sample n, read one bit or byte at a time. */
+static uint32_t ref_word(const struct no_os_sample_fmt *fmt,
+			 const uint8_t *raw, uint32_t n)
+{
+	uint32_t bytes = fmt->storagebits / 8;
+	uint32_t pos = n * fmt->storagebits;
+	uint32_t w = 0;
+	uint32_t i;
+
+	if (!(fmt->storagebits % 8) && !fmt->is_big_endian) {
+		for (i = bytes; i > 0; i--)
+			w = (w << 8) | raw[n * bytes + i - 1];
+		return w;
+	}
+
+	for (i = pos; i < pos + fmt->storagebits; i++)
+		w = (w << 1) | ((raw[i / 8] >> (7 - i % 8)) & 1);
+
+	return w;
+}
+
+static int32_t ref_sample(const struct no_os_sample_fmt *fmt,
+			  const uint8_t *raw, uint32_t n)
+{
+	uint64_t mask = (1ull << fmt->realbits) - 1;
+	uint64_t w = (ref_word(fmt, raw, n) >> fmt->shift) & mask;
+
+	if (fmt->is_signed && (w >> (fmt->realbits - 1)))
+		return (int32_t)(int64_t)(w - (1ull << fmt->realbits));
+
+	return (int32_t)w;
+}
+
+/* The 18 and 26 bit copies previously open coded in the ad7606 driver. */
+static void cpy18b32b(const uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < srcsz; i += 9) {
+		j = 4 * (i / 9);
+		pdst[j + 0] = ((uint32_t)psrc[i + 0] << 10) |
+			      ((uint32_t)psrc[i + 1] << 2) | (psrc[i + 2] >> 6);
+		pdst[j + 1] = ((uint32_t)(psrc[i + 2] & 0x3f) << 12) |
+			      ((uint32_t)psrc[i + 3] << 4) | (psrc[i + 4] >> 4);
+		pdst[j + 2] = ((uint32_t)(psrc[i + 4] & 0x0f) << 14) |
+			      ((uint32_t)psrc[i + 5] << 6) | (psrc[i + 6] >> 2);
+		pdst[j + 3] = ((uint32_t)(psrc[i + 6] & 0x03) << 16) |
+			      ((uint32_t)psrc[i + 7] << 8) | psrc[i + 8];
+	}
+}
+
+static void cpy26b32b(const uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < srcsz; i += 13) {
+		j = 4 * (i / 13);
+		pdst[j + 0] = ((uint32_t)psrc[i + 0] << 18) |
+			      ((uint32_t)psrc[i + 1] << 10) |
+			      ((uint32_t)psrc[i + 2] << 2) | (psrc[i + 3] >> 6);
+		pdst[j + 1] = ((uint32_t)(psrc[i + 3] & 0x3f) << 20) |
+			      ((uint32_t)psrc[i + 4] << 12) |
+			      ((uint32_t)psrc[i + 5] << 4) | (psrc[i + 6] >> 4);
+		pdst[j + 2] = ((uint32_t)(psrc[i + 6] & 0x0f) << 22) |
+			      ((uint32_t)psrc[i + 7] << 14) |
+			      ((uint32_t)psrc[i + 8] << 6) | (psrc[i + 9] >> 2);
+		pdst[j + 3] = ((uint32_t)(psrc[i + 9] & 0x03) << 24) |
+			      ((uint32_t)psrc[i + 10] << 16) |
+			      ((uint32_t)psrc[i + 11] << 8) | psrc[i + 12];
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 0x12345678;
+	int i;
+
+	for (i = 0; i < TEST_BUF_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		test_buf[i] = seed >> 16;
+	}
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+static void check_unpack32(const struct no_os_sample_fmt *fmt)
+{
+	int32_t out[TEST_NB_SAMPLES];
+	uint32_t nb, i;
+
+	/* Odd counts exercise the partial SIMD and bitstream tails */
+	for (nb = 0; nb <= TEST_NB_SAMPLES; nb += 11) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_sample_unpack32(fmt, test_buf,
+				      out, nb));
+		for (i = 0; i < nb; i++)
+			TEST_ASSERT_EQUAL_INT32(ref_sample(fmt, test_buf, i),
+						out[i]);
+	}
+}
+
+void test_unpack32_matches_reference(void)
+{
+	struct no_os_sample_fmt fmt;
+	uint8_t bits, real, variant;
+
+	for (bits = 1; bits <= 32; bits++) {
+		for (real = 1; real <= bits; real++) {
+			fmt.storagebits = bits;
+			fmt.realbits = real;
+			for (fmt.shift = 0; fmt.shift <= bits - real;
+			     fmt.shift++) {
+				for (variant = 0; variant < 4; variant++) {
+					fmt.is_signed = variant & 1;
+					fmt.is_big_endian = variant & 2;
+					check_unpack32(&fmt);
+				}
+			}
+		}
+	}
+}
+
+void test_unpack16_matches_reference(void)
+{
+	struct no_os_sample_fmt fmt = { .is_signed = true };
+	int16_t out[TEST_NB_SAMPLES];
+	uint32_t i;
+
+	for (fmt.storagebits = 1; fmt.storagebits <= 32; fmt.storagebits++) {
+		for (fmt.realbits = 1; fmt.realbits <= 16 &&
+		     fmt.realbits <= fmt.storagebits; fmt.realbits++) {
+			fmt.shift = fmt.storagebits - fmt.realbits;
+			TEST_ASSERT_EQUAL_INT(0, no_os_sample_unpack16(&fmt,
+					      test_buf, out, TEST_NB_SAMPLES));
+			for (i = 0; i < TEST_NB_SAMPLES; i++)
+				TEST_ASSERT_EQUAL_INT16(ref_sample(&fmt,
+								   test_buf, i),
+							out[i]);
+		}
+	}
+}
+
+void test_unpack32_ad7606(void)
+{
+	struct no_os_sample_fmt fmt = { .is_big_endian = true };
+	uint32_t expected[8];
+	int32_t out[8];
+
+	fmt.realbits = fmt.storagebits = 18;
+	cpy18b32b(test_buf, 18, expected);
+	TEST_ASSERT_EQUAL_INT(0, no_os_sample_unpack32(&fmt, test_buf, out, 8));
+	TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, out, 8);
+
+	fmt.realbits = fmt.storagebits = 26;
+	cpy26b32b(test_buf, 26, expected);
+	TEST_ASSERT_EQUAL_INT(0, no_os_sample_unpack32(&fmt, test_buf, out, 8));
+	TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, out, 8);
+}
+
+void test_pack_round_trip(void)
+{
+	struct no_os_sample_fmt fmt = { .is_signed = true };
+	uint8_t raw[TEST_BUF_SIZE];
+	int32_t out32[TEST_NB_SAMPLES];
+	int16_t out16[TEST_NB_SAMPLES];
+	uint32_t size, mask, i;
+
+	for (fmt.storagebits = 1; fmt.storagebits <= 32; fmt.storagebits++) {
+		fmt.realbits = fmt.storagebits > 2 ? fmt.storagebits - 2 : 1;
+		fmt.shift = fmt.storagebits - fmt.realbits;
+		fmt.is_big_endian = fmt.storagebits & 1;
+		mask = 0xFFFFFFFF >> (32 - fmt.realbits) << fmt.shift;
+		size = no_os_sample_raw_size(&fmt, TEST_NB_SAMPLES);
+
+		no_os_sample_unpack32(&fmt, test_buf, out32, TEST_NB_SAMPLES);
+		memset(raw, 0xA5, sizeof(raw));
+		TEST_ASSERT_EQUAL_INT(0, no_os_sample_pack32(&fmt, out32, raw,
+				      TEST_NB_SAMPLES));
+		/* Padding is cleared, nothing is written past the samples */
+		for (i = 0; i < TEST_NB_SAMPLES; i++)
+			TEST_ASSERT_EQUAL_HEX32(ref_word(&fmt, test_buf, i) &
+						mask, ref_word(&fmt, raw, i));
+		TEST_ASSERT_EQUAL_HEX8(0xA5, raw[size]);
+
+		if (fmt.realbits > 16)
+			continue;
+
+		no_os_sample_unpack16(&fmt, test_buf, out16, TEST_NB_SAMPLES);
+		memset(raw, 0xA5, sizeof(raw));
+		TEST_ASSERT_EQUAL_INT(0, no_os_sample_pack16(&fmt, out16, raw,
+				      TEST_NB_SAMPLES));
+		for (i = 0; i < TEST_NB_SAMPLES; i++)
+			TEST_ASSERT_EQUAL_HEX32(ref_word(&fmt, test_buf, i) &
+						mask, ref_word(&fmt, raw, i));
+	}
+}
+
+void test_invalid_formats(void)
+{
+	struct no_os_sample_fmt fmt = { 12, 16, 4, true, true };
+	int32_t out32[1];
+	int16_t out16[1];
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_unpack32(NULL, test_buf,
+			      out32, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_unpack32(&fmt, NULL,
+			      out32, 1));
+	fmt.shift = 5;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_unpack32(&fmt, test_buf,
+			      out32, 1));
+	fmt.shift = 0;
+	fmt.realbits = 0;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_pack32(&fmt, out32,
+			      test_buf, 1));
+	fmt.realbits = 20;
+	fmt.storagebits = 24;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_unpack16(&fmt, test_buf,
+			      out16, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_pack16(&fmt, out16,
+			      test_buf, 1));
+	fmt.storagebits = 40;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_sample_unpack32(&fmt, test_buf,
+			      out32, 1));
+}
+
+void test_sign_extend32(void)
+{
+	int32_t buf[] = { 0x7FFFF, 0x80000, 0xFFFFF, 3 };
+	int32_t expected[] = { 0x7FFFF, -0x80000, -1, 3 };
+
+	no_os_sample_sign_extend32(buf, NO_OS_ARRAY_SIZE(buf), 20);
+
+	TEST_ASSERT_EQUAL_INT32_ARRAY(expected, buf, NO_OS_ARRAY_SIZE(buf));
+}
+
+void test_swap(void)
+{
+	uint8_t buf[TEST_BUF_SIZE];
+	uint32_t nb, i;
+
+	/* Unaligned buffers, with and without a tail after the SIMD blocks */
+	for (nb = 0; nb < 20; nb++) {
+		memcpy(buf, test_buf, sizeof(buf));
+		no_os_sample_swap16(buf + 1, nb);
+		for (i = 0; i < 2 * nb; i++)
+			TEST_ASSERT_EQUAL_HEX8(test_buf[1 + (i ^ 1)],
+					       buf[1 + i]);
+
+		memcpy(buf, test_buf, sizeof(buf));
+		no_os_sample_swap32(buf + 3, nb);
+		for (i = 0; i < 4 * nb; i++)
+			TEST_ASSERT_EQUAL_HEX8(test_buf[3 + (i ^ 3)],
+					       buf[3 + i]);
+
+		memcpy(buf, test_buf, sizeof(buf));
+		no_os_sample_swap64(buf + 5, nb);
+		for (i = 0; i < 8 * nb; i++)
+			TEST_ASSERT_EQUAL_HEX8(test_buf[5 + (i ^ 7)],
+					       buf[5 + i]);
+		TEST_ASSERT_EQUAL_HEX8_ARRAY(test_buf + 5 + 8 * nb,
+					     buf + 5 + 8 * nb,
+					     sizeof(buf) - 5 - 8 * nb);
+	}
+}
+
+void test_memswap64(void)
+{
+	uint8_t buf[TEST_BUF_SIZE];
+	uint32_t step, i;
+
+	for (step = 2; step <= 8; step++) {
+		memcpy(buf, test_buf, sizeof(buf));
+		no_os_memswap64(buf + 1, 8 * step, step);
+		for (i = 0; i < 8 * step; i++)
+			TEST_ASSERT_EQUAL_HEX8(test_buf[1 + i - i % step +
+							step - 1 - i % step],
+					       buf[1 + i]);
+	}
+}
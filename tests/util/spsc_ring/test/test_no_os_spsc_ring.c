@@ -0,0 +1,313 @@
+/***************************************************************************//**
+ *   @file   test_no_os_spsc_ring.c
+ *   @brief  Unit tests of the single producer, single consumer ring.
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_ELEMS	8
+
+static uint16_t test_storage[TEST_NB_ELEMS];
+static struct no_os_spsc_ring test_ring;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Write nb consecutive values starting at first. */
+static uint32_t write_seq(uint16_t first, uint32_t nb)
+{
+	uint16_t data[2 * TEST_NB_ELEMS];
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		data[i] = first + i;
+
+	return no_os_spsc_ring_write(&test_ring, data, nb);
+}
+
+/* Read nb values and check they are consecutive starting at first. */
+static void read_seq(uint16_t first, uint32_t nb)
+{
+	uint16_t data[2 * TEST_NB_ELEMS];
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_UINT32(nb, no_os_spsc_ring_read(&test_ring, data, nb));
+	for (i = 0; i < nb; i++)
+		TEST_ASSERT_EQUAL_UINT16(first + i, data[i]);
+}
+
+/* Move both counters to start, as after start elements went through. */
+static void set_position(uint32_t start)
+{
+	test_ring.head = start;
+	test_ring.tail = start;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(test_storage, 0, sizeof(test_storage));
+	TEST_ASSERT_EQUAL_INT32(0, no_os_spsc_ring_cfg(&test_ring, test_storage,
+				sizeof(test_storage[0]),
+				TEST_NB_ELEMS));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_cfg_invalid(void)
+{
+	struct no_os_spsc_ring ring;
+
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_cfg(NULL, test_storage,
+				2, 8));
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_cfg(&ring, NULL, 2, 8));
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_cfg(&ring, test_storage,
+				0, 8));
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_cfg(&ring, test_storage,
+				2, 0));
+	/* Positions are found by masking, so the size must be a power of 2 */
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_cfg(&ring, test_storage,
+				2, 6));
+}
+
+void test_init_rounds_up(void)
+{
+	struct no_os_spsc_ring *ring;
+
+	TEST_ASSERT_EQUAL_INT32(0, no_os_spsc_ring_init(&ring, 3, 5));
+	TEST_ASSERT_EQUAL_UINT32(8, no_os_spsc_ring_capacity(ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(ring));
+	TEST_ASSERT_EQUAL_UINT32(8, no_os_spsc_ring_avail(ring));
+	no_os_spsc_ring_remove(ring);
+
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_init(&ring, 1,
+				0x80000001u));
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, no_os_spsc_ring_init(&ring, 4,
+				0x40000000u));
+}
+
+void test_empty(void)
+{
+	uint16_t data[TEST_NB_ELEMS];
+	void *addr;
+
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS, no_os_spsc_ring_avail(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_read(&test_ring, data, 1));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_peek(&test_ring,
+				 TEST_NB_ELEMS, &addr));
+
+	/* Emptied again by reading back the last element */
+	TEST_ASSERT_EQUAL_UINT32(1, write_seq(7, 1));
+	TEST_ASSERT_EQUAL_UINT32(1, no_os_spsc_ring_used(&test_ring));
+	read_seq(7, 1);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_read(&test_ring, data, 1));
+}
+
+void test_full(void)
+{
+	void *addr;
+
+	/* Every element is usable, no slot is kept free to tell full from empty */
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS - 1,
+				 write_seq(0, TEST_NB_ELEMS - 1));
+	TEST_ASSERT_EQUAL_UINT32(1, no_os_spsc_ring_avail(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(1, write_seq(TEST_NB_ELEMS - 1, 2));
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_avail(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(0, write_seq(100, 1));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_reserve(&test_ring, 1,
+				 &addr));
+
+	/* Reading one element makes room for exactly one */
+	read_seq(0, 1);
+	TEST_ASSERT_EQUAL_UINT32(1, no_os_spsc_ring_avail(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(1, write_seq(TEST_NB_ELEMS, 2));
+	read_seq(1, TEST_NB_ELEMS);
+}
+
+void test_wraparound(void)
+{
+	uint32_t start;
+
+	/* Copies split at the end of the buffer, in both directions */
+	TEST_ASSERT_EQUAL_UINT32(5, write_seq(0, 5));
+	read_seq(0, 5);
+	TEST_ASSERT_EQUAL_UINT32(6, write_seq(5, 6));
+	TEST_ASSERT_EQUAL_UINT16(8, test_storage[0]);
+	read_seq(5, 6);
+
+	/* The free running counters overflow in the middle of a copy */
+	for (start = UINT32_MAX - 2; start != 3; start++) {
+		setUp();
+		set_position(start);
+		TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS,
+					 write_seq(start, TEST_NB_ELEMS));
+		TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS,
+					 no_os_spsc_ring_used(&test_ring));
+		TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_avail(&test_ring));
+		read_seq(start, 3);
+		TEST_ASSERT_EQUAL_UINT32(3, write_seq(start + TEST_NB_ELEMS, 3));
+		read_seq(start + 3, TEST_NB_ELEMS);
+		TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+	}
+}
+
+void test_reserve_commit(void)
+{
+	uint16_t *region;
+	void *addr;
+	uint32_t nb;
+
+	set_position(5);
+
+	/* The region stops at the end of the buffer */
+	nb = no_os_spsc_ring_reserve(&test_ring, TEST_NB_ELEMS, &addr);
+	TEST_ASSERT_EQUAL_UINT32(3, nb);
+	TEST_ASSERT_EQUAL_PTR(&test_storage[5], addr);
+	region = addr;
+	region[0] = 10;
+	region[1] = 11;
+	region[2] = 12;
+
+	/* Nothing is visible to the consumer before the commit */
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+	no_os_spsc_ring_commit(&test_ring, nb);
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_spsc_ring_used(&test_ring));
+
+	/* The next region restarts at the beginning, up to the free space */
+	nb = no_os_spsc_ring_reserve(&test_ring, TEST_NB_ELEMS, &addr);
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS - 3, nb);
+	TEST_ASSERT_EQUAL_PTR(&test_storage[0], addr);
+
+	/* Less than reserved may be committed */
+	region = addr;
+	region[0] = 13;
+	no_os_spsc_ring_commit(&test_ring, 1);
+	TEST_ASSERT_EQUAL_UINT32(4, no_os_spsc_ring_used(&test_ring));
+	read_seq(10, 4);
+
+	/* A reservation never exceeds the request */
+	TEST_ASSERT_EQUAL_UINT32(2, no_os_spsc_ring_reserve(&test_ring, 2,
+				 &addr));
+	TEST_ASSERT_EQUAL_PTR(&test_storage[1], addr);
+}
+
+void test_peek_release(void)
+{
+	uint16_t *region;
+	void *addr;
+	uint32_t nb;
+
+	set_position(6);
+	TEST_ASSERT_EQUAL_UINT32(5, write_seq(20, 5));
+
+	/* The region stops at the end of the buffer */
+	nb = no_os_spsc_ring_peek(&test_ring, TEST_NB_ELEMS, &addr);
+	TEST_ASSERT_EQUAL_UINT32(2, nb);
+	TEST_ASSERT_EQUAL_PTR(&test_storage[6], addr);
+	region = addr;
+	TEST_ASSERT_EQUAL_UINT16(20, region[0]);
+	TEST_ASSERT_EQUAL_UINT16(21, region[1]);
+
+	/* Peeked elements stay in the ring until released */
+	TEST_ASSERT_EQUAL_UINT32(5, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_spsc_ring_avail(&test_ring));
+	no_os_spsc_ring_release(&test_ring, 1);
+	TEST_ASSERT_EQUAL_UINT32(4, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(4, no_os_spsc_ring_avail(&test_ring));
+
+	nb = no_os_spsc_ring_peek(&test_ring, TEST_NB_ELEMS, &addr);
+	TEST_ASSERT_EQUAL_UINT32(1, nb);
+	TEST_ASSERT_EQUAL_PTR(&test_storage[7], addr);
+	no_os_spsc_ring_release(&test_ring, nb);
+
+	/* The rest restarts at the beginning of the buffer */
+	nb = no_os_spsc_ring_peek(&test_ring, TEST_NB_ELEMS, &addr);
+	TEST_ASSERT_EQUAL_UINT32(3, nb);
+	TEST_ASSERT_EQUAL_PTR(&test_storage[0], addr);
+	region = addr;
+	TEST_ASSERT_EQUAL_UINT16(22, region[0]);
+	TEST_ASSERT_EQUAL_UINT16(24, region[2]);
+	no_os_spsc_ring_release(&test_ring, nb);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+}
+
+void test_flush_reset(void)
+{
+	void *addr;
+
+	set_position(6);
+	TEST_ASSERT_EQUAL_UINT32(4, write_seq(30, 4));
+
+	no_os_spsc_ring_flush(&test_ring);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_used(&test_ring));
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS, no_os_spsc_ring_avail(&test_ring));
+
+	/* After a flush the free space still wraps, after a reset it does not */
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS - 2,
+				 no_os_spsc_ring_reserve(&test_ring, TEST_NB_ELEMS,
+						 &addr));
+	no_os_spsc_ring_reset(&test_ring);
+	TEST_ASSERT_EQUAL_UINT32(TEST_NB_ELEMS,
+				 no_os_spsc_ring_reserve(&test_ring, TEST_NB_ELEMS,
+						 &addr));
+	TEST_ASSERT_EQUAL_PTR(&test_storage[0], addr);
+}
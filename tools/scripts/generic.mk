@@ -174,6 +174,26 @@ ifeq (y,$(strip $(DISABLE_SECURE_SOCKET)))
 CFLAGS += -DDISABLE_SECURE_SOCKET
 endif
 
+# Serve no_os_malloc/no_os_calloc from fixed block pools, see no_os_pool.h
+ifeq (y,$(strip $(ALLOC_POOL)))
+CFLAGS += -DNO_OS_ALLOC_POOL
+SRCS += $(NO-OS)/util/no_os_pool.c
+INCS += $(INCLUDE)/no_os_pool.h
+endif
+
+# no_os_memswap64() swaps the power of 2 steps through no_os_sample
+ifneq (,$(filter %/no_os_util.c,$(SRCS)))
+SRCS += $(NO-OS)/util/no_os_sample.c
+INCS += $(INCLUDE)/no_os_sample.h
+endif
+
+# no_os_spi_xfer_wait() sleeps on a semaphore, weak no-op unless provided by
+# the platform
+ifneq (,$(filter %/no_os_spi.c,$(SRCS)))
+SRCS += $(NO-OS)/util/no_os_semaphore.c
+INCS += $(INCLUDE)/no_os_semaphore.h
+endif
+
 SRC_DIRS := $(patsubst %/,%,$(SRC_DIRS))
 
 # Get all .c, .cpp and .h files from SRC_DIRS
@@ -189,6 +209,22 @@ ALL_IGNORED_FILES += $(foreach dir, $(IGNORED_FILES), $(call rwildcard, $(dir),*
 SRCS     := $(filter-out $(ALL_IGNORED_FILES),$(SRCS))
 INCS     := $(filter-out $(ALL_IGNORED_FILES),$(INCS))
 
+# The SPI transfer queue and the pools share their state with interrupt
+# handlers through critical sections. util/no_os_critical.c only covers the
+# Cortex-M cores, the other platforms provide their own. Checked once SRC_DIRS
+# are expanded, so that pools built from a util SRC_DIRS are covered too.
+ifneq (,$(filter linux xilinx altera,$(strip $(PLATFORM))))
+SRCS     := $(filter-out %/util/no_os_critical.c,$(SRCS))
+endif
+ifneq (,$(filter %/no_os_spi.c %/no_os_pool.c,$(SRCS)))
+INCS     += $(INCLUDE)/no_os_critical.h
+ifneq (,$(filter linux xilinx altera,$(strip $(PLATFORM))))
+SRCS     += $(DRIVERS)/platform/$(strip $(PLATFORM))/$(strip $(PLATFORM))_critical.c
+else
+SRCS     += $(NO-OS)/util/no_os_critical.c
+endif
+endif
+
 # Get all src files that are not in SRC_DRIS
 FILES_OUT_OF_DIRS := $(filter-out $(foreach source_directory_name,$(sort $(SRC_DIRS)),$(wildcard $(source_directory_name)/*)),$(SRCS) $(INCS))
 
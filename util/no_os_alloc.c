@@ -39,6 +39,106 @@
 
 #include "no_os_alloc.h"
 
+#ifdef NO_OS_ALLOC_POOL
+
+#include "no_os_util.h"
+
+/*
+ * Number of blocks of each size class. Each one can be overridden from the
+ * build and must be at least 1.
+ */
+#ifndef NO_OS_ALLOC_POOL_NB_16
+#define NO_OS_ALLOC_POOL_NB_16		32
+#endif
+#ifndef NO_OS_ALLOC_POOL_NB_32
+#define NO_OS_ALLOC_POOL_NB_32		32
+#endif
+#ifndef NO_OS_ALLOC_POOL_NB_64
+#define NO_OS_ALLOC_POOL_NB_64		16
+#endif
+#ifndef NO_OS_ALLOC_POOL_NB_128
+#define NO_OS_ALLOC_POOL_NB_128		16
+#endif
+#ifndef NO_OS_ALLOC_POOL_NB_256
+#define NO_OS_ALLOC_POOL_NB_256		8
+#endif
+#ifndef NO_OS_ALLOC_POOL_NB_512
+#define NO_OS_ALLOC_POOL_NB_512		4
+#endif
+
+/* Serve requests larger than 512 bytes, or not fitting anymore, from the heap */
+#ifndef NO_OS_ALLOC_POOL_HEAP_FALLBACK
+#define NO_OS_ALLOC_POOL_HEAP_FALLBACK	1
+#endif
+
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_16, 16, NO_OS_ALLOC_POOL_NB_16);
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_32, 32, NO_OS_ALLOC_POOL_NB_32);
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_64, 64, NO_OS_ALLOC_POOL_NB_64);
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_128, 128, NO_OS_ALLOC_POOL_NB_128);
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_256, 256, NO_OS_ALLOC_POOL_NB_256);
+NO_OS_DECLARE_POOL_MEM(no_os_alloc_mem_512, 512, NO_OS_ALLOC_POOL_NB_512);
+
+static struct no_os_pool no_os_alloc_pools[] = {
+	NO_OS_POOL_INIT(no_os_alloc_mem_16, 16, NO_OS_ALLOC_POOL_NB_16),
+	NO_OS_POOL_INIT(no_os_alloc_mem_32, 32, NO_OS_ALLOC_POOL_NB_32),
+	NO_OS_POOL_INIT(no_os_alloc_mem_64, 64, NO_OS_ALLOC_POOL_NB_64),
+	NO_OS_POOL_INIT(no_os_alloc_mem_128, 128, NO_OS_ALLOC_POOL_NB_128),
+	NO_OS_POOL_INIT(no_os_alloc_mem_256, 256, NO_OS_ALLOC_POOL_NB_256),
+	NO_OS_POOL_INIT(no_os_alloc_mem_512, 512, NO_OS_ALLOC_POOL_NB_512),
+};
+
+static struct no_os_arena no_os_alloc_arena = {
+	.name = "no_os_alloc",
+	.pools = no_os_alloc_pools,
+	.nb_pools = NO_OS_ARRAY_SIZE(no_os_alloc_pools),
+	.heap_fallback = NO_OS_ALLOC_POOL_HEAP_FALLBACK,
+};
+
+/**
+ * @brief Get the arena backing no_os_malloc(), no_os_calloc() and
+ * 	  no_os_free(), e.g. to read its usage statistics.
+ * @return The arena.
+ */
+struct no_os_arena *no_os_alloc_get_arena(void)
+{
+	return &no_os_alloc_arena;
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_malloc(size_t size)
+{
+	return no_os_arena_alloc(&no_os_alloc_arena, size);
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it, set memory to 0.
+ * @param nitems - Number of elements to be allocated.
+ * @param size - Size of elements.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_calloc(size_t nitems, size_t size)
+{
+	return no_os_arena_calloc(&no_os_alloc_arena, nitems, size);
+}
+
+/**
+ * @brief Deallocate memory previously allocated by a call to no_os_calloc
+ * 		  or no_os_malloc.
+ * @param ptr - Pointer to a memory block previously allocated by a call
+ * 		  to no_os_calloc or no_os_malloc.
+ * @return None.
+ */
+__attribute__((weak)) void no_os_free(void *ptr)
+{
+	no_os_arena_free(&no_os_alloc_arena, ptr);
+}
+
+#else
+
 /**
  * @brief Allocate memory and return a pointer to it.
  * @param size - Size of the memory block, in bytes.
@@ -71,3 +171,5 @@ __attribute__((weak)) void no_os_free(void *ptr)
 {
 	free(ptr);
 }
+
+#endif
@@ -0,0 +1,369 @@
+/***************************************************************************//**
+ *   @file   no_os_crc.c
+ *   @brief  Source file of the generic table driven CRC engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_crc.h"
+#include "no_os_alloc.h"
+
+/***************************************************************************//**
+ * @brief Reflect the lower width bits of a value.
+ *
+ * @param val   - Value to reflect.
+ * @param width - Number of bits to reflect.
+ *
+ * @return The reflected value.
+*******************************************************************************/
+static uint32_t no_os_crc_reflect(uint32_t val, uint8_t width)
+{
+	uint32_t ret = 0;
+	uint8_t i;
+
+	for (i = 0; i < width; i++) {
+		ret = (ret << 1) | (val & 1);
+		val >>= 1;
+	}
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Read a little endian 32 bit word from an unaligned buffer.
+ *
+ * @param buf - Data buffer.
+ *
+ * @return The word.
+*******************************************************************************/
+static inline uint32_t no_os_crc_get_le32(const uint8_t *buf)
+{
+	return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+	       ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/***************************************************************************//**
+ * @brief Read a big endian 32 bit word from an unaligned buffer.
+ *
+ * @param buf - Data buffer.
+ *
+ * @return The word.
+*******************************************************************************/
+static inline uint32_t no_os_crc_get_be32(const uint8_t *buf)
+{
+	return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+	       ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
+
+/***************************************************************************//**
+ * @brief Get the mask of a CRC of the given width.
+ *
+ * @param width - CRC width in bits.
+ *
+ * @return The mask.
+*******************************************************************************/
+static uint32_t no_os_crc_mask(uint8_t width)
+{
+	return 0xffffffff >> (32 - width);
+}
+
+/***************************************************************************//**
+ * @brief Creates the lookup tables of a CRC algorithm.
+ *
+ * Msb-first algorithms keep the register left-aligned on 32 bits so that the
+ * same update loop works for any width; lsb-first ones keep it right-aligned.
+ * Table 0 is the usual byte table, table k holds the effect of a byte followed
+ * by k zero bytes, which lets the update fold 4 or 8 bytes per round.
+ *
+ * @param table - Storage for slice * NO_OS_CRC_TABLE_SIZE entries.
+ * @param param - CRC algorithm.
+ * @param slice - Number of tables to generate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int no_os_crc_populate(uint32_t *table, const struct no_os_crc_param *param,
+		       enum no_os_crc_slice slice)
+{
+	uint32_t poly, crc;
+	uint32_t *prev;
+	uint32_t n;
+	uint8_t k, bit;
+
+	if (!table || !param || !param->width || param->width > 32)
+		return -EINVAL;
+
+	if (slice != NO_OS_CRC_SLICE_BY_1 && slice != NO_OS_CRC_SLICE_BY_4 &&
+	    slice != NO_OS_CRC_SLICE_BY_8)
+		return -EINVAL;
+
+	poly = param->poly & no_os_crc_mask(param->width);
+	if (param->reflect)
+		poly = no_os_crc_reflect(poly, param->width);
+	else
+		poly <<= 32 - param->width;
+
+	for (n = 0; n < NO_OS_CRC_TABLE_SIZE; n++) {
+		if (param->reflect) {
+			crc = n;
+			for (bit = 0; bit < 8; bit++)
+				crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+		} else {
+			crc = n << 24;
+			for (bit = 0; bit < 8; bit++)
+				crc = (crc & 0x80000000) ?
+				      (crc << 1) ^ poly : crc << 1;
+		}
+		table[n] = crc;
+	}
+
+	for (k = 1; k < slice; k++) {
+		prev = &table[(k - 1) * NO_OS_CRC_TABLE_SIZE];
+		for (n = 0; n < NO_OS_CRC_TABLE_SIZE; n++) {
+			crc = prev[n];
+			if (param->reflect)
+				crc = (crc >> 8) ^ table[crc & 0xff];
+			else
+				crc = (crc << 8) ^ table[crc >> 24];
+			table[k * NO_OS_CRC_TABLE_SIZE + n] = crc;
+		}
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Allocate a CRC engine and generate its lookup tables.
+ *
+ * @param desc  - The CRC engine descriptor.
+ * @param param - CRC algorithm.
+ * @param slice - Number of bytes folded per lookup round. Slice by 4 and 8
+ *                trade 4KiB and 8KiB of tables for fewer dependent lookups per
+ *                byte and are meant for long buffers.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int no_os_crc_init(struct no_os_crc_desc **desc,
+		   const struct no_os_crc_param *param,
+		   enum no_os_crc_slice slice)
+{
+	struct no_os_crc_desc *descriptor;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->table = no_os_calloc(slice * NO_OS_CRC_TABLE_SIZE,
+					 sizeof(*descriptor->table));
+	if (!descriptor->table) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ret = no_os_crc_populate(descriptor->table, param, slice);
+	if (ret)
+		goto free_table;
+
+	descriptor->param = *param;
+	descriptor->slice = slice;
+	*desc = descriptor;
+
+	return 0;
+
+free_table:
+	no_os_free(descriptor->table);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Free the resources allocated by no_os_crc_init().
+ *
+ * @param desc - The CRC engine descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int no_os_crc_remove(struct no_os_crc_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->table);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Get the register value a new computation starts from.
+ *
+ * @param desc - The CRC engine descriptor.
+ *
+ * @return The initial register value, to be passed to no_os_crc_update().
+*******************************************************************************/
+uint32_t no_os_crc_start(const struct no_os_crc_desc *desc)
+{
+	uint32_t init = desc->param.init & no_os_crc_mask(desc->param.width);
+
+	if (desc->param.reflect)
+		return no_os_crc_reflect(init, desc->param.width);
+
+	return init << (32 - desc->param.width);
+}
+
+/***************************************************************************//**
+ * @brief Fold a buffer into the CRC register.
+ *
+ * @param desc   - The CRC engine descriptor.
+ * @param reg    - Register value returned by no_os_crc_start() or by a previous
+ *                 call of this function, which allows cascading calls.
+ * @param pdata  - Pointer to data buffer.
+ * @param nbytes - Number of bytes to fold.
+ *
+ * @return The updated register value.
+*******************************************************************************/
+uint32_t no_os_crc_update(const struct no_os_crc_desc *desc, uint32_t reg,
+			  const uint8_t *pdata, size_t nbytes)
+{
+	const uint32_t *t[NO_OS_CRC_SLICE_BY_8];
+	uint8_t k;
+
+	for (k = 0; k < desc->slice; k++)
+		t[k] = &desc->table[k * NO_OS_CRC_TABLE_SIZE];
+
+	if (desc->param.reflect) {
+		if (desc->slice == NO_OS_CRC_SLICE_BY_8) {
+			while (nbytes >= 8) {
+				reg ^= no_os_crc_get_le32(pdata);
+				reg = t[7][reg & 0xff] ^
+				      t[6][(reg >> 8) & 0xff] ^
+				      t[5][(reg >> 16) & 0xff] ^
+				      t[4][reg >> 24] ^
+				      t[3][pdata[4]] ^ t[2][pdata[5]] ^
+				      t[1][pdata[6]] ^ t[0][pdata[7]];
+				pdata += 8;
+				nbytes -= 8;
+			}
+		}
+
+		if (desc->slice >= NO_OS_CRC_SLICE_BY_4) {
+			while (nbytes >= 4) {
+				reg ^= no_os_crc_get_le32(pdata);
+				reg = t[3][reg & 0xff] ^
+				      t[2][(reg >> 8) & 0xff] ^
+				      t[1][(reg >> 16) & 0xff] ^
+				      t[0][reg >> 24];
+				pdata += 4;
+				nbytes -= 4;
+			}
+		}
+
+		while (nbytes--)
+			reg = (reg >> 8) ^ t[0][(reg ^ *pdata++) & 0xff];
+
+		return reg;
+	}
+
+	if (desc->slice == NO_OS_CRC_SLICE_BY_8) {
+		while (nbytes >= 8) {
+			reg ^= no_os_crc_get_be32(pdata);
+			reg = t[7][reg >> 24] ^
+			      t[6][(reg >> 16) & 0xff] ^
+			      t[5][(reg >> 8) & 0xff] ^
+			      t[4][reg & 0xff] ^
+			      t[3][pdata[4]] ^ t[2][pdata[5]] ^
+			      t[1][pdata[6]] ^ t[0][pdata[7]];
+			pdata += 8;
+			nbytes -= 8;
+		}
+	}
+
+	if (desc->slice >= NO_OS_CRC_SLICE_BY_4) {
+		while (nbytes >= 4) {
+			reg ^= no_os_crc_get_be32(pdata);
+			reg = t[3][reg >> 24] ^
+			      t[2][(reg >> 16) & 0xff] ^
+			      t[1][(reg >> 8) & 0xff] ^
+			      t[0][reg & 0xff];
+			pdata += 4;
+			nbytes -= 4;
+		}
+	}
+
+	while (nbytes--)
+		reg = (reg << 8) ^ t[0][(reg >> 24) ^ *pdata++];
+
+	return reg;
+}
+
+/***************************************************************************//**
+ * @brief Convert the CRC register value to the CRC.
+ *
+ * @param desc - The CRC engine descriptor.
+ * @param reg  - Register value returned by no_os_crc_update().
+ *
+ * @return The CRC value.
+*******************************************************************************/
+uint32_t no_os_crc_finish(const struct no_os_crc_desc *desc, uint32_t reg)
+{
+	if (!desc->param.reflect)
+		reg >>= 32 - desc->param.width;
+
+	return (reg ^ desc->param.xor_out) & no_os_crc_mask(desc->param.width);
+}
+
+/***************************************************************************//**
+ * @brief Compute the CRC of a buffer.
+ *
+ * @param desc   - The CRC engine descriptor.
+ * @param pdata  - Pointer to data buffer.
+ * @param nbytes - Number of bytes to compute the CRC over.
+ *
+ * @return The CRC value.
+*******************************************************************************/
+uint32_t no_os_crc_compute(const struct no_os_crc_desc *desc,
+			   const uint8_t *pdata, size_t nbytes)
+{
+	uint32_t reg;
+
+	reg = no_os_crc_start(desc);
+	reg = no_os_crc_update(desc, reg, pdata, nbytes);
+
+	return no_os_crc_finish(desc, reg);
+}
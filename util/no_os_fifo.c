@@ -42,6 +42,7 @@
 /******************************************************************************/
 
 #include <string.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "no_os_fifo.h"
 #include "no_os_error.h"
@@ -52,48 +53,35 @@
 /******************************************************************************/
 
 /**
- * @brief Create new fifo element
+ * @brief Create new fifo element. The data is stored right after the element,
+ * so that both take a single allocation.
  * @param buff - Data to be saved in fifo.
  * @param len - Length of the data.
  * @return fifo element in case of success, NULL otherwise
  */
 static struct no_os_fifo_element * fifo_new_element(char *buff, uint32_t len)
 {
-	struct no_os_fifo_element *q = no_os_calloc(1,
-				       sizeof(struct no_os_fifo_element));
+	struct no_os_fifo_element *q;
+
+	if (len > UINT32_MAX - sizeof(*q))
+		return NULL;
+
+	q = no_os_malloc(sizeof(*q) + len);
 	if (!q)
 		return NULL;
 
+	q->next = NULL;
+	q->last = q;
 	q->len = len;
-	q->data = no_os_calloc(1, len);
-	if (!(q->data)) {
-		no_os_free(q);
-		return NULL;
-	}
+	q->data = (char *)(q + 1);
 	memcpy(q->data, buff, len);
 
 	return q;
 }
 
 /**
- * @brief Get last element in fifo
- * @param p_fifo - pointer to fifo
- * @return fifo last element if exists, NULL otherwise
- */
-static struct no_os_fifo_element *no_os_fifo_get_last(struct no_os_fifo_element
-		*p_fifo)
-{
-	if(p_fifo == NULL)
-		return NULL;
-	while (p_fifo->next) {
-		p_fifo = p_fifo->next;
-	}
-
-	return p_fifo;
-}
-
-/**
- * @brief Insert element to fifo, in the last position.
+ * @brief Insert element to fifo, in the last position. The head element keeps
+ * track of the last one, so no walk through the fifo is needed.
  * @param p_fifo - Pointer to fifo.
  * @param buff - Data to be saved in fifo.
  * @param len - Length of the data.
@@ -102,7 +90,7 @@ static struct no_os_fifo_element *no_os_fifo_get_last(struct no_os_fifo_element
 int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
 			  uint32_t len)
 {
-	struct no_os_fifo_element *p, *q;
+	struct no_os_fifo_element *q;
 
 	if (len <= 0)
 		return -1;
@@ -114,8 +102,8 @@ int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
 	if (!(*p_fifo)) {
 		*p_fifo = q;
 	} else {
-		p = no_os_fifo_get_last(*p_fifo);
-		p->next = q;
+		(*p_fifo)->last->next = q;
+		(*p_fifo)->last = q;
 	}
 
 	return 0;
@@ -132,7 +120,8 @@ struct no_os_fifo_element * no_os_fifo_remove(struct no_os_fifo_element *p_fifo)
 
 	if (p_fifo != NULL) {
 		p_fifo = p_fifo->next;
-		no_os_free(p->data);
+		if (p_fifo)
+			p_fifo->last = p->last;
 		no_os_free(p);
 	}
 
@@ -93,6 +93,61 @@ struct _list_desc {
 	struct no_os_iterator		l_it;
 };
 
+#ifdef NO_OS_ALLOC_POOL
+
+#ifndef NO_OS_LIST_POOL_NB_ELEMS
+#define NO_OS_LIST_POOL_NB_ELEMS	64
+#endif
+
+NO_OS_DECLARE_POOL_MEM(no_os_list_elem_mem, sizeof(struct no_os_list_elem),
+		       NO_OS_LIST_POOL_NB_ELEMS);
+
+static struct no_os_pool no_os_list_elem_pool =
+	NO_OS_POOL_INIT(no_os_list_elem_mem, sizeof(struct no_os_list_elem),
+			NO_OS_LIST_POOL_NB_ELEMS);
+
+/* List elements get their own arena, inserts do not compete with other users */
+static struct no_os_arena no_os_list_arena = {
+	.name = "no_os_list",
+	.pools = &no_os_list_elem_pool,
+	.nb_pools = 1,
+	.heap_fallback = true,
+};
+
+/**
+ * @brief Get the arena list elements are allocated from.
+ * @return The arena.
+ */
+struct no_os_arena *no_os_list_get_arena(void)
+{
+	return &no_os_list_arena;
+}
+
+static inline struct no_os_list_elem *alloc_element(void)
+{
+	return no_os_arena_alloc(&no_os_list_arena,
+				 sizeof(struct no_os_list_elem));
+}
+
+static inline void free_element(struct no_os_list_elem *elem)
+{
+	no_os_arena_free(&no_os_list_arena, elem);
+}
+
+#else
+
+static inline struct no_os_list_elem *alloc_element(void)
+{
+	return no_os_malloc(sizeof(struct no_os_list_elem));
+}
+
+static inline void free_element(struct no_os_list_elem *elem)
+{
+	no_os_free(elem);
+}
+
+#endif
+
 /** @brief Default function used to compare element in the list ( \ref f_cmp) */
 static int32_t no_os_default_comparator(void *data1, void *data2)
 {
@@ -112,7 +167,7 @@ static inline struct no_os_list_elem *create_element(void *data,
 {
 	struct no_os_list_elem *elem;
 
-	elem = (struct no_os_list_elem *)no_os_calloc(1, sizeof(*elem));
+	elem = alloc_element();
 	if (!elem)
 		return NULL;
 	elem->data = data;
@@ -566,7 +621,7 @@ int32_t no_os_list_get_first(struct no_os_list_desc *list_desc, void **data)
 	list->nb_elements--;
 
 	*data = elem->data;
-	no_os_free(elem);
+	free_element(elem);
 
 	return 0;
 }
@@ -596,7 +651,7 @@ int32_t no_os_list_get_last(struct no_os_list_desc *list_desc, void **data)
 	list->nb_elements--;
 
 	*data = elem->data;
-	no_os_free(elem);
+	free_element(elem);
 
 	return 0;
 }
@@ -826,7 +881,7 @@ int32_t no_os_iterator_get(struct no_os_iterator *iter, void **data)
 		next = it->elem->prev;
 	else
 		next = it->elem->next;
-	no_os_free(it->elem);
+	free_element(it->elem);
 	it->elem = next;
 
 	return 0;
@@ -0,0 +1,289 @@
+/***************************************************************************//**
+ *   @file   no_os_pool.c
+ *   @brief  Fixed block memory pools and size class arenas.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include "no_os_pool.h"
+#include "no_os_critical.h"
+
+/**
+ * @brief Set up a pool on top of a caller provided buffer.
+ * @param pool - The pool.
+ * @param mem - Pool storage. It is aligned up to NO_OS_POOL_ALIGN if needed.
+ * @param size - Size of the storage, in bytes.
+ * @param block_size - Size of a block, rounded up with NO_OS_POOL_BLOCK_SIZE.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_pool_init(struct no_os_pool *pool, void *mem, size_t size,
+		    size_t block_size)
+{
+	uintptr_t addr = (uintptr_t)mem;
+	size_t pad;
+
+	if (!pool || !mem || !block_size)
+		return -EINVAL;
+
+	pad = (NO_OS_POOL_ALIGN - (addr % NO_OS_POOL_ALIGN)) % NO_OS_POOL_ALIGN;
+	if (size < pad)
+		return -EINVAL;
+
+	memset(pool, 0, sizeof(*pool));
+	pool->block_size = NO_OS_POOL_BLOCK_SIZE(block_size);
+	pool->nb_blocks = (size - pad) / pool->block_size;
+	if (!pool->nb_blocks)
+		return -EINVAL;
+
+	pool->start = (uint8_t *)mem + pad;
+	pool->end = pool->start + pool->nb_blocks * pool->block_size;
+
+	return 0;
+}
+
+/**
+ * @brief Get a block from the pool.
+ * @param pool - The pool.
+ * @return Pointer to the block, or NULL if the pool is empty.
+ */
+void *no_os_pool_alloc(struct no_os_pool *pool)
+{
+	void *block;
+
+	if (pool->free_list) {
+		block = pool->free_list;
+		pool->free_list = *(void **)block;
+	} else if (pool->nb_touched < pool->nb_blocks) {
+		block = pool->start + pool->nb_touched * pool->block_size;
+		pool->nb_touched++;
+	} else {
+		pool->failed++;
+		return NULL;
+	}
+
+	pool->used++;
+	if (pool->used > pool->high_water)
+		pool->high_water = pool->used;
+
+	return block;
+}
+
+/**
+ * @brief Check whether a pointer was handed out by the pool.
+ * @param pool - The pool.
+ * @param ptr - The pointer.
+ * @return true if ptr is the start of one of the pool blocks.
+ */
+bool no_os_pool_owns(const struct no_os_pool *pool, const void *ptr)
+{
+	const uint8_t *p = ptr;
+
+	if (p < pool->start || p >= pool->end)
+		return false;
+
+	return !((size_t)(p - pool->start) % pool->block_size);
+}
+
+/**
+ * @brief Give a block back to the pool.
+ *
+ * A block which was never handed out is refused. With NO_OS_POOL_DEBUG, the
+ * free list is also searched, so that a double free is reported instead of
+ * corrupting the list.
+ *
+ * @param pool - The pool.
+ * @param ptr - Block returned by no_os_pool_alloc().
+ * @return 0 in case of success, -EINVAL if ptr does not belong to the pool,
+ * -EALREADY if the block is already free.
+ */
+int no_os_pool_free(struct no_os_pool *pool, void *ptr)
+{
+#ifdef NO_OS_POOL_DEBUG
+	void *block;
+#endif
+
+	if (!no_os_pool_owns(pool, ptr) ||
+	    (uint8_t *)ptr >= pool->start + pool->nb_touched * pool->block_size)
+		return -EINVAL;
+
+	if (!pool->used)
+		return -EALREADY;
+
+#ifdef NO_OS_POOL_DEBUG
+	for (block = pool->free_list; block; block = *(void **)block)
+		if (block == ptr)
+			return -EALREADY;
+#endif
+
+	*(void **)ptr = pool->free_list;
+	pool->free_list = ptr;
+	pool->used--;
+
+	return 0;
+}
+
+/**
+ * @brief Validate the arena pools.
+ *
+ * The pools may be statically initialized with NO_OS_POOL_INIT or set up with
+ * no_os_pool_init() before this call. A statically initialized arena needs no
+ * other setup.
+ *
+ * @param arena - The arena.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_arena_init(struct no_os_arena *arena)
+{
+	uint32_t i;
+
+	if (!arena || (arena->nb_pools && !arena->pools))
+		return -EINVAL;
+
+	for (i = 1; i < arena->nb_pools; i++)
+		if (arena->pools[i].block_size < arena->pools[i - 1].block_size)
+			return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate memory from the arena.
+ *
+ * The request goes to the smallest pool with a large enough block and spills
+ * over to the next larger pools when that one is empty. Requests no pool can
+ * serve go to the heap if heap_fallback is set. The pools are only touched in
+ * a critical section, so the arena can be used from interrupt handlers.
+ *
+ * @param arena - The arena.
+ * @param size - Number of bytes.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size)
+{
+	struct no_os_pool *pool;
+	void *ptr = NULL;
+	uint32_t i;
+
+	no_os_critical_enter();
+
+	for (i = 0; i < arena->nb_pools; i++) {
+		pool = &arena->pools[i];
+		if (pool->block_size < size)
+			continue;
+
+		ptr = no_os_pool_alloc(pool);
+		if (ptr) {
+			arena->used_bytes += pool->block_size;
+			if (arena->used_bytes > arena->high_water_bytes)
+				arena->high_water_bytes = arena->used_bytes;
+			break;
+		}
+	}
+
+	if (!ptr && !arena->heap_fallback)
+		arena->failed++;
+
+	no_os_critical_exit();
+
+	if (ptr || !arena->heap_fallback)
+		return ptr;
+
+	/* The heap has its own locking, keep it out of the critical section */
+	ptr = malloc(size);
+
+	no_os_critical_enter();
+	if (ptr)
+		arena->heap_allocs++;
+	else
+		arena->failed++;
+	no_os_critical_exit();
+
+	return ptr;
+}
+
+/**
+ * @brief Allocate memory from the arena and set it to 0.
+ * @param arena - The arena.
+ * @param nitems - Number of elements.
+ * @param size - Size of an element.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+void *no_os_arena_calloc(struct no_os_arena *arena, size_t nitems, size_t size)
+{
+	void *ptr;
+
+	if (size && nitems > SIZE_MAX / size)
+		return NULL;
+
+	ptr = no_os_arena_alloc(arena, nitems * size);
+	if (ptr)
+		memset(ptr, 0, nitems * size);
+
+	return ptr;
+}
+
+/**
+ * @brief Release memory allocated from the arena.
+ * @param arena - The arena.
+ * @param ptr - Pointer returned by no_os_arena_alloc() or no_os_arena_calloc().
+ * @return None.
+ */
+void no_os_arena_free(struct no_os_arena *arena, void *ptr)
+{
+	struct no_os_pool *pool;
+	uint32_t i;
+
+	if (!ptr)
+		return;
+
+	for (i = 0; i < arena->nb_pools; i++) {
+		pool = &arena->pools[i];
+		if (!no_os_pool_owns(pool, ptr))
+			continue;
+
+		/* A block refused by its pool must not reach the heap either */
+		no_os_critical_enter();
+		if (!no_os_pool_free(pool, ptr))
+			arena->used_bytes -= pool->block_size;
+		else
+			arena->failed++;
+		no_os_critical_exit();
+
+		return;
+	}
+
+	free(ptr);
+}
@@ -0,0 +1,422 @@
+/***************************************************************************//**
+ *   @file   no_os_pqueue.c
+ *   @brief  Binary heap priority queue with the no_os_list adapter interface.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include "no_os_pqueue.h"
+#include "no_os_alloc.h"
+
+/**
+ * @struct no_os_pqueue_entry
+ * @brief Heap slot.
+ */
+struct no_os_pqueue_entry {
+	/** User data */
+	void		*data;
+	/** Insertion order, breaks ties between elements comparing equal */
+	uint32_t	seq;
+};
+
+/**
+ * @struct _pqueue_desc
+ * @brief Priority queue descriptor.
+ */
+struct _pqueue_desc {
+	/** Function used to compare elements */
+	f_cmp				comparator;
+	/** Maximum number of elements */
+	uint32_t			capacity;
+	/** Number of elements in the queue */
+	uint32_t			nb_elements;
+	/** Sequence number of the next pushed element */
+	uint32_t			seq;
+	/** Min-heap, the lowest element is heap[0] */
+	struct no_os_pqueue_entry	heap[];
+};
+
+/** @brief Default function used to compare elements ( \ref f_cmp) */
+static int32_t no_os_pqueue_default_comparator(void *data1, void *data2)
+{
+	return (int32_t)((int32_t *)data1 - (int32_t *)data2);
+}
+
+/**
+ * @brief Check whether a heap entry goes before another one.
+ * @param pq - The priority queue.
+ * @param a - First entry.
+ * @param b - Second entry.
+ * @return true if a is popped before b.
+ */
+static inline bool no_os_pqueue_less(struct _pqueue_desc *pq,
+				     struct no_os_pqueue_entry *a,
+				     struct no_os_pqueue_entry *b)
+{
+	int32_t cmp = pq->comparator(a->data, b->data);
+
+	if (cmp)
+		return cmp < 0;
+
+	return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/**
+ * @brief Move an entry towards the root until the heap order is restored.
+ * @param pq - The priority queue.
+ * @param idx - Index of the entry.
+ * @return None.
+ */
+static void no_os_pqueue_sift_up(struct _pqueue_desc *pq, uint32_t idx)
+{
+	struct no_os_pqueue_entry entry = pq->heap[idx];
+	uint32_t parent;
+
+	while (idx) {
+		parent = (idx - 1) / 2;
+		if (!no_os_pqueue_less(pq, &entry, &pq->heap[parent]))
+			break;
+		pq->heap[idx] = pq->heap[parent];
+		idx = parent;
+	}
+
+	pq->heap[idx] = entry;
+}
+
+/**
+ * @brief Move an entry towards the leaves until the heap order is restored.
+ * @param pq - The priority queue.
+ * @param idx - Index of the entry.
+ * @return None.
+ */
+static void no_os_pqueue_sift_down(struct _pqueue_desc *pq, uint32_t idx)
+{
+	struct no_os_pqueue_entry entry = pq->heap[idx];
+	uint32_t child;
+
+	while ((child = 2 * idx + 1) < pq->nb_elements) {
+		if (child + 1 < pq->nb_elements &&
+		    no_os_pqueue_less(pq, &pq->heap[child + 1], &pq->heap[child]))
+			child++;
+		if (!no_os_pqueue_less(pq, &pq->heap[child], &entry))
+			break;
+		pq->heap[idx] = pq->heap[child];
+		idx = child;
+	}
+
+	pq->heap[idx] = entry;
+}
+
+/** @brief Insert an element. Refer to \ref f_add */
+static int32_t no_os_pqueue_push(struct no_os_list_desc *list_desc, void *data)
+{
+	struct _pqueue_desc *pq;
+
+	if (!list_desc)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	if (pq->nb_elements == pq->capacity)
+		return -1;
+
+	pq->heap[pq->nb_elements].data = data;
+	pq->heap[pq->nb_elements].seq = pq->seq++;
+	no_os_pqueue_sift_up(pq, pq->nb_elements++);
+
+	return 0;
+}
+
+/** @brief Read and remove the lowest element. Refer to \ref f_get */
+static int32_t no_os_pqueue_pop(struct no_os_list_desc *list_desc,
+				void **data)
+{
+	struct _pqueue_desc *pq;
+
+	if (!list_desc || !data)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	if (!pq->nb_elements) {
+		*data = NULL;
+		return -1;
+	}
+
+	*data = pq->heap[0].data;
+	pq->heap[0] = pq->heap[--pq->nb_elements];
+	if (pq->nb_elements)
+		no_os_pqueue_sift_down(pq, 0);
+
+	return 0;
+}
+
+/** @brief Read the lowest element. Refer to \ref f_read */
+static int32_t no_os_pqueue_top_next(struct no_os_list_desc *list_desc,
+				     void **data)
+{
+	struct _pqueue_desc *pq;
+
+	if (!list_desc || !data)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	if (!pq->nb_elements) {
+		*data = NULL;
+		return -1;
+	}
+
+	*data = pq->heap[0].data;
+
+	return 0;
+}
+
+/** @brief Read the biggest element. Refer to \ref f_read */
+static int32_t no_os_pqueue_back(struct no_os_list_desc *list_desc,
+				 void **data)
+{
+	struct _pqueue_desc *pq;
+	uint32_t i, max;
+
+	if (!list_desc || !data)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	if (!pq->nb_elements) {
+		*data = NULL;
+		return -1;
+	}
+
+	/* The biggest element is one of the leaves */
+	max = pq->nb_elements / 2;
+	for (i = max + 1; i < pq->nb_elements; i++)
+		if (no_os_pqueue_less(pq, &pq->heap[max], &pq->heap[i]))
+			max = i;
+
+	*data = pq->heap[max].data;
+
+	return 0;
+}
+
+/** @brief Replace the lowest element. Refer to \ref f_edit */
+static int32_t no_os_pqueue_swap(struct no_os_list_desc *list_desc,
+				 void *new_data)
+{
+	struct _pqueue_desc *pq;
+
+	if (!list_desc)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	if (!pq->nb_elements)
+		return -1;
+
+	pq->heap[0].data = new_data;
+	no_os_pqueue_sift_down(pq, 0);
+
+	return 0;
+}
+
+/**
+ * @brief Find the first queued element matching a key. Subtrees whose root
+ * goes after the key cannot hold it and are skipped.
+ * @param pq - The priority queue.
+ * @param idx - Root of the subtree to search.
+ * @param cmp_data - Key, compared with the queue comparator.
+ * @param found - Index of the match popped first so far, nb_elements if none.
+ * @return None.
+ */
+static void no_os_pqueue_find(struct _pqueue_desc *pq, uint32_t idx,
+			      void *cmp_data, uint32_t *found)
+{
+	int32_t cmp;
+
+	if (idx >= pq->nb_elements)
+		return;
+
+	cmp = pq->comparator(pq->heap[idx].data, cmp_data);
+	if (cmp > 0)
+		return;
+
+	if (!cmp && (*found == pq->nb_elements ||
+		     (int32_t)(pq->heap[idx].seq - pq->heap[*found].seq) < 0))
+		*found = idx;
+
+	no_os_pqueue_find(pq, 2 * idx + 1, cmp_data, found);
+	no_os_pqueue_find(pq, 2 * idx + 2, cmp_data, found);
+}
+
+/**
+ * @brief Read the element which match with cmp_data. Among the elements
+ * comparing equal, the one popped first is returned. Refer to \ref f_read
+ */
+int32_t no_os_pqueue_read_find(struct no_os_list_desc *list_desc, void **data,
+			       void *cmp_data)
+{
+	struct _pqueue_desc *pq;
+	uint32_t idx;
+
+	if (!list_desc || !data)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	idx = pq->nb_elements;
+	no_os_pqueue_find(pq, 0, cmp_data, &idx);
+	if (idx == pq->nb_elements) {
+		*data = NULL;
+		return -1;
+	}
+
+	*data = pq->heap[idx].data;
+
+	return 0;
+}
+
+/**
+ * @brief Read and delete the element which match with cmp_data. Among the
+ * elements comparing equal, the one popped first is removed. The last leaf
+ * takes its slot and is sifted up or down, in O(log n).
+ * Refer to \ref f_get
+ */
+int32_t no_os_pqueue_get_find(struct no_os_list_desc *list_desc, void **data,
+			      void *cmp_data)
+{
+	struct _pqueue_desc *pq;
+	uint32_t idx;
+
+	if (!list_desc || !data)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	idx = pq->nb_elements;
+	no_os_pqueue_find(pq, 0, cmp_data, &idx);
+	if (idx == pq->nb_elements) {
+		*data = NULL;
+		return -1;
+	}
+
+	*data = pq->heap[idx].data;
+	pq->heap[idx] = pq->heap[--pq->nb_elements];
+	if (idx < pq->nb_elements) {
+		if (idx && no_os_pqueue_less(pq, &pq->heap[idx],
+					     &pq->heap[(idx - 1) / 2]))
+			no_os_pqueue_sift_up(pq, idx);
+		else
+			no_os_pqueue_sift_down(pq, idx);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Create a new empty priority queue.
+ * @param list_desc - Where to store the reference of the new queue.
+ * @param capacity - Maximum number of elements.
+ * @param comparator - Used to order the elements, the lowest one is popped
+ * first.
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+int32_t no_os_pqueue_init(struct no_os_list_desc **list_desc,
+			  uint32_t capacity, f_cmp comparator)
+{
+	struct no_os_list_desc *l_desc;
+	struct _pqueue_desc *pq;
+
+	if (!list_desc || !capacity)
+		return -1;
+
+	l_desc = (struct no_os_list_desc *)no_os_calloc(1, sizeof(*l_desc));
+	if (!l_desc)
+		return -1;
+
+	pq = (struct _pqueue_desc *)no_os_calloc(1, sizeof(*pq) +
+			capacity * sizeof(pq->heap[0]));
+	if (!pq) {
+		no_os_free(l_desc);
+		return -1;
+	}
+
+	pq->comparator = comparator ? comparator :
+			 no_os_pqueue_default_comparator;
+	pq->capacity = capacity;
+
+	l_desc->push = no_os_pqueue_push;
+	l_desc->pop = no_os_pqueue_pop;
+	l_desc->top_next = no_os_pqueue_top_next;
+	l_desc->back = no_os_pqueue_back;
+	l_desc->swap = no_os_pqueue_swap;
+	l_desc->priv_desc = pq;
+	*list_desc = l_desc;
+
+	return 0;
+}
+
+/**
+ * @brief Remove the priority queue. The elements still queued are dropped.
+ * @param list_desc - Reference to the queue.
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+int32_t no_os_pqueue_remove(struct no_os_list_desc *list_desc)
+{
+	if (!list_desc)
+		return -1;
+
+	no_os_free(list_desc->priv_desc);
+	no_os_free(list_desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get the number of elements in the queue.
+ * @param list_desc - Reference to the queue.
+ * @param out_size - Where to store the number of elements.
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+int32_t no_os_pqueue_get_size(struct no_os_list_desc *list_desc,
+			      uint32_t *out_size)
+{
+	struct _pqueue_desc *pq;
+
+	if (!list_desc || !out_size)
+		return -1;
+
+	pq = list_desc->priv_desc;
+	*out_size = pq->nb_elements;
+
+	return 0;
+}
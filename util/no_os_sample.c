@@ -0,0 +1,741 @@
+/***************************************************************************//**
+ *   @file   no_os_sample.c
+ *   @brief  Source file of the sample format conversion utilities.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include <errno.h>
+#include "no_os_sample.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define NO_OS_SAMPLE_SSSE3
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define NO_OS_SAMPLE_NEON
+#endif
+
+/* Samples unpacked per pass by no_os_sample_unpack16(). */
+#define NO_OS_SAMPLE_BLOCK	64
+
+/**
+ * @brief Check a sample format.
+ * @param fmt - Sample format.
+ * @param max_bits - Largest realbits supported by the caller.
+ * @return 0 if the format is valid, -EINVAL otherwise.
+ */
+static int no_os_sample_check(const struct no_os_sample_fmt *fmt,
+			      uint8_t max_bits)
+{
+	if (!fmt || !fmt->realbits || fmt->realbits > max_bits ||
+	    fmt->storagebits > 32 ||
+	    fmt->realbits + fmt->shift > fmt->storagebits)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Load the 8 bytes at p as a big endian value.
+ * @param p - Source, may be unaligned.
+ * @return The loaded value.
+ */
+static inline uint64_t no_os_sample_load_be64(const uint8_t *p)
+{
+	return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+	       ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+	       ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+	       ((uint64_t)p[6] << 8) | p[7];
+}
+
+/**
+ * @brief Load the 4 bytes at p as a big endian value.
+ * @param p - Source, may be unaligned.
+ * @return The loaded value.
+ */
+static inline uint32_t no_os_sample_load_be32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+	       ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @struct no_os_sample_ext
+ * @brief Extraction of the valid bits out of a storage word moved to the top
+ * of a 32 bit word.
+ */
+struct no_os_sample_ext {
+	/** Left shift dropping the padding bits above the valid ones */
+	uint32_t	lsh;
+	/** Right shift dropping the padding bits below the valid ones */
+	uint32_t	rsh;
+	/** Sign bit of signed samples, 0 for unsigned ones */
+	uint32_t	sign;
+};
+
+/**
+ * @brief Compute the extraction of the samples of a format.
+ * @param fmt - Valid sample format.
+ * @param ext - Extraction.
+ */
+static void no_os_sample_ext_init(const struct no_os_sample_fmt *fmt,
+				  struct no_os_sample_ext *ext)
+{
+	ext->lsh = fmt->storagebits - fmt->shift - fmt->realbits;
+	ext->rsh = 32 - fmt->realbits;
+	ext->sign = fmt->is_signed ? 1u << (fmt->realbits - 1) : 0;
+}
+
+/**
+ * @brief Extract a sample.
+ *
+ * Flipping then subtracting the sign bit sign extends signed samples without
+ * a branch and leaves unsigned ones unchanged.
+ *
+ * @param w - Storage word, moved to the top of the 32 bit word and shifted
+ *            left by ext.lsh.
+ * @param ext - Extraction.
+ * @return The sample.
+ */
+static inline uint32_t no_os_sample_extract(uint32_t w,
+		struct no_os_sample_ext ext)
+{
+	return ((w >> ext.rsh) ^ ext.sign) - ext.sign;
+}
+
+/**
+ * @brief Unpack raw byte aligned words.
+ * @param fmt - Sample format, storagebits is a multiple of 8.
+ * @param ext - Extraction.
+ * @param src - Raw buffer.
+ * @param dst - Output samples.
+ * @param first - Index of the first sample to unpack.
+ * @param nb - Number of samples to unpack.
+ */
+static void no_os_sample_gather_words(const struct no_os_sample_fmt *fmt,
+				      struct no_os_sample_ext ext,
+				      const uint8_t *src, uint32_t *dst,
+				      uint32_t first, uint32_t nb)
+{
+	uint32_t bytes = fmt->storagebits / 8;
+	const uint8_t *p = src + first * bytes;
+	uint32_t i, w;
+
+	switch (bytes) {
+	case 1:
+		for (i = 0; i < nb; i++)
+			dst[i] = no_os_sample_extract((uint32_t)p[i] <<
+						      (24 + ext.lsh), ext);
+		break;
+	case 2:
+		for (i = 0; i < nb; i++, p += 2) {
+			if (fmt->is_big_endian)
+				w = ((uint32_t)p[0] << 24) |
+				    ((uint32_t)p[1] << 16);
+			else
+				w = ((uint32_t)p[1] << 24) |
+				    ((uint32_t)p[0] << 16);
+			dst[i] = no_os_sample_extract(w << ext.lsh, ext);
+		}
+		break;
+	case 3:
+		for (i = 0; i < nb; i++, p += 3) {
+			if (fmt->is_big_endian)
+				w = ((uint32_t)p[0] << 24) |
+				    ((uint32_t)p[1] << 16) |
+				    ((uint32_t)p[2] << 8);
+			else
+				w = ((uint32_t)p[2] << 24) |
+				    ((uint32_t)p[1] << 16) |
+				    ((uint32_t)p[0] << 8);
+			dst[i] = no_os_sample_extract(w << ext.lsh, ext);
+		}
+		break;
+	default:
+		for (i = 0; i < nb; i++, p += 4) {
+			if (fmt->is_big_endian)
+				w = no_os_sample_load_be32(p);
+			else
+				w = ((uint32_t)p[3] << 24) |
+				    ((uint32_t)p[2] << 16) |
+				    ((uint32_t)p[1] << 8) | p[0];
+			dst[i] = no_os_sample_extract(w << ext.lsh, ext);
+		}
+		break;
+	}
+}
+
+/**
+ * @brief Unpack a sample of a msb first bitstream fitting a 32 bit load.
+ * @param p - Raw buffer.
+ * @param pos - Position of the first bit of the sample.
+ * @param ext - Extraction.
+ * @return The sample.
+ */
+static inline uint32_t no_os_sample_bits_at(const uint8_t *p, uint32_t pos,
+		struct no_os_sample_ext ext)
+{
+	return no_os_sample_extract(no_os_sample_load_be32(p + pos / 8) <<
+				    (pos % 8 + ext.lsh), ext);
+}
+
+/**
+ * @brief Unpack groups of 8 samples of a msb first bitstream, which take bits
+ * bytes.
+ *
+ * Called with a constant bits, all the offsets and shifts within a group are
+ * constants.
+ *
+ * @param src - First byte of the first group.
+ * @param dst - Output samples.
+ * @param nb_groups - Number of groups.
+ * @param bits - Sample width, for which samples fit a 32 bit load.
+ * @param ext - Extraction.
+ */
+static inline void no_os_sample_gather_groups(const uint8_t *src,
+		uint32_t *dst, uint32_t nb_groups, const uint32_t bits,
+		struct no_os_sample_ext ext)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb_groups; i++, src += bits, dst += 8) {
+		dst[0] = no_os_sample_bits_at(src, 0 * bits, ext);
+		dst[1] = no_os_sample_bits_at(src, 1 * bits, ext);
+		dst[2] = no_os_sample_bits_at(src, 2 * bits, ext);
+		dst[3] = no_os_sample_bits_at(src, 3 * bits, ext);
+		dst[4] = no_os_sample_bits_at(src, 4 * bits, ext);
+		dst[5] = no_os_sample_bits_at(src, 5 * bits, ext);
+		dst[6] = no_os_sample_bits_at(src, 6 * bits, ext);
+		dst[7] = no_os_sample_bits_at(src, 7 * bits, ext);
+	}
+}
+
+/**
+ * @brief Unpack samples of a msb first bitstream.
+ *
+ * Each sample is taken out of a single 32 bit load, or a 64 bit load for the
+ * widths for which a sample can span 5 bytes. The few last samples, for which
+ * the load would reach past the end of the raw buffer, are assembled a byte at
+ * a time.
+ *
+ * @param fmt - Sample format.
+ * @param ext - Extraction.
+ * @param src - Raw buffer.
+ * @param raw_size - Size of the raw buffer, in bytes.
+ * @param dst - Output samples.
+ * @param first - Index of the first sample to unpack.
+ * @param nb - Number of samples to unpack.
+ */
+static void no_os_sample_gather_bits(const struct no_os_sample_fmt *fmt,
+				     struct no_os_sample_ext ext,
+				     const uint8_t *src, uint32_t raw_size,
+				     uint32_t *dst, uint32_t first, uint32_t nb)
+{
+	uint32_t bits = fmt->storagebits;
+	/* Samples start at bit offsets multiple of the lowest set bit */
+	uint32_t load = 8 - (bits & -bits) + bits <= 32 ? 4 : 8;
+	uint32_t pos = first * bits;
+	uint32_t fast = 0, i, k, w;
+	uint64_t v;
+
+	/* Samples starting in the first raw_size - load + 1 bytes */
+	if (raw_size >= load)
+		fast = ((raw_size - load + 1) * 8 + bits - 1) / bits;
+	fast = fast > first ? fast - first : 0;
+	if (fast > nb)
+		fast = nb;
+
+	/* The usual converter widths first go through unrolled groups */
+	i = first % 8 ? 0 : fast / 8 * 8;
+	switch (i ? bits : 0) {
+	case 18:
+		no_os_sample_gather_groups(src + pos / 8, dst, i / 8, 18, ext);
+		break;
+	case 20:
+		no_os_sample_gather_groups(src + pos / 8, dst, i / 8, 20, ext);
+		break;
+	case 26:
+		no_os_sample_gather_groups(src + pos / 8, dst, i / 8, 26, ext);
+		break;
+	default:
+		i = 0;
+		break;
+	}
+	pos += i * bits;
+
+	if (load == 4) {
+		for (; i < fast; i++, pos += bits) {
+			w = no_os_sample_load_be32(src + pos / 8);
+			dst[i] = no_os_sample_extract(w << (pos % 8 + ext.lsh),
+						      ext);
+		}
+	} else {
+		for (; i < fast; i++, pos += bits) {
+			w = no_os_sample_load_be64(src + pos / 8) >>
+			    (32 - pos % 8);
+			dst[i] = no_os_sample_extract(w << ext.lsh, ext);
+		}
+	}
+
+	for (; i < nb; i++, pos += bits) {
+		v = 0;
+		for (k = pos / 8; k < pos / 8 + 8; k++)
+			v = (v << 8) | (k < raw_size ? src[k] : 0);
+		w = v >> (32 - pos % 8);
+		dst[i] = no_os_sample_extract(w << ext.lsh, ext);
+	}
+}
+
+/**
+ * @brief Unpack raw samples.
+ * @param fmt - Sample format.
+ * @param src - Raw buffer.
+ * @param raw_size - Size of the raw buffer, in bytes.
+ * @param dst - Output samples.
+ * @param first - Index of the first sample to unpack.
+ * @param nb - Number of samples to unpack.
+ */
+static void no_os_sample_gather(const struct no_os_sample_fmt *fmt,
+				const uint8_t *src, uint32_t raw_size,
+				uint32_t *dst, uint32_t first, uint32_t nb)
+{
+	struct no_os_sample_ext ext;
+
+	no_os_sample_ext_init(fmt, &ext);
+	if (fmt->storagebits % 8)
+		no_os_sample_gather_bits(fmt, ext, src, raw_size, dst, first,
+					 nb);
+	else
+		no_os_sample_gather_words(fmt, ext, src, dst, first, nb);
+}
+
+#if defined(NO_OS_SAMPLE_SSSE3) || \
+	(defined(NO_OS_SAMPLE_NEON) && defined(__aarch64__))
+/**
+ * @brief Unpack byte aligned words of 2 to 4 bytes, 4 samples at a time.
+ *
+ * A byte shuffle moves each sample to the top bytes of a 32 bit lane, so a
+ * left shift followed by an arithmetic or logical right shift drops the
+ * padding bits and extends the valid ones.
+ *
+ * @param fmt - Sample format.
+ * @param src - Raw buffer.
+ * @param dst - Output samples.
+ * @param nb - Number of samples in the raw buffer.
+ * @return Number of samples unpacked, the remaining ones are left to the
+ *         portable code.
+ */
+static uint32_t no_os_sample_unpack32_simd(const struct no_os_sample_fmt *fmt,
+		const uint8_t *src, int32_t *dst, uint32_t nb)
+{
+	uint32_t bytes = fmt->storagebits / 8;
+	uint32_t lsh, rsh, done, k, t, top;
+	uint8_t idx[16];
+
+	if (fmt->storagebits % 8 || bytes < 2)
+		return 0;
+
+	/* Lane bytes not written by the shuffle are cleared */
+	memset(idx, 0x80, sizeof(idx));
+	for (k = 0; k < 4; k++) {
+		for (t = 0; t < bytes; t++) {
+			top = fmt->is_big_endian ? 3 - t : 4 - bytes + t;
+			idx[4 * k + top] = k * bytes + t;
+		}
+	}
+
+	lsh = 8 * bytes - fmt->shift - fmt->realbits;
+	rsh = 32 - fmt->realbits;
+
+	/* 16 bytes are loaded for the 4 * bytes consumed */
+#if defined(NO_OS_SAMPLE_SSSE3)
+	__m128i shuf = _mm_loadu_si128((const __m128i *)idx);
+	__m128i l = _mm_cvtsi32_si128(lsh);
+	__m128i r = _mm_cvtsi32_si128(rsh);
+	__m128i x;
+
+	for (done = 0; done * bytes + 16 <= nb * bytes; done += 4) {
+		x = _mm_loadu_si128((const __m128i *)(src + done * bytes));
+		x = _mm_sll_epi32(_mm_shuffle_epi8(x, shuf), l);
+		if (fmt->is_signed)
+			x = _mm_sra_epi32(x, r);
+		else
+			x = _mm_srl_epi32(x, r);
+		_mm_storeu_si128((__m128i *)(dst + done), x);
+	}
+#else
+	uint8x16_t shuf = vld1q_u8(idx);
+	int32x4_t l = vdupq_n_s32(lsh);
+	int32x4_t r = vdupq_n_s32(-(int32_t)rsh);
+	uint32x4_t x;
+
+	for (done = 0; done * bytes + 16 <= nb * bytes; done += 4) {
+		x = vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(src +
+						    done * bytes), shuf));
+		x = vshlq_u32(x, l);
+		if (fmt->is_signed)
+			vst1q_s32(dst + done,
+				  vshlq_s32(vreinterpretq_s32_u32(x), r));
+		else
+			vst1q_s32(dst + done,
+				  vreinterpretq_s32_u32(vshlq_u32(x, r)));
+	}
+#endif
+
+	return done;
+}
+#else
+#define no_os_sample_unpack32_simd(fmt, src, dst, nb)	0
+#endif
+
+/**
+ * @brief Get the number of bytes taken by samples in a raw buffer.
+ * @param fmt - Sample format.
+ * @param nb_samples - Number of samples.
+ * @return The raw buffer size, the last byte of a bitstream may be partial.
+ */
+uint32_t no_os_sample_raw_size(const struct no_os_sample_fmt *fmt,
+			       uint32_t nb_samples)
+{
+	return (nb_samples * fmt->storagebits + 7) / 8;
+}
+
+/**
+ * @brief Unpack raw samples to 32 bit values.
+ * @param fmt - Sample format.
+ * @param src - Raw buffer, no_os_sample_raw_size() bytes.
+ * @param dst - Output samples.
+ * @param nb_samples - Number of samples.
+ * @return 0 in case of success, -EINVAL if the format is invalid.
+ */
+int no_os_sample_unpack32(const struct no_os_sample_fmt *fmt,
+			  const uint8_t *src, int32_t *dst,
+			  uint32_t nb_samples)
+{
+	uint32_t i;
+
+	if (no_os_sample_check(fmt, 32) || !src || !dst)
+		return -EINVAL;
+
+	i = no_os_sample_unpack32_simd(fmt, src, dst, nb_samples);
+	no_os_sample_gather(fmt, src, no_os_sample_raw_size(fmt, nb_samples),
+			    (uint32_t *)dst + i, i, nb_samples - i);
+
+	return 0;
+}
+
+/**
+ * @brief Unpack raw samples of at most 16 valid bits to 16 bit values.
+ * @param fmt - Sample format.
+ * @param src - Raw buffer, no_os_sample_raw_size() bytes.
+ * @param dst - Output samples.
+ * @param nb_samples - Number of samples.
+ * @return 0 in case of success, -EINVAL if the format is invalid.
+ */
+int no_os_sample_unpack16(const struct no_os_sample_fmt *fmt,
+			  const uint8_t *src, int16_t *dst,
+			  uint32_t nb_samples)
+{
+	uint32_t w[NO_OS_SAMPLE_BLOCK];
+	uint32_t raw_size, i, j, n;
+
+	if (no_os_sample_check(fmt, 16) || !src || !dst)
+		return -EINVAL;
+
+	raw_size = no_os_sample_raw_size(fmt, nb_samples);
+	for (i = 0; i < nb_samples; i += n) {
+		n = nb_samples - i;
+		if (n > NO_OS_SAMPLE_BLOCK)
+			n = NO_OS_SAMPLE_BLOCK;
+
+		no_os_sample_gather(fmt, src, raw_size, w, i, n);
+		for (j = 0; j < n; j++)
+			dst[i + j] = w[j];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Pack 16 or 32 bit values to raw samples.
+ * @param fmt - Valid sample format.
+ * @param src32 - 32 bit input samples, NULL if src16 is used.
+ * @param src16 - 16 bit input samples.
+ * @param dst - Raw buffer, no_os_sample_raw_size() bytes.
+ * @param nb - Number of samples.
+ */
+static void no_os_sample_pack(const struct no_os_sample_fmt *fmt,
+			      const int32_t *src32, const int16_t *src16,
+			      uint8_t *dst, uint32_t nb)
+{
+	uint32_t mask = 0xFFFFFFFF >> (32 - fmt->realbits);
+	uint32_t bits = fmt->storagebits;
+	uint32_t bytes = bits / 8;
+	uint32_t nbits = 0;
+	uint64_t acc = 0;
+	uint32_t i, k, w;
+
+	for (i = 0; i < nb; i++) {
+		w = src32 ? (uint32_t)src32[i] : (uint32_t)src16[i];
+		w = (w & mask) << fmt->shift;
+
+		if (bits % 8) {
+			/* At most 7 bits are left from the previous sample */
+			acc = (acc << bits) | w;
+			nbits += bits;
+			while (nbits >= 8) {
+				nbits -= 8;
+				*dst++ = acc >> nbits;
+			}
+		} else if (fmt->is_big_endian) {
+			switch (bytes) {
+			case 4:
+				*dst++ = w >> 24;
+			/* fallthrough */
+			case 3:
+				*dst++ = w >> 16;
+			/* fallthrough */
+			case 2:
+				*dst++ = w >> 8;
+			/* fallthrough */
+			default:
+				*dst++ = w;
+				break;
+			}
+		} else {
+			for (k = 0; k < bytes; k++, w >>= 8)
+				*dst++ = w;
+		}
+	}
+
+	if (nbits)
+		*dst = acc << (8 - nbits);
+}
+
+/**
+ * @brief Pack 32 bit values to raw samples.
+ * @param fmt - Sample format.
+ * @param src - Input samples, the low realbits of each are used.
+ * @param dst - Raw buffer, no_os_sample_raw_size() bytes.
+ * @param nb_samples - Number of samples.
+ * @return 0 in case of success, -EINVAL if the format is invalid.
+ */
+int no_os_sample_pack32(const struct no_os_sample_fmt *fmt,
+			const int32_t *src, uint8_t *dst, uint32_t nb_samples)
+{
+	if (no_os_sample_check(fmt, 32) || !src || !dst)
+		return -EINVAL;
+
+	no_os_sample_pack(fmt, src, NULL, dst, nb_samples);
+
+	return 0;
+}
+
+/**
+ * @brief Pack 16 bit values to raw samples.
+ * @param fmt - Sample format.
+ * @param src - Input samples, the low realbits of each are used.
+ * @param dst - Raw buffer, no_os_sample_raw_size() bytes.
+ * @param nb_samples - Number of samples.
+ * @return 0 in case of success, -EINVAL if the format is invalid.
+ */
+int no_os_sample_pack16(const struct no_os_sample_fmt *fmt,
+			const int16_t *src, uint8_t *dst, uint32_t nb_samples)
+{
+	if (no_os_sample_check(fmt, 16) || !src || !dst)
+		return -EINVAL;
+
+	no_os_sample_pack(fmt, NULL, src, dst, nb_samples);
+
+	return 0;
+}
+
+/**
+ * @brief Sign extend samples in place.
+ * @param buf - Samples.
+ * @param nb_samples - Number of samples.
+ * @param bits - Number of valid bits, 1 to 32.
+ */
+void no_os_sample_sign_extend32(int32_t *buf, uint32_t nb_samples,
+				uint8_t bits)
+{
+	uint32_t shift = 32 - bits;
+	uint32_t i;
+
+	if (!bits || bits >= 32)
+		return;
+
+	for (i = 0; i < nb_samples; i++)
+		buf[i] = (int32_t)((uint32_t)buf[i] << shift) >> shift;
+}
+
+#if defined(NO_OS_SAMPLE_SSSE3)
+/**
+ * @brief Reverse the bytes of each word of the 16 byte blocks of a buffer.
+ * @param p - Buffer.
+ * @param size - Buffer size, in bytes.
+ * @param idx - Shuffle reversing the bytes of a 16 byte block.
+ * @return Number of bytes processed.
+ */
+static uint32_t no_os_sample_swap_simd(uint8_t *p, uint32_t size,
+				       const uint8_t *idx)
+{
+	__m128i shuf = _mm_loadu_si128((const __m128i *)idx);
+	__m128i x;
+	uint32_t i;
+
+	for (i = 0; i + 16 <= size; i += 16) {
+		x = _mm_loadu_si128((const __m128i *)(p + i));
+		_mm_storeu_si128((__m128i *)(p + i), _mm_shuffle_epi8(x, shuf));
+	}
+
+	return i;
+}
+
+static const uint8_t no_os_sample_rev16[16] = {
+	1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+};
+
+static const uint8_t no_os_sample_rev32[16] = {
+	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+};
+
+static const uint8_t no_os_sample_rev64[16] = {
+	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+};
+
+#define no_os_sample_swap16_simd(p, size) \
+	no_os_sample_swap_simd(p, size, no_os_sample_rev16)
+#define no_os_sample_swap32_simd(p, size) \
+	no_os_sample_swap_simd(p, size, no_os_sample_rev32)
+#define no_os_sample_swap64_simd(p, size) \
+	no_os_sample_swap_simd(p, size, no_os_sample_rev64)
+#elif defined(NO_OS_SAMPLE_NEON)
+static uint32_t no_os_sample_swap16_simd(uint8_t *p, uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i + 16 <= size; i += 16)
+		vst1q_u8(p + i, vrev16q_u8(vld1q_u8(p + i)));
+
+	return i;
+}
+
+static uint32_t no_os_sample_swap32_simd(uint8_t *p, uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i + 16 <= size; i += 16)
+		vst1q_u8(p + i, vrev32q_u8(vld1q_u8(p + i)));
+
+	return i;
+}
+
+static uint32_t no_os_sample_swap64_simd(uint8_t *p, uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i + 16 <= size; i += 16)
+		vst1q_u8(p + i, vrev64q_u8(vld1q_u8(p + i)));
+
+	return i;
+}
+#else
+#define no_os_sample_swap16_simd(p, size)	0
+#define no_os_sample_swap32_simd(p, size)	0
+#define no_os_sample_swap64_simd(p, size)	0
+#endif
+
+/**
+ * @brief Reverse the byte order of 16 bit words in place.
+ * @param buf - Buffer, may be unaligned.
+ * @param nb_words - Number of words.
+ */
+void no_os_sample_swap16(void *buf, uint32_t nb_words)
+{
+	uint8_t *p = buf;
+	uint32_t i;
+	uint16_t w;
+
+	i = no_os_sample_swap16_simd(p, nb_words * 2);
+	for (; i < nb_words * 2; i += 2) {
+		memcpy(&w, p + i, sizeof(w));
+		w = (w >> 8) | (w << 8);
+		memcpy(p + i, &w, sizeof(w));
+	}
+}
+
+/**
+ * @brief Reverse the byte order of 32 bit words in place.
+ * @param buf - Buffer, may be unaligned.
+ * @param nb_words - Number of words.
+ */
+void no_os_sample_swap32(void *buf, uint32_t nb_words)
+{
+	uint8_t *p = buf;
+	uint32_t i;
+	uint32_t w;
+
+	i = no_os_sample_swap32_simd(p, nb_words * 4);
+	for (; i < nb_words * 4; i += 4) {
+		memcpy(&w, p + i, sizeof(w));
+		w = ((w >> 24) & 0x000000FF) | ((w >> 8) & 0x0000FF00) |
+		    ((w << 8) & 0x00FF0000) | ((w << 24) & 0xFF000000);
+		memcpy(p + i, &w, sizeof(w));
+	}
+}
+
+/**
+ * @brief Reverse the byte order of 64 bit words in place.
+ * @param buf - Buffer, may be unaligned.
+ * @param nb_words - Number of words.
+ */
+void no_os_sample_swap64(void *buf, uint32_t nb_words)
+{
+	uint8_t *p = buf;
+	uint32_t i;
+	uint64_t w;
+
+	i = no_os_sample_swap64_simd(p, nb_words * 8);
+	for (; i < nb_words * 8; i += 8) {
+		memcpy(&w, p + i, sizeof(w));
+		w = ((w >> 8) & 0x00FF00FF00FF00FFULL) |
+		    ((w << 8) & 0xFF00FF00FF00FF00ULL);
+		w = ((w >> 16) & 0x0000FFFF0000FFFFULL) |
+		    ((w << 16) & 0xFFFF0000FFFF0000ULL);
+		w = (w >> 32) | (w << 32);
+		memcpy(p + i, &w, sizeof(w));
+	}
+}
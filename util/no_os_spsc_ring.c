@@ -0,0 +1,365 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.c
+ *   @brief  Lock-free single producer, single consumer ring buffer
+********************************************************************************
+ *   @copyright
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "no_os_spsc_ring.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/*
+ * The producer publishes head with release semantics after writing the
+ * elements and the consumer reads it with acquire semantics before reading
+ * them. tail is handled the same way in the opposite direction. Each side
+ * reads its own index relaxed since nobody else writes it.
+ */
+#ifdef NO_OS_SPSC_C11_ATOMICS
+#define spsc_load_relaxed(p)	atomic_load_explicit(p, memory_order_relaxed)
+#define spsc_load_acquire(p)	atomic_load_explicit(p, memory_order_acquire)
+#define spsc_store_release(p, v) \
+	atomic_store_explicit(p, v, memory_order_release)
+#else
+#define spsc_load_relaxed(p)	(*(p))
+
+static inline uint32_t spsc_load_acquire(volatile uint32_t *p)
+{
+	uint32_t val = *p;
+
+	__sync_synchronize();
+
+	return val;
+}
+
+static inline void spsc_store_release(volatile uint32_t *p, uint32_t val)
+{
+	__sync_synchronize();
+	*p = val;
+}
+#endif
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Round up to the next power of 2.
+ * @param val - Value to round up. Must not be 0.
+ * @return The power of 2 or 0 if it doesn't fit in 32 bits.
+ */
+static uint32_t spsc_roundup_pow2(uint32_t val)
+{
+	if (val > 0x80000000u)
+		return 0;
+
+	val--;
+	val |= val >> 1;
+	val |= val >> 2;
+	val |= val >> 4;
+	val |= val >> 8;
+	val |= val >> 16;
+
+	return val + 1;
+}
+
+/**
+ * @brief Configure a ring over a user provided buffer.
+ * @param ring - Ring descriptor.
+ * @param buff - Buffer of at least elem_size * nb_elems bytes.
+ * @param elem_size - Size of an element in bytes.
+ * @param nb_elems - Number of elements. Must be a power of 2.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_spsc_ring_cfg(struct no_os_spsc_ring *ring, void *buff,
+			    uint32_t elem_size, uint32_t nb_elems)
+{
+	if (!ring || !buff || !elem_size || !nb_elems ||
+	    (nb_elems & (nb_elems - 1)))
+		return -EINVAL;
+
+	ring->buff = buff;
+	ring->elem_size = elem_size;
+	ring->mask = nb_elems - 1;
+	ring->head = 0;
+	ring->tail = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate a ring.
+ * @param ring - Where to store the ring reference.
+ * @param elem_size - Size of an element in bytes.
+ * @param nb_elems - Minimum number of elements. Rounded up to a power of 2.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t elem_size,
+			     uint32_t nb_elems)
+{
+	struct no_os_spsc_ring *lring;
+	uint8_t *buff;
+	int32_t ret;
+
+	if (!ring || !elem_size || !nb_elems)
+		return -EINVAL;
+
+	nb_elems = spsc_roundup_pow2(nb_elems);
+	if (!nb_elems || nb_elems > UINT32_MAX / elem_size)
+		return -EINVAL;
+
+	lring = (struct no_os_spsc_ring *)no_os_calloc(1, sizeof(*lring));
+	if (!lring)
+		return -ENOMEM;
+
+	buff = (uint8_t *)no_os_calloc(nb_elems, elem_size);
+	if (!buff) {
+		ret = -ENOMEM;
+		goto free_ring;
+	}
+
+	ret = no_os_spsc_ring_cfg(lring, buff, elem_size, nb_elems);
+	if (ret)
+		goto free_buff;
+
+	*ring = lring;
+
+	return 0;
+
+free_buff:
+	no_os_free(buff);
+free_ring:
+	no_os_free(lring);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_spsc_ring_init().
+ * @param ring - Ring descriptor.
+ */
+void no_os_spsc_ring_remove(struct no_os_spsc_ring *ring)
+{
+	if (!ring)
+		return;
+
+	no_os_free(ring->buff);
+	no_os_free(ring);
+}
+
+/**
+ * @brief Get the total number of elements of the ring.
+ * @param ring - Ring descriptor.
+ * @return Number of elements.
+ */
+uint32_t no_os_spsc_ring_capacity(struct no_os_spsc_ring *ring)
+{
+	return ring->mask + 1;
+}
+
+/**
+ * @brief Get the number of elements that can be read.
+ * @param ring - Ring descriptor.
+ * @return Number of elements.
+ */
+uint32_t no_os_spsc_ring_used(struct no_os_spsc_ring *ring)
+{
+	return spsc_load_acquire(&ring->head) - spsc_load_relaxed(&ring->tail);
+}
+
+/**
+ * @brief Get the number of elements that can be written.
+ * @param ring - Ring descriptor.
+ * @return Number of elements.
+ */
+uint32_t no_os_spsc_ring_avail(struct no_os_spsc_ring *ring)
+{
+	return ring->mask + 1 - (spsc_load_relaxed(&ring->head) -
+				 spsc_load_acquire(&ring->tail));
+}
+
+/**
+ * @brief Get a contiguous free region. The elements are not visible to the
+ * consumer until no_os_spsc_ring_commit() is called.
+ * @param ring - Ring descriptor.
+ * @param nb - Maximum number of elements needed.
+ * @param addr - Set to the start of the region.
+ * @return Number of elements of the region. It can be less than nb if the
+ * ring is almost full or the region reaches the end of the buffer.
+ */
+uint32_t no_os_spsc_ring_reserve(struct no_os_spsc_ring *ring, uint32_t nb,
+				 void **addr)
+{
+	uint32_t idx = spsc_load_relaxed(&ring->head) & ring->mask;
+	uint32_t avail = no_os_spsc_ring_avail(ring);
+
+	nb = no_os_min(nb, avail);
+	nb = no_os_min(nb, ring->mask + 1 - idx);
+	*addr = ring->buff + idx * ring->elem_size;
+
+	return nb;
+}
+
+/**
+ * @brief Make elements written in a reserved region visible to the consumer.
+ * @param ring - Ring descriptor.
+ * @param nb - Number of elements written. At most the reserved number.
+ */
+void no_os_spsc_ring_commit(struct no_os_spsc_ring *ring, uint32_t nb)
+{
+	spsc_store_release(&ring->head, spsc_load_relaxed(&ring->head) + nb);
+}
+
+/**
+ * @brief Get a contiguous region of readable elements. The elements are not
+ * overwritten by the producer until no_os_spsc_ring_release() is called.
+ * @param ring - Ring descriptor.
+ * @param nb - Maximum number of elements needed.
+ * @param addr - Set to the start of the region.
+ * @return Number of elements of the region. It can be less than nb if there
+ * is less data or the region reaches the end of the buffer.
+ */
+uint32_t no_os_spsc_ring_peek(struct no_os_spsc_ring *ring, uint32_t nb,
+			      void **addr)
+{
+	uint32_t idx = spsc_load_relaxed(&ring->tail) & ring->mask;
+	uint32_t used = no_os_spsc_ring_used(ring);
+
+	nb = no_os_min(nb, used);
+	nb = no_os_min(nb, ring->mask + 1 - idx);
+	*addr = ring->buff + idx * ring->elem_size;
+
+	return nb;
+}
+
+/**
+ * @brief Give consumed elements back to the producer.
+ * @param ring - Ring descriptor.
+ * @param nb - Number of elements consumed. At most the peeked number.
+ */
+void no_os_spsc_ring_release(struct no_os_spsc_ring *ring, uint32_t nb)
+{
+	spsc_store_release(&ring->tail, spsc_load_relaxed(&ring->tail) + nb);
+}
+
+/**
+ * @brief Drop all the elements that can be read.
+ * @param ring - Ring descriptor.
+ */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring)
+{
+	spsc_store_release(&ring->tail, spsc_load_acquire(&ring->head));
+}
+
+/**
+ * @brief Empty the ring and move both positions back to the first element,
+ * so that the next reservation can use the whole ring as one region.
+ * Unlike the other functions, it writes both positions: it can only be used
+ * while neither the producer nor the consumer accesses the ring.
+ * @param ring - Ring descriptor.
+ */
+void no_os_spsc_ring_reset(struct no_os_spsc_ring *ring)
+{
+	spsc_store_release(&ring->head, 0);
+	spsc_store_release(&ring->tail, 0);
+}
+
+/**
+ * @brief Copy elements in the ring. All of them are published at once.
+ * @param ring - Ring descriptor.
+ * @param data - Elements to copy.
+ * @param nb - Number of elements.
+ * @return Number of elements copied. Less than nb if the ring is full.
+ */
+uint32_t no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *data,
+			       uint32_t nb)
+{
+	const uint8_t *src = data;
+	uint32_t head, idx, len, done, avail;
+
+	head = spsc_load_relaxed(&ring->head);
+	avail = no_os_spsc_ring_avail(ring);
+	nb = no_os_min(nb, avail);
+	done = 0;
+	while (done < nb) {
+		idx = (head + done) & ring->mask;
+		len = no_os_min(nb - done, ring->mask + 1 - idx);
+		memcpy(ring->buff + idx * ring->elem_size,
+		       src + done * ring->elem_size, len * ring->elem_size);
+		done += len;
+	}
+	spsc_store_release(&ring->head, head + nb);
+
+	return nb;
+}
+
+/**
+ * @brief Copy elements from the ring and free them.
+ * @param ring - Ring descriptor.
+ * @param data - Where to copy the elements.
+ * @param nb - Maximum number of elements.
+ * @return Number of elements read. Less than nb if there is less data.
+ */
+uint32_t no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *data,
+			      uint32_t nb)
+{
+	uint8_t *dst = data;
+	uint32_t tail, idx, len, done, used;
+
+	tail = spsc_load_relaxed(&ring->tail);
+	used = no_os_spsc_ring_used(ring);
+	nb = no_os_min(nb, used);
+	done = 0;
+	while (done < nb) {
+		idx = (tail + done) & ring->mask;
+		len = no_os_min(nb - done, ring->mask + 1 - idx);
+		memcpy(dst + done * ring->elem_size,
+		       ring->buff + idx * ring->elem_size, len * ring->elem_size);
+		done += len;
+	}
+	spsc_store_release(&ring->tail, tail + nb);
+
+	return nb;
+}
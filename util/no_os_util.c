@@ -43,6 +43,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "no_os_util.h"
+#include "no_os_sample.h"
 #include "errno.h"
 /******************************************************************************/
 /************************** Functions Implementation **************************/
@@ -313,6 +314,246 @@ uint32_t no_os_str_to_uint32(const char *str)
 		return value;
 }
 
+/* Two decimal digits for each value in [0, 99] */
+static const char no_os_dec_pairs[200] =
+	"00010203040506070809101112131415161718192021222324"
+	"25262728293031323334353637383940414243444546474849"
+	"50515253545556575859606162636465666768697071727374"
+	"75767778798081828384858687888990919293949596979899";
+
+static const uint32_t no_os_pow10[10] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+	1000000000
+};
+
+/**
+ * Converts from uint32_t to a zero padded decimal string.
+ * @param str - Destination, must hold at least 11 characters.
+ * @param value - Value to be converted.
+ * @param width - Minimum number of digits, at most 10.
+ * @return Number of characters written, not counting the null terminator.
+ */
+uint32_t no_os_uint32_to_str(char *str, uint32_t value, uint32_t width)
+{
+	uint32_t n = 1;
+	uint32_t i;
+
+	while (n < 10 && value >= no_os_pow10[n])
+		n++;
+	n = no_os_clamp(width, n, 10);
+
+	str[n] = '\0';
+	for (i = n; value >= 100; value /= 100) {
+		i -= 2;
+		memcpy(&str[i], &no_os_dec_pairs[2 * (value % 100)], 2);
+	}
+	if (value >= 10) {
+		i -= 2;
+		memcpy(&str[i], &no_os_dec_pairs[2 * value], 2);
+	} else {
+		str[--i] = '0' + value;
+	}
+	while (i)
+		str[--i] = '0';
+
+	return n;
+}
+
+/**
+ * Converts from int32_t to a decimal string.
+ * @param str - Destination, must hold at least 12 characters.
+ * @param value - Value to be converted.
+ * @return Number of characters written, not counting the null terminator.
+ */
+uint32_t no_os_int32_to_str(char *str, int32_t value)
+{
+	if (value >= 0)
+		return no_os_uint32_to_str(str, value, 0);
+
+	str[0] = '-';
+
+	return 1 + no_os_uint32_to_str(str + 1, 0u - (uint32_t)value, 0);
+}
+
+/**
+ * Converts from uint32_t to a zero padded lowercase hexadecimal string.
+ * @param str - Destination, must hold at least 9 characters.
+ * @param value - Value to be converted.
+ * @param width - Minimum number of digits, at most 8.
+ * @return Number of characters written, not counting the null terminator.
+ */
+uint32_t no_os_uint32_to_hex_str(char *str, uint32_t value, uint32_t width)
+{
+	static const char hex[] = "0123456789abcdef";
+	uint32_t n = 1;
+	uint32_t i;
+
+	while (n < 8 && (value >> (4 * n)))
+		n++;
+	n = no_os_clamp(width, n, 8);
+
+	str[n] = '\0';
+	for (i = n; i; value >>= 4)
+		str[--i] = hex[value & 0xF];
+
+	return n;
+}
+
+/* Value of an alphanumeric digit in any base up to 36, 36 for anything else */
+static inline uint32_t no_os_digit_value(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c |= 0x20;
+	if (c >= 'a' && c <= 'z')
+		return c - 'a' + 10;
+
+	return 36;
+}
+
+static inline bool no_os_is_space(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * Common part of the integer parsers, following the strtoul() rules for
+ * white space, sign, base prefixes and overflow.
+ * @param str - String to be parsed.
+ * @param base - 8, 10, 16, or 0 to detect the base from the prefix.
+ * @param is_signed - Saturate to the int32_t range instead of uint32_t.
+ * @param neg - Set if the number has a minus sign.
+ * @param ovf - Set if the magnitude was saturated.
+ * @param value - Parsed magnitude, 0 if nothing was parsed.
+ * @return Number of characters parsed, 0 if the string holds no number.
+ */
+static uint32_t no_os_str_parse_mag(const char *str, uint32_t base,
+				    bool is_signed, bool *neg, bool *ovf,
+				    uint32_t *value)
+{
+	const char *p = str;
+	const char *digits;
+	uint32_t limit, cutoff, cutlim;
+	uint32_t v = 0;
+	uint32_t d;
+
+	while (no_os_is_space(*p))
+		p++;
+	*neg = *p == '-';
+	if (*p == '-' || *p == '+')
+		p++;
+
+	if ((!base || base == 16) && p[0] == '0' && (p[1] | 0x20) == 'x' &&
+	    no_os_digit_value(p[2]) < 16) {
+		base = 16;
+		p += 2;
+	} else if (!base) {
+		base = p[0] == '0' ? 8 : 10;
+	}
+
+	/* INT32_MIN has one more unit of magnitude than INT32_MAX */
+	limit = is_signed ? (uint32_t)INT32_MAX + *neg : UINT32_MAX;
+	cutoff = limit / base;
+	cutlim = limit % base;
+	*ovf = false;
+	for (digits = p; (d = no_os_digit_value(*p)) < base; p++) {
+		if (v > cutoff || (v == cutoff && d > cutlim))
+			*ovf = true;
+		else
+			v = v * base + d;
+	}
+
+	if (p == digits) {
+		*value = 0;
+		return 0;
+	}
+	*value = *ovf ? limit : v;
+
+	return p - str;
+}
+
+/**
+ * Parses an int32_t from the beginning of a string, like strtol(). Values out
+ * of range saturate to INT32_MIN/INT32_MAX.
+ * @param str - String to be parsed.
+ * @param base - 8, 10, 16, or 0 to detect the base from the prefix.
+ * @param value - Parsed value, 0 if the string holds no number.
+ * @return Number of characters parsed, 0 if the string holds no number.
+ */
+uint32_t no_os_str_parse_int32(const char *str, uint32_t base, int32_t *value)
+{
+	uint32_t mag, n;
+	bool neg, ovf;
+
+	n = no_os_str_parse_mag(str, base, true, &neg, &ovf, &mag);
+	*value = neg ? (int32_t)-(int64_t)mag : (int32_t)mag;
+
+	return n;
+}
+
+/**
+ * Parses an uint32_t from the beginning of a string, like strtoul(). Negative
+ * values wrap around, values out of range saturate to UINT32_MAX.
+ * @param str - String to be parsed.
+ * @param base - 8, 10, 16, or 0 to detect the base from the prefix.
+ * @param value - Parsed value, 0 if the string holds no number.
+ * @return Number of characters parsed, 0 if the string holds no number.
+ */
+uint32_t no_os_str_parse_uint32(const char *str, uint32_t base,
+				uint32_t *value)
+{
+	uint32_t mag, n;
+	bool neg, ovf;
+
+	n = no_os_str_parse_mag(str, base, false, &neg, &ovf, &mag);
+	*value = neg && !ovf ? 0u - mag : mag;
+
+	return n;
+}
+
+/**
+ * Parses the digits after the decimal point of a number as an amount of
+ * 10^-digits subunits. Extra digits are truncated, so with 6 digits "5"
+ * parses as 500000 and "1234567" as 123456.
+ * @param str - String following the decimal point. White space and a sign
+ *              are accepted in front of the digits, like for strtol().
+ * @param digits - Number of fractional digits kept, at most 9.
+ * @param value - Parsed value, 0 if the string holds no digits.
+ * @return Number of characters parsed, 0 if the string holds no digits.
+ */
+uint32_t no_os_str_parse_fract(const char *str, uint32_t digits,
+			       int32_t *value)
+{
+	const char *p = str;
+	const char *start;
+	uint32_t v = 0;
+	uint32_t n = 0;
+	bool neg;
+
+	digits = no_os_min(digits, 9);
+	while (no_os_is_space(*p))
+		p++;
+	neg = *p == '-';
+	if (*p == '-' || *p == '+')
+		p++;
+
+	for (start = p; *p >= '0' && *p <= '9'; p++) {
+		if (n < digits) {
+			v = v * 10 + (*p - '0');
+			n++;
+		}
+	}
+
+	if (p == start) {
+		*value = 0;
+		return 0;
+	}
+	v *= no_os_pow10[digits - n];
+	*value = neg ? -(int32_t)v : (int32_t)v;
+
+	return p - str;
+}
+
 void no_os_put_unaligned_be16(uint16_t val, uint8_t *buf)
 {
 	buf[1] = val & 0xFF;
@@ -446,15 +687,31 @@ void no_os_memswap64(void *buf, uint32_t bytes, uint32_t step)
 {
 	uint8_t * p = buf;
 	uint32_t i, j;
-	uint8_t temp[8];
+	uint8_t temp;
 
 	if (step < 2 || step > 8 || bytes < step || bytes % step != 0)
 		return;
 
-	for (i = 0; i < bytes; i += step) {
-		memcpy(temp, p, step);
-		for (j = step; j > 0; j--) {
-			*p++ = temp[j - 1];
+	/* Power of 2 steps swap whole words, see no_os_sample.h */
+	switch (step) {
+	case 2:
+		no_os_sample_swap16(buf, bytes / 2);
+		return;
+	case 4:
+		no_os_sample_swap32(buf, bytes / 4);
+		return;
+	case 8:
+		no_os_sample_swap64(buf, bytes / 8);
+		return;
+	default:
+		break;
+	}
+
+	for (i = 0; i < bytes; i += step, p += step) {
+		for (j = 0; j < step / 2; j++) {
+			temp = p[j];
+			p[j] = p[step - 1 - j];
+			p[step - 1 - j] = temp;
 		}
 	}
 }